@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace hooks {
+
+/**
+ * @brief Fixed-capacity lock-free single-producer/single-consumer ring
+ *
+ * push() is wait-free and never allocates: one relaxed load of the producer's
+ * own index, a copy into the slot and a release store, plus an acquire load
+ * of the consumer's index only when the cached copy says the ring is full.
+ * The indices live on separate cache lines, so the producer and consumer only
+ * share a line when one of them refreshes its cached copy of the other's.
+ *
+ * Exactly one thread may push and exactly one (possibly different) thread
+ * may pop; a full ring rejects the item and counts it as dropped.
+ */
+template<typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "items are copied into slots");
+    
+public:
+    static constexpr size_t CAPACITY = Capacity;
+    
+    SpscRing() = default;
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    /**
+     * @brief Append an item (producer thread only)
+     * @return false if the ring is full
+     */
+    bool push(const T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail >= Capacity) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail >= Capacity) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_items[head & (Capacity - 1)] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Move up to max items into out, oldest first (consumer thread only)
+     * @return Number of items moved
+     */
+    size_t pop(T* out, size_t max) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_cachedHead - tail < max) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+        }
+        size_t count = m_cachedHead - tail < max ? m_cachedHead - tail : max;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = m_items[(tail + i) & (Capacity - 1)];
+        }
+        if (count) {
+            m_tail.store(tail + count, std::memory_order_release);
+        }
+        return count;
+    }
+    
+    /**
+     * @brief Get the number of items waiting (approximate while either side runs)
+     */
+    size_t size() const {
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        return m_head.load(std::memory_order_acquire) - tail;
+    }
+    
+    /**
+     * @brief Get the number of items rejected because the ring was full
+     */
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    
+private:
+    alignas(64) std::atomic<size_t> m_head{0};  ///< Next slot to fill; written by the producer
+    size_t m_cachedTail = 0;                    ///< Producer's copy of m_tail
+    std::atomic<uint64_t> m_dropped{0};
+    
+    alignas(64) std::atomic<size_t> m_tail{0};  ///< Next slot to read; written by the consumer
+    size_t m_cachedHead = 0;                    ///< Consumer's copy of m_head
+    
+    alignas(64) T m_items[Capacity];
+};
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hooks {
+
+/**
+ * @brief One XMM register, viewed as whatever the hooked code keeps in it
+ */
+union XmmRegister {
+    uint8_t bytes[16];
+    uint32_t u32[4];
+    uint64_t u64[2];
+    float f32[4];
+    double f64[2];
+};
+
+/**
+ * @brief Registers of a thread at a mid-function hook
+ *
+ * The layout is the one the hook stub builds on the stack: XMM0-15, the
+ * general-purpose registers from RAX to R15, then RFLAGS. A handler may change
+ * any field except rsp; the thread resumes with the changed values.
+ */
+struct HookContext {
+    XmmRegister xmm[16];
+    uint64_t rax;
+    uint64_t rbx;
+    uint64_t rcx;
+    uint64_t rdx;
+    uint64_t rsi;
+    uint64_t rdi;
+    uint64_t rbp;
+    uint64_t rsp;       ///< At the hooked instruction; read-only
+    uint64_t r8;
+    uint64_t r9;
+    uint64_t r10;
+    uint64_t r11;
+    uint64_t r12;
+    uint64_t r13;
+    uint64_t r14;
+    uint64_t r15;
+    uint64_t rflags;
+};
+
+static_assert(offsetof(HookContext, rax) == 256, "stub stores XMM registers first");
+static_assert(offsetof(HookContext, rflags) == 256 + 16 * 8, "stub pushes RFLAGS last");
+
+/**
+ * @brief Handler of a mid-function hook
+ */
+using MidHookHandler = void (*)(HookContext& context);
+
+} // namespace hooks
\ No newline at end of file
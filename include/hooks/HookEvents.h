@@ -0,0 +1,199 @@
+#pragma once
+
+#include "hooks/EventRing.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hooks {
+
+/**
+ * @brief What a detour observed
+ */
+enum class HookEventType : uint32_t {
+    CALL,       ///< The hooked function ran
+    HEALTH,
+    COINS,
+    LIVES,
+    VALUE       ///< Any other value read at address
+};
+
+/**
+ * @brief A compact event posted by a detour
+ */
+struct HookEvent {
+    HookEventType type;
+    uint32_t hookId;        ///< Chosen by the detour, e.g. an index into the hook list
+    int64_t value;
+    uintptr_t address;
+};
+
+/**
+ * @brief Get the name of an event type
+ */
+const char* hookEventName(HookEventType type);
+
+/**
+ * @brief Carries events from detours on the game thread to the trainer
+ *
+ * A detour calls post(), which copies the event into the calling thread's
+ * own SpscRing and costs a few nanoseconds: no lock, no allocation, no system
+ * call. A thread's ring is created, under a lock, the first time it posts to
+ * the pump and lives as long as the pump, so hooks running on several game
+ * threads never share a producer side. A consumer thread started by start()
+ * wakes every poll interval, drains every ring in batches of up to BATCH
+ * events and hands each batch to every sink (watchers, logs, the UI). Events
+ * from one thread arrive in order; events of different threads are not
+ * ordered against each other. Events posted while a ring is full are dropped
+ * and counted.
+ *
+ * post() may be called from any thread; sinks run on the consumer thread, or
+ * on the caller of drain().
+ */
+class HookEventPump {
+public:
+    static constexpr size_t CAPACITY = 4096;
+    static constexpr size_t BATCH = 256;
+    
+    using Sink = std::function<void(const HookEvent* events, size_t count)>;
+    
+    /**
+     * @brief Construct a stopped pump
+     */
+    explicit HookEventPump(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(5));
+    
+    /**
+     * @brief Stops the thread
+     */
+    ~HookEventPump();
+    
+    HookEventPump(const HookEventPump&) = delete;
+    HookEventPump& operator=(const HookEventPump&) = delete;
+    
+    /**
+     * @brief Queue an event in the calling thread's ring
+     * @return false if the ring was full and the event dropped
+     */
+    bool post(const HookEvent& event) { return ring().push(event); }
+    
+    /**
+     * @brief Queue an event built from its fields in the calling thread's ring
+     */
+    bool post(HookEventType type, int64_t value, uintptr_t address = 0, uint32_t hookId = 0) {
+        return ring().push(HookEvent{type, hookId, value, address});
+    }
+    
+    /**
+     * @brief Add a consumer of event batches
+     */
+    void addSink(Sink sink);
+    
+    /**
+     * @brief Remove all sinks
+     */
+    void clearSinks();
+    
+    /**
+     * @brief Start the consumer thread
+     * @return false if it is already running
+     */
+    bool start();
+    
+    /**
+     * @brief Drain what is left, stop the consumer thread and wait for it to exit
+     */
+    void stop();
+    
+    bool isRunning() const { return m_thread.joinable(); }
+    
+    /**
+     * @brief Deliver every waiting event to the sinks on the calling thread
+     *
+     * Must not run concurrently with the consumer thread.
+     *
+     * @return Number of events delivered
+     */
+    size_t drain();
+    
+    /**
+     * @brief Get the number of events delivered to the sinks
+     */
+    uint64_t getDelivered() const { return m_delivered.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Get the number of events dropped because a ring was full
+     */
+    uint64_t getDropped() const;
+    
+    /**
+     * @brief Get the number of events waiting in all rings
+     */
+    size_t pending() const;
+    
+    /**
+     * @brief Get the number of threads that have posted
+     */
+    size_t producerCount() const;
+    
+private:
+    using Ring = SpscRing<HookEvent, CAPACITY>;
+    
+    /**
+     * @brief The ring of one posting thread
+     */
+    struct Producer {
+        std::thread::id thread;
+        Ring ring;
+    };
+    
+    /**
+     * @brief The calling thread's ring in the pump it last posted to
+     */
+    struct ProducerCache {
+        uint64_t pump;      ///< m_id of that pump, 0 before the first post
+        Ring* ring;
+    };
+    
+    static thread_local ProducerCache s_producer;
+    
+    const uint64_t m_id;                    ///< Unique per pump, so a cache never outlives its rings
+    mutable std::mutex m_producerMutex;     ///< Guards m_producers; post() takes it on a thread's first post only
+    std::vector<std::unique_ptr<Producer>> m_producers;
+    std::vector<Producer*> m_draining;      ///< Consumer's copy of m_producers
+    
+    std::chrono::milliseconds m_pollInterval;
+    
+    std::mutex m_sinkMutex;                 ///< Guards m_sinks; never taken by post()
+    std::vector<Sink> m_sinks;
+    
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    
+    std::atomic<uint64_t> m_delivered{0};
+    
+    Ring& ring() {
+        if (s_producer.pump != m_id) {
+            s_producer.ring = &producerRing();
+            s_producer.pump = m_id;
+        }
+        return *s_producer.ring;
+    }
+    
+    /**
+     * @brief Find or create the calling thread's ring
+     */
+    Ring& producerRing();
+    
+    void run();
+};
+
+} // namespace hooks
\ No newline at end of file
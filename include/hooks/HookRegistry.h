@@ -0,0 +1,171 @@
+#pragma once
+
+#include "hooks/MinHookWrapper.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hooks {
+
+/**
+ * @brief Hooks by target address, with O(1) operations and lock-free lookups
+ *
+ * Records live in fixed-size chunks that are never moved or freed before the
+ * registry, so a handle (record index plus generation) stays valid until
+ * its hook is erased and is rejected afterwards, even once the record is
+ * reused. An open-addressing table with linear probing maps target addresses
+ * to records. Erasing leaves a tombstone; when tombstones and hooks fill half
+ * the table, a rebuilt table is published and the old one is only freed once
+ * no lookup is in progress, so a concurrent reader always probes a complete
+ * table.
+ *
+ * find(), isEnabled(), getOriginal() and getTarget() take no lock and may run
+ * concurrently with one writer. Every other member is a write and must be
+ * serialized by the caller.
+ */
+class HookRegistry {
+public:
+    /**
+     * @brief Construct an empty registry
+     */
+    HookRegistry();
+    
+    ~HookRegistry();
+    
+    HookRegistry(const HookRegistry&) = delete;
+    HookRegistry& operator=(const HookRegistry&) = delete;
+    
+    /**
+     * @brief Register a hook for info.targetAddress
+     *
+     * @return Handle of the new hook, or HookHandle::INVALID if the target is
+     * already registered, is 0/1, or the registry is full
+     */
+    HookHandle insert(const HookInfo& info);
+    
+    /**
+     * @brief Find the hook of a target address (lock-free)
+     */
+    HookHandle find(uintptr_t target) const;
+    
+    /**
+     * @brief Check if a hook is enabled (lock-free; false for stale handles)
+     */
+    bool isEnabled(HookHandle handle) const;
+    
+    /**
+     * @brief Get the original function of a hook (lock-free; 0 for stale handles)
+     */
+    uintptr_t getOriginal(HookHandle handle) const;
+    
+    /**
+     * @brief Get the target address of a hook (lock-free; 0 for stale handles)
+     */
+    uintptr_t getTarget(HookHandle handle) const;
+    
+    /**
+     * @brief Copy a hook's description
+     *
+     * @return false for stale handles
+     */
+    bool get(HookHandle handle, HookInfo& info) const;
+    
+    /**
+     * @brief Set a hook's enabled flag
+     *
+     * @return false for stale handles
+     */
+    bool setEnabled(HookHandle handle, bool enabled);
+    
+    /**
+     * @brief Set a hook's original function (trampoline)
+     *
+     * @return false for stale handles
+     */
+    bool setOriginal(HookHandle handle, uintptr_t original);
+    
+    /**
+     * @brief Unregister a hook; its handle becomes stale
+     *
+     * @return false for stale handles
+     */
+    bool erase(HookHandle handle);
+    
+    /**
+     * @brief Unregister every hook
+     */
+    void clear();
+    
+    /**
+     * @brief Get the handles of all registered hooks
+     */
+    std::vector<HookHandle> handles() const;
+    
+    /**
+     * @brief Get the number of registered hooks
+     */
+    size_t size() const { return m_size; }
+    
+private:
+    static constexpr size_t CHUNK_RECORDS = 256;
+    static constexpr size_t MAX_CHUNKS = 1024;
+    static constexpr size_t INITIAL_BUCKETS = 64;
+    
+    /**
+     * @brief A registered hook; the generation is odd while the record is live
+     */
+    struct Record {
+        std::atomic<uint32_t> generation{0};
+        std::atomic<uintptr_t> target{0};
+        std::atomic<uintptr_t> original{0};
+        std::atomic<bool> enabled{false};
+        std::string name;
+        uintptr_t hookFunction = 0;
+        HookType type = HookType::HOOK_JMP;
+    };
+    
+    /**
+     * @brief Open-addressing index; key 0 is empty, key 1 a tombstone
+     */
+    struct Table {
+        size_t mask;
+        std::unique_ptr<std::atomic<uintptr_t>[]> keys;
+        std::unique_ptr<std::atomic<uint32_t>[]> records;
+        
+        explicit Table(size_t buckets);
+    };
+    
+    std::unique_ptr<std::atomic<Record*>[]> m_chunks;
+    size_t m_recordCount = 0;                       ///< Records ever allocated
+    std::vector<uint32_t> m_freeRecords;
+    std::atomic<Table*> m_table;
+    std::vector<std::unique_ptr<Table>> m_tables;   ///< Current table last, retired ones before it
+    mutable std::atomic<uint32_t> m_readers{0};     ///< Lookups in progress
+    size_t m_size = 0;
+    size_t m_tombstones = 0;
+    
+    /**
+     * @brief Get the live record of a handle, or nullptr
+     */
+    Record* record(HookHandle handle) const;
+    
+    /**
+     * @brief Get a record by index
+     */
+    Record& recordAt(uint32_t index) const;
+    
+    /**
+     * @brief Rebuild the index with room for the live hooks plus one
+     */
+    void rehash();
+    
+    /**
+     * @brief Free retired tables if no lookup can still be probing them
+     */
+    void reclaimTables();
+};
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace hooks {
+
+/**
+ * @brief Aggregated calls and detour latency of one hook
+ */
+struct HookStatsSnapshot {
+    static constexpr size_t BUCKETS = 40;   ///< Bucket i counts latencies in [2^i, 2^(i+1)) ns
+    
+    uint64_t calls = 0;
+    uint64_t timedCalls = 0;                ///< Calls that also recorded a latency
+    uint64_t totalNanos = 0;
+    std::array<uint64_t, BUCKETS> buckets{};
+    
+    /**
+     * @brief Get the mean latency of the timed calls in nanoseconds
+     */
+    double meanNanos() const {
+        return timedCalls ? static_cast<double>(totalNanos) / static_cast<double>(timedCalls) : 0.0;
+    }
+    
+    /**
+     * @brief Get an upper bound of a latency percentile (0-100) in nanoseconds
+     */
+    uint64_t percentileNanos(double percentile) const;
+};
+
+/**
+ * @brief Lock-free call counter and log-bucket latency histogram of one hook
+ *
+ * Each thread writes one of SHARDS cache-line-aligned shards, picked once
+ * per thread, so detours running on different threads do not share cache
+ * lines; snapshot() sums the shards on demand. Counting is off by default:
+ * while HookStats::isEnabled() is false, count() and HookTimer cost one
+ * relaxed load and a branch.
+ */
+class HookStats {
+public:
+    static constexpr size_t SHARDS = 16;
+    
+    HookStats() = default;
+    HookStats(const HookStats&) = delete;
+    HookStats& operator=(const HookStats&) = delete;
+    
+    /**
+     * @brief Turn counting on or off for every hook
+     */
+    static void setEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    
+    /**
+     * @brief Check if counting is on
+     */
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Count a call without timing it
+     */
+    void count() {
+        if (isEnabled()) {
+            shard().calls.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Count a call that took nanos in the detour
+     */
+    void record(uint64_t nanos) {
+        Shard& s = shard();
+        s.calls.fetch_add(1, std::memory_order_relaxed);
+        s.timedCalls.fetch_add(1, std::memory_order_relaxed);
+        s.totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+        s.buckets[bucketOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Sum the shards
+     */
+    HookStatsSnapshot snapshot() const;
+    
+    /**
+     * @brief Zero every shard
+     */
+    void reset();
+    
+    /**
+     * @brief Get the histogram bucket of a latency
+     */
+    static size_t bucketOf(uint64_t nanos) {
+        size_t bucket = nanos ? 63 - static_cast<size_t>(__builtin_clzll(nanos)) : 0;
+        return bucket < HookStatsSnapshot::BUCKETS ? bucket : HookStatsSnapshot::BUCKETS - 1;
+    }
+    
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> timedCalls{0};
+        std::atomic<uint64_t> totalNanos{0};
+        std::array<std::atomic<uint64_t>, HookStatsSnapshot::BUCKETS> buckets{};
+    };
+    
+    static std::atomic<bool> s_enabled;
+    
+    Shard m_shards[SHARDS];
+    
+    /**
+     * @brief Get the calling thread's shard
+     */
+    Shard& shard() { return m_shards[threadShard()]; }
+    
+    /**
+     * @brief Index handed to the calling thread on first use, round robin
+     */
+    static size_t threadShard();
+};
+
+/**
+ * @brief Times a detour from construction to destruction
+ *
+ * Put one at the top of a detour:
+ * @code
+ * int coinDetour(int amount) {
+ *     hooks::HookTimer timer(g_coinHook->stats());
+ *     return g_coinHook->callOriginal<int>(amount);
+ * }
+ * @endcode
+ */
+class HookTimer {
+public:
+    explicit HookTimer(HookStats& stats)
+        : m_stats(HookStats::isEnabled() ? &stats : nullptr) {
+        if (m_stats) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+    
+    ~HookTimer() {
+        if (m_stats) {
+            auto elapsed = std::chrono::steady_clock::now() - m_start;
+            m_stats->record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+    
+    HookTimer(const HookTimer&) = delete;
+    HookTimer& operator=(const HookTimer&) = delete;
+    
+private:
+    HookStats* m_stats;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "hooks/InlinePatcher.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hooks {
+
+/**
+ * @brief A hook of one imported function of one loaded module
+ */
+struct ImportPatch {
+    std::string module;
+    std::string symbol;
+    std::vector<uintptr_t> slots;           ///< GOT entries bound to the symbol
+    std::vector<uintptr_t> originalEntries; ///< Their values before hooking, restored on disable
+    uintptr_t original = 0;                 ///< Function the imports resolve to
+    uintptr_t hook = 0;
+    bool applied = false;
+};
+
+/**
+ * @brief Hooks calls from an ELF module into shared libraries through its GOT (Linux x86-64)
+ *
+ * prepare() finds the module with dl_iterate_phdr, walks its PT_DYNAMIC
+ * section to the symbol and string tables and the PLT (DT_JMPREL) and
+ * dynamic (DT_RELA) relocations, and keeps every R_X86_64_JUMP_SLOT and
+ * R_X86_64_GLOB_DAT entry whose symbol has the given name. write() stores
+ * the hook, or the saved values, into those GOT entries with one atomic
+ * store each, briefly making RELRO pages writable. Only calls made by that
+ * module are affected; nothing is patched in the library itself.
+ *
+ * An entry still bound lazily holds the module's PLT resolver stub, which
+ * would rebind it (and drop the hook) if called, so original is looked up
+ * with dlsym instead.
+ */
+class ImportPatcher {
+public:
+    /**
+     * @brief Check if this platform has an import patcher
+     */
+    static bool isSupported();
+    
+    /**
+     * @brief Get the file names of the loaded modules, the main program first
+     */
+    static std::vector<std::string> listModules();
+    
+    /**
+     * @brief Get the address a symbol resolves to in this process (0 if none)
+     */
+    static uintptr_t resolve(const std::string& symbol);
+    
+    /**
+     * @brief Find the GOT entries of a symbol imported by a module
+     *
+     * @param module "" for the main program, else a file name such as
+     * "libSDL2-2.0.so.0" or its prefix up to a '.' or '-' ("libSDL2")
+     * @return OK, MODULE_NOT_FOUND, IMPORT_NOT_FOUND or NOT_EXECUTABLE (hook)
+     */
+    static PatchStatus prepare(const std::string& module, const std::string& symbol, uintptr_t hook,
+                               ImportPatch& patch);
+    
+    /**
+     * @brief Store the hook (enable) or the original entries (disable)
+     */
+    static PatchStatus write(ImportPatch& patch, bool enable);
+};
+
+} // namespace hooks
\ No newline at end of file
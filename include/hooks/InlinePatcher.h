@@ -0,0 +1,126 @@
+#pragma once
+
+#include "hooks/HookContext.h"
+#include "hooks/TrampolineArena.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hooks {
+
+/**
+ * @brief Result of preparing or writing an inline, vtable or import patch
+ */
+enum class PatchStatus {
+    OK,
+    NOT_EXECUTABLE,         ///< Target or detour is not in executable memory
+    UNSUPPORTED_FUNCTION,   ///< Prologue cannot be decoded or relocated
+    MEMORY_ALLOC,           ///< No trampoline memory
+    MEMORY_PROTECT,         ///< mprotect refused write access to the target
+    BAD_VTABLE,             ///< Object is unreadable or has no virtual function in the slot
+    VIRTUAL_BASES,          ///< Class has virtual bases; its vtable cannot be shadowed
+    MODULE_NOT_FOUND,       ///< No loaded module has that name
+    IMPORT_NOT_FOUND        ///< The module has no GOT entry for the symbol
+};
+
+/**
+ * @brief An inline hook of one function in this process
+ *
+ * Both slots come from InlinePatcher::arena(): the relay, an absolute jump
+ * to the detour close enough to the target for a 5-byte E9 jump, and the
+ * trampoline, the relocated stolen instructions followed by a jump back to
+ * the rest of the target.
+ *
+ * A mid-function patch (InlinePatcher::prepareMid()) has no relay: its jump
+ * leads straight to the trampoline, which saves the registers, calls the
+ * handler in detour and runs the stolen instructions before jumping back.
+ */
+struct InlinePatch {
+    static constexpr size_t MAX_PATCH = 32;
+    
+    uintptr_t target = 0;
+    uintptr_t detour = 0;
+    uintptr_t trampoline = 0;       ///< Call this as the original function
+    uintptr_t relay = 0;            ///< 0 for mid-function patches
+    size_t patchSize = 0;           ///< Bytes of the jump written at the target
+    size_t stolenSize = 0;          ///< Whole instructions moved to the trampoline
+    uint8_t originalBytes[MAX_PATCH] = {};
+    uint8_t jumpBytes[MAX_PATCH] = {};
+    bool applied = false;
+};
+
+/**
+ * @brief Writes x86-64 inline hooks into the running process (Linux only)
+ *
+ * prepare() decodes whole instructions at the target until a jump fits,
+ * relocates them into a trampoline slot within ±2 GB of the target
+ * (RIP-relative operands get new displacements, relative jumps, calls and
+ * conditional jumps become absolute ones) and builds the jump. write() and
+ * writeBatch() make the target pages writable with mprotect, store the jump
+ * or restore the prologue, put the original protection back and flush the
+ * instruction cache once.
+ *
+ * A jump that fits in one aligned 8-byte word is stored with a single atomic
+ * write. Otherwise the first two bytes are atomically replaced by a jump to
+ * itself, the rest is written, and the real first two bytes are stored
+ * atomically last, so a thread entering the target never runs a torn jump
+ * (it spins for the duration of the write). Threads already executing inside
+ * the stolen bytes, and code elsewhere that branches into them, are not
+ * detected; the caller must hook at function entry, or use prepareMid() at
+ * an instruction where no branch lands inside the stolen bytes.
+ */
+class InlinePatcher {
+public:
+    /**
+     * @brief Check if this platform has an inline patcher
+     */
+    static bool isSupported();
+    
+    /**
+     * @brief Get the arena that holds every relay and trampoline
+     */
+    static TrampolineArena& arena();
+    
+    /**
+     * @brief Check if an address lies in an executable mapping of this process
+     */
+    static bool isExecutable(uintptr_t address);
+    
+    /**
+     * @brief Build the trampoline and jump of a hook without writing the target
+     */
+    static PatchStatus prepare(uintptr_t target, uintptr_t detour, InlinePatch& patch);
+    
+    /**
+     * @brief Build a hook that hands the registers at an instruction to a handler
+     *
+     * target may be any instruction boundary. The trampoline moves below the
+     * 128-byte red zone, pushes RFLAGS and the general-purpose registers,
+     * stores XMM0-15 into a HookContext and calls handler on a 16-byte
+     * aligned stack. Whatever the handler leaves in the context is loaded
+     * back, then the stolen instructions run and execution resumes after
+     * them. The handler must not throw; upper YMM/ZMM halves are not saved.
+     */
+    static PatchStatus prepareMid(uintptr_t target, MidHookHandler handler, InlinePatch& patch);
+    
+    /**
+     * @brief Write the jump (enable) or restore the original bytes (disable)
+     */
+    static PatchStatus write(InlinePatch& patch, bool enable);
+    
+    /**
+     * @brief Write several patches with one protection change per page and one flush
+     *
+     * @return OK, or MEMORY_PROTECT if a page could not be made writable; in
+     * that case nothing is written
+     */
+    static PatchStatus writeBatch(const std::vector<std::pair<InlinePatch*, bool>>& changes);
+    
+    /**
+     * @brief Free the trampoline of a patch that is not applied
+     */
+    static void release(InlinePatch& patch);
+};
+
+} // namespace hooks
\ No newline at end of file
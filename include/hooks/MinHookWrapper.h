@@ -1,9 +1,17 @@
 #pragma once
 
+#include "hooks/HookContext.h"
+#include "hooks/HookStats.h"
+#include "hooks/ImportPatcher.h"
+#include "hooks/InlinePatcher.h"
+#include "hooks/VTablePatcher.h"
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace hooks {
@@ -33,7 +41,36 @@ enum class MHStatus {
 enum class HookType {
     HOOK_JMP,
     HOOK_CALL,
-    HOOK_VTABLE
+    HOOK_VTABLE,    ///< A virtual function slot of an object (VTablePatcher)
+    HOOK_MID,       ///< Any instruction; the hook function is a MidHookHandler
+    HOOK_IMPORT     ///< GOT entries of a module's imported function (ImportPatcher)
+};
+
+/**
+ * @brief How hooks are applied
+ */
+enum class HookEngine {
+    MOCK,       ///< Record hooks only; targets are never touched
+    INLINE      ///< Patch functions of this process (InlinePatcher, Linux x86-64)
+};
+
+/**
+ * @brief Stable handle of a registered hook; stale once the hook is removed
+ */
+enum class HookHandle : uint64_t {
+    INVALID = 0
+};
+
+class HookRegistry;
+
+/**
+ * @brief A queued enable or disable and, once applied, its outcome
+ */
+struct QueuedHookChange {
+    HookHandle handle;
+    uintptr_t targetAddress;
+    bool enable;
+    MHStatus status;        ///< MH_OK if applied or already in the requested state
 };
 
 /**
@@ -54,13 +91,28 @@ struct HookInfo {
 
 /**
  * @brief Wrapper for MinHook library
+ *
+ * Hooks are kept in a HookRegistry keyed by target address, so lookups and
+ * toggles are O(1); FunctionHook keeps the returned handle and skips even
+ * the address lookup.
+ *
+ * All members may be called from any thread. Changes are serialized by one
+ * mutex, while findHook(), isHookEnabled() and isInitialized() never block.
+ * getLastError() reports the last call made by the calling thread.
+ *
+ * The MOCK engine only records hooks, which is what the console needs for
+ * addresses in another process. The INLINE engine hooks functions of this
+ * process for real: the original function becomes a trampoline and enabling
+ * writes a jump at the target.
  */
 class MinHookWrapper {
 public:
     /**
      * @brief Initialize MinHook
+     *
+     * @param engine MOCK, or INLINE where InlinePatcher::isSupported()
      */
-    static MHStatus initialize();
+    static MHStatus initialize(HookEngine engine = HookEngine::MOCK);
     
     /**
      * @brief Uninitialize MinHook
@@ -82,20 +134,104 @@ public:
      */
     static MHStatus createHook(uintptr_t target, uintptr_t hook, uintptr_t* original);
     
+    /**
+     * @brief Create a hook that passes the registers at an instruction to a handler
+     *
+     * Enabled, removed and queued like any other hook. The handler reads and
+     * may modify the HookContext before the instruction at address runs (see
+     * InlinePatcher::prepareMid()); it has no original function to call.
+     *
+     * @param address Instruction to hook, not necessarily a function entry
+     * @param handler Called with the registers of the thread reaching address
+     */
+    static MHStatus createMidHook(void* address, MidHookHandler handler);
+    
+    /**
+     * @brief Create a hook of a virtual function of an object
+     *
+     * The hook takes the object as its first parameter, like the virtual
+     * function it replaces. Under the INLINE engine the object is hooked
+     * through VTablePatcher and the hook is registered under the vtable
+     * entry it writes; the MOCK engine records object + slot * 8 instead.
+     *
+     * @param object Object whose vtable pointer is at offset 0
+     * @param slot Index of the virtual function in its vtable
+     * @param original Output parameter for the replaced function
+     * @param scope INSTANCE to hook this object only, CLASS for every object sharing its vtable
+     * @param handle Optional output of the new hook's handle
+     */
+    static MHStatus createVTableHook(void* object, size_t slot, void* hook, void** original,
+                                     VTableScope scope = VTableScope::INSTANCE, HookHandle* handle = nullptr);
+    
+    /**
+     * @brief Create a hook of a function a module imports from a shared library
+     *
+     * Under the INLINE engine the module's GOT entries for the symbol are
+     * found by ImportPatcher and swapped on enable; the hook is registered
+     * under the first of them. Only calls made by that module are hooked.
+     * The MOCK engine registers it under a key reserved for "module!symbol",
+     * and its original is the symbol as resolved here (or that key).
+     *
+     * @param module "" for the main program, else a module file name or its prefix
+     * @param symbol Imported function, e.g. "SDL_PollEvent"
+     * @param original Output parameter for the function the import resolves to
+     * @param handle Optional output of the new hook's handle
+     */
+    static MHStatus createImportHook(const std::string& module, const std::string& symbol, void* hook,
+                                     void** original, HookHandle* handle = nullptr);
+    
     /**
      * @brief Enable a hook
      */
     static MHStatus enableHook(void* target);
+    static MHStatus enableHook(HookHandle handle);
     
     /**
      * @brief Disable a hook
      */
     static MHStatus disableHook(void* target);
+    static MHStatus disableHook(HookHandle handle);
     
     /**
      * @brief Remove a hook
      */
     static MHStatus removeHook(void* target);
+    static MHStatus removeHook(HookHandle handle);
+    
+    /**
+     * @brief Queue a hook to be enabled by the next applyQueued()
+     *
+     * The last queued change of a hook wins.
+     */
+    static MHStatus queueEnable(void* target);
+    static MHStatus queueEnable(HookHandle handle);
+    
+    /**
+     * @brief Queue a hook to be disabled by the next applyQueued()
+     */
+    static MHStatus queueDisable(void* target);
+    static MHStatus queueDisable(HookHandle handle);
+    
+    /**
+     * @brief Apply every queued change in one patch window
+     *
+     * All changes are validated first, then every target is patched while
+     * the process is held once, followed by a single instruction cache flush.
+     *
+     * @param results Optional output of each hook's change and status
+     * @return MH_OK if every change applied, else the first failure
+     */
+    static MHStatus applyQueued(std::vector<QueuedHookChange>* results = nullptr);
+    
+    /**
+     * @brief Find the hook of a target address, or HookHandle::INVALID
+     */
+    static HookHandle findHook(uintptr_t target);
+    
+    /**
+     * @brief Check if a hook is enabled (false for stale handles)
+     */
+    static bool isHookEnabled(HookHandle handle);
     
     /**
      * @brief Check if MinHook is initialized
@@ -103,25 +239,86 @@ public:
     static bool isInitialized();
     
     /**
-     * @brief Get last error message
+     * @brief Get the engine chosen by initialize()
+     */
+    static HookEngine getEngine();
+    
+    /**
+     * @brief Get the message of the calling thread's last call
      */
     static std::string getLastError();
     
     /**
-     * @brief Create trampoline function
+     * @brief Get the trampoline that runs a hooked target's original code
+     *
+     * Under the INLINE engine this is the trampoline of the hook at target;
+     * otherwise (or if target is not hooked) target itself.
      */
     static uintptr_t createTrampoline(uintptr_t target, size_t stolenBytes = 5);
     
 private:
-    static bool s_initialized;
-    static std::string s_lastError;
+    static std::atomic<bool> s_initialized;
+    static std::atomic<HookEngine> s_engine;
+    static thread_local std::string s_lastError;
+    static std::mutex s_mutex;              ///< Serializes every change
+    
+    /**
+     * @brief Hooks by target address
+     */
+    static HookRegistry& registry();
+    
+    /**
+     * @brief Inline patches by handle (INLINE engine)
+     */
+    static std::unordered_map<uint64_t, InlinePatch>& patches();
     
-    // Mock implementation for demonstration
-    static std::vector<HookInfo> s_hooks;
+    /**
+     * @brief Vtable patches by handle (INLINE engine)
+     */
+    static std::unordered_map<uint64_t, VTablePatch>& vtablePatches();
+    
+    /**
+     * @brief Import patches by handle (INLINE engine)
+     */
+    static std::unordered_map<uint64_t, ImportPatch>& importPatches();
+    
+    /**
+     * @brief Changes waiting for applyQueued()
+     */
+    static std::vector<QueuedHookChange>& queue();
+    
+    /**
+     * @brief Create and register a hook of any type (under s_mutex)
+     */
+    static MHStatus createHookLocked(uintptr_t target, uintptr_t hook, HookType type, uintptr_t* original);
+    
+    /**
+     * @brief Queue a change of a registered hook
+     */
+    static MHStatus queueChange(HookHandle handle, bool enable);
+    
+    /**
+     * @brief Enable or disable a hook (under s_mutex)
+     */
+    static MHStatus setEnabledLocked(HookHandle handle, bool enable);
+    
+    /**
+     * @brief Write the vtable or import patch of a hook (under s_mutex)
+     *
+     * @return false if the hook has neither, leaving status untouched
+     */
+    static bool writePointerPatch(HookHandle handle, bool enable, PatchStatus& status);
 };
 
 /**
  * @brief Manages a single function hook
+ *
+ * Its detour may count calls and time itself into stats() with a HookTimer
+ * (see HookStats); ConsoleUI::showHooks() prints the totals. With
+ * HookType::HOOK_MID the hook function is a MidHookHandler and the target
+ * any instruction; such a hook has no original function. The vtable
+ * constructor hooks a virtual function slot of one object or of its class,
+ * and the import constructor a module's GOT entries for a library function.
  */
 class FunctionHook {
 public:
@@ -136,6 +333,29 @@ public:
     FunctionHook(const std::string& name, uintptr_t targetAddress, 
                  uintptr_t hookFunction, HookType type = HookType::HOOK_JMP);
     
+    /**
+     * @brief Construct a HOOK_VTABLE hook of a virtual function
+     * 
+     * @param name Name of the hook
+     * @param object Object whose vtable is hooked
+     * @param slot Index of the virtual function in the vtable
+     * @param hookFunction Function to call instead, taking the object first
+     * @param scope This object only, or every object of its class
+     */
+    FunctionHook(const std::string& name, void* object, size_t slot,
+                 uintptr_t hookFunction, VTableScope scope = VTableScope::INSTANCE);
+    
+    /**
+     * @brief Construct a HOOK_IMPORT hook of a function imported by a module
+     * 
+     * @param name Name of the hook
+     * @param module Importing module ("" for the main program)
+     * @param symbol Imported function
+     * @param hookFunction Function to call instead
+     */
+    FunctionHook(const std::string& name, const std::string& module, const std::string& symbol,
+                 uintptr_t hookFunction);
+    
     /**
      * @brief Destructor - automatically removes hook
      */
@@ -163,6 +383,16 @@ public:
      */
     bool disable();
     
+    /**
+     * @brief Queue enabling the hook until MinHookWrapper::applyQueued()
+     */
+    bool queueEnable();
+    
+    /**
+     * @brief Queue disabling the hook until MinHookWrapper::applyQueued()
+     */
+    bool queueDisable();
+    
     /**
      * @brief Check if hook is installed
      */
@@ -171,13 +401,29 @@ public:
     /**
      * @brief Check if hook is enabled
      */
-    bool isEnabled() const { return m_enabled; }
+    bool isEnabled() const { return MinHookWrapper::isHookEnabled(m_handle); }
     
     /**
      * @brief Get the original function address
      */
     uintptr_t getOriginal() const { return m_originalFunction; }
     
+    /**
+     * @brief Get the registry handle (HookHandle::INVALID until installed)
+     */
+    HookHandle getHandle() const { return m_handle; }
+    
+    /**
+     * @brief Get the hook's name
+     */
+    const std::string& getName() const { return m_name; }
+    
+    /**
+     * @brief Get the call counters and latency histogram fed by the detour
+     */
+    HookStats& stats() { return m_stats; }
+    const HookStats& stats() const { return m_stats; }
+    
     /**
      * @brief Call the original function
      */
@@ -194,8 +440,13 @@ private:
     uintptr_t m_hookFunction;
     uintptr_t m_originalFunction;
     HookType m_type;
+    size_t m_slot;
+    VTableScope m_scope;
+    std::string m_module;
+    std::string m_symbol;
+    HookHandle m_handle;
     bool m_installed;
-    bool m_enabled;
+    HookStats m_stats;
 };
 
 } // namespace hooks
\ No newline at end of file
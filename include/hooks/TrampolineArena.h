@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hooks {
+
+/**
+ * @brief A mapping of this process, from /proc/self/maps
+ */
+struct SelfMapping {
+    uintptr_t start;
+    uintptr_t end;
+    int protection;     ///< PROT_* flags
+};
+
+/**
+ * @brief Parse /proc/self/maps (sorted by address; empty where unavailable)
+ */
+std::vector<SelfMapping> readSelfMappings();
+
+/**
+ * @brief Occupancy of a TrampolineArena
+ */
+struct ArenaStats {
+    size_t regions = 0;         ///< Reservations, i.e. mmap calls
+    size_t pages = 0;           ///< Pages committed to a size class
+    size_t slotsInUse = 0;
+    size_t freeSlots = 0;       ///< Carved but unused slots on committed pages
+};
+
+/**
+ * @brief Executable memory for trampolines and relays close to their targets
+ *
+ * Address space is reserved in REGION_SIZE blocks in the nearest free gap
+ * within ±2 GB of the first target that needs one, so the hooks of a module
+ * share its region and reach their code with 5-byte rel32 jumps. Pages are
+ * committed on demand, each to one size class (16 to 1024 bytes), and carved
+ * into slots; released slots are filled with int3 and reused by the next
+ * allocation of that class. Only a new region costs an mmap.
+ *
+ * Slots are read/execute; write() briefly adds write access to their pages,
+ * so other slots on a page keep running while one is filled. All members
+ * are thread-safe. Regions are unmapped by the destructor only.
+ */
+class TrampolineArena {
+public:
+    static constexpr size_t REGION_SIZE = 1 << 20;
+    static constexpr size_t MAX_SLOT = 1024;
+    
+    TrampolineArena();
+    ~TrampolineArena();
+    
+    TrampolineArena(const TrampolineArena&) = delete;
+    TrampolineArena& operator=(const TrampolineArena&) = delete;
+    
+    /**
+     * @brief Allocate a slot of at least size bytes near target
+     *
+     * Falls back to a slot anywhere if no memory within ±2 GB can be mapped.
+     *
+     * @return Slot address, or 0 if size exceeds MAX_SLOT or nothing can be mapped
+     */
+    uintptr_t allocate(uintptr_t target, size_t size);
+    
+    /**
+     * @brief Return a slot to its size class
+     */
+    void release(uintptr_t slot);
+    
+    /**
+     * @brief Copy code into a slot and flush the instruction cache
+     */
+    bool write(uintptr_t slot, const void* bytes, size_t size);
+    
+    /**
+     * @brief Check if a rel32 operand at from can reach to
+     */
+    static bool isNear(uintptr_t from, uintptr_t to);
+    
+    /**
+     * @brief Get the number of regions, pages and slots
+     */
+    ArenaStats getStats() const;
+    
+private:
+    static constexpr size_t CLASS_COUNT = 7;    ///< 16 to 1024 bytes, doubling
+    static constexpr uint8_t UNCOMMITTED = 0xFF;
+    
+    struct Region {
+        uintptr_t base;
+        size_t committedPages = 0;              ///< Pages below this are committed
+        std::vector<uint8_t> pageClasses;
+        std::vector<uintptr_t> freeSlots[CLASS_COUNT];
+    };
+    
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<Region>> m_regions;
+    size_t m_slotsInUse = 0;
+    
+    /**
+     * @brief Take a slot of a class from a region, committing a page if needed
+     */
+    uintptr_t takeSlot(Region& region, size_t sizeClass);
+    
+    /**
+     * @brief Reserve a region within ±2 GB of target, nearest first
+     */
+    Region* reserveNear(uintptr_t target);
+    
+    /**
+     * @brief Reserve a region wherever mmap puts it
+     */
+    Region* reserveAnywhere();
+    
+    /**
+     * @brief Track a new reservation
+     */
+    Region* addRegion(void* base);
+    
+    /**
+     * @brief Find the region containing an address
+     */
+    Region* regionOf(uintptr_t address) const;
+};
+
+} // namespace hooks
\ No newline at end of file
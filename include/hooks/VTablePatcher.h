@@ -0,0 +1,90 @@
+#pragma once
+
+#include "hooks/InlinePatcher.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace hooks {
+
+/**
+ * @brief Which objects a vtable hook affects
+ */
+enum class VTableScope {
+    INSTANCE,   ///< Only the hooked object, through a shadow copy of its vtable
+    CLASS       ///< Every object whose vtable is the hooked object's (derived classes keep their own)
+};
+
+/**
+ * @brief A hook of one virtual function slot
+ */
+struct VTablePatch {
+    uintptr_t object = 0;
+    size_t slot = 0;
+    VTableScope scope = VTableScope::INSTANCE;
+    uintptr_t vtable = 0;           ///< The class's vtable (its address point)
+    uintptr_t slotAddress = 0;      ///< Entry written on enable: in the shadow or in the class vtable
+    uintptr_t original = 0;         ///< Function in the slot before hooking
+    uintptr_t hook = 0;
+    bool applied = false;
+};
+
+/**
+ * @brief Hooks virtual functions of objects in this process (Linux, Itanium C++ ABI)
+ *
+ * An INSTANCE hook copies the object's vtable, including the offset-to-top
+ * and type_info entries in front of it so typeid and dynamic_cast still
+ * work, and points the object's vtable pointer at the copy with one atomic
+ * store. Enabling and disabling then swap one entry of the copy; no code is
+ * patched and no thread is suspended. Hooks of several slots of one object
+ * share its shadow, and the object gets its vtable back when the last of them
+ * is released. The object must outlive its hooks: its destructor rewrites
+ * the vtable pointer. Classes with virtual bases are refused (VIRTUAL_BASES),
+ * as their vtables hold vbase and vcall offsets in front of the two copied
+ * entries; this is detected through RTTI, so code built without it is not
+ * checked. Released copies are kept and reused for the same class, since a
+ * virtual call may still be reading one.
+ *
+ * A CLASS hook swaps the entry in the class vtable itself, briefly making its
+ * read-only page writable. Shadowed objects of that class follow it too,
+ * except in slots they hook per instance: an INSTANCE hook wins over a CLASS
+ * hook of the same slot, and disabling it brings back whatever the class
+ * vtable holds at that time.
+ *
+ * The slots of a vtable are counted from its address point up to the first
+ * entry that is not a pointer into executable memory; secondary vtables of
+ * multiple inheritance are not reachable from the primary one.
+ */
+class VTablePatcher {
+public:
+    static constexpr size_t MAX_SLOTS = 1024;
+    
+    /**
+     * @brief Check if this platform has a vtable patcher
+     */
+    static bool isSupported();
+    
+    /**
+     * @brief Count the virtual functions of a vtable (0 if it is not readable)
+     */
+    static size_t countSlots(uintptr_t vtable);
+    
+    /**
+     * @brief Look up a slot and, for INSTANCE scope, give the object its shadow vtable
+     *
+     * The shadow starts out identical to the original, so the object behaves
+     * as before until the patch is written.
+     */
+    static PatchStatus prepare(void* object, size_t slot, uintptr_t hook, VTableScope scope, VTablePatch& patch);
+    
+    /**
+     * @brief Store the hook (enable) or the original function (disable) in the slot
+     */
+    static PatchStatus write(VTablePatch& patch, bool enable);
+    
+    /**
+     * @brief Drop a patch that is not applied, restoring the object's vtable after its last hook
+     */
+    static void release(VTablePatch& patch);
+};
+
+} // namespace hooks
\ No newline at end of file
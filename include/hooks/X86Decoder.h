@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hooks {
+
+/**
+ * @brief Control flow of a decoded instruction, as far as relocation cares
+ */
+enum class X86Branch {
+    NONE,
+    JMP_REL,        ///< EB/E9: unconditional relative jump
+    JCC_REL,        ///< 70-7F / 0F 80-8F: conditional relative jump
+    CALL_REL,       ///< E8: relative call
+    LOOP_REL,       ///< E0-E3: LOOPcc/JrCXZ, rel8 only
+    RET,            ///< C2/C3/CA/CB
+    JMP_INDIRECT    ///< FF /4, FF /5
+};
+
+/**
+ * @brief Length and relocation facts of one x86-64 instruction
+ */
+struct X86Instruction {
+    size_t length = 0;
+    uint8_t opcode = 0;             ///< Last opcode byte
+    bool ripRelative = false;       ///< ModRM addresses [rip + disp32]
+    size_t displacementOffset = 0;  ///< Offset of disp32 when ripRelative
+    X86Branch branch = X86Branch::NONE;
+    size_t relativeOffset = 0;      ///< Offset of the rel8/rel32 of a relative branch
+    size_t relativeSize = 0;        ///< 1 or 4
+    int64_t relative = 0;           ///< Branch displacement from the end of the instruction
+    
+    /**
+     * @brief Check if execution never falls through to the next instruction
+     */
+    bool endsFlow() const {
+        return branch == X86Branch::JMP_REL || branch == X86Branch::RET ||
+               branch == X86Branch::JMP_INDIRECT;
+    }
+};
+
+/**
+ * @brief Decode the length and relocation facts of a 64-bit mode instruction
+ *
+ * A table-driven length disassembler: legacy and REX prefixes, the one-byte,
+ * 0F, 0F 38 and 0F 3A opcode maps, VEX and EVEX, ModRM/SIB/displacement and
+ * immediates. It does not validate operands beyond what the length needs.
+ *
+ * @param code Instruction bytes
+ * @param available Readable bytes at code (at most 15 are used)
+ * @param instruction Output
+ * @return false for opcodes invalid in 64-bit mode or truncated input
+ */
+bool decodeX86(const uint8_t* code, size_t available, X86Instruction& instruction);
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace scanner {
+
+/**
+ * @brief Surviving scan candidates inside one fixed-size address window
+ *
+ * Candidates are addressed by slot index (address = base + slot * stride)
+ * and stored either as a bitmap or, when sparse, as LEB128-encoded gaps
+ * between slot indices. Previous values are packed in slot order; when all
+ * candidates of a block hold the same value it is stored only once.
+ */
+class CandidateBlock {
+public:
+    /**
+     * @brief Slot storage encoding
+     */
+    enum class Encoding {
+        BITMAP,
+        DELTA
+    };
+    
+    /**
+     * @brief Address of slot 0
+     */
+    uintptr_t getBase() const { return m_base; }
+    
+    /**
+     * @brief Number of slots covered by this block
+     */
+    size_t getSlotCount() const { return m_slotCount; }
+    
+    /**
+     * @brief Number of surviving candidates
+     */
+    size_t count() const { return m_count; }
+    
+    /**
+     * @brief Get the slot storage encoding
+     */
+    Encoding getEncoding() const { return m_encoding; }
+    
+    /**
+     * @brief Check if all candidates share a single stored value
+     */
+    bool isUniform() const { return m_uniform; }
+    
+    /**
+     * @brief Previous value of the n-th candidate (in slot order)
+     */
+    const uint8_t* getValue(size_t rank) const {
+        return m_uniform ? m_values.data() : m_values.data() + rank * m_valueSize;
+    }
+    
+    /**
+     * @brief Address of the first hashed page
+     */
+    uintptr_t getPageBase() const { return m_pageBase; }
+    
+    /**
+     * @brief Hashes of consecutive SNAPSHOT_PAGE_BYTES pages from getPageBase()
+     *
+     * Taken from the same read as the stored values, so a page whose hash is
+     * unchanged still holds those values. Only dense blocks keep hashes; for
+     * sparse ones hashing a page costs more than comparing its candidates.
+     */
+    const std::vector<uint64_t>& getPageHashes() const { return m_pageHashes; }
+    
+    /**
+     * @brief Heap bytes used by this block
+     */
+    size_t memoryUsage() const;
+    
+    /**
+     * @brief Visit candidates in slot order
+     *
+     * @param fn Callable as fn(size_t slot, size_t rank)
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        size_t rank = 0;
+        if (m_encoding == Encoding::BITMAP) {
+            for (size_t word = 0; word < m_bitmap.size(); ++word) {
+                uint64_t bits = m_bitmap[word];
+                while (bits) {
+                    size_t bit = static_cast<size_t>(__builtin_ctzll(bits));
+                    fn(word * 64 + bit, rank++);
+                    bits &= bits - 1;
+                }
+            }
+        } else {
+            size_t pos = 0;
+            size_t slot = 0;
+            for (; rank < m_count; ++rank) {
+                uint64_t gap = 0;
+                int shift = 0;
+                uint8_t byte;
+                do {
+                    byte = m_deltas[pos++];
+                    gap |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    shift += 7;
+                } while (byte & 0x80);
+                slot = rank == 0 ? gap : slot + gap + 1;
+                fn(slot, rank);
+            }
+        }
+    }
+    
+private:
+    friend class CandidateBlockBuilder;
+    
+    uintptr_t m_base = 0;
+    size_t m_slotCount = 0;
+    size_t m_count = 0;
+    size_t m_valueSize = 0;
+    Encoding m_encoding = Encoding::BITMAP;
+    bool m_uniform = false;
+    std::vector<uint64_t> m_bitmap;
+    std::vector<uint8_t> m_deltas;
+    std::vector<uint8_t> m_values;
+    uintptr_t m_pageBase = 0;
+    std::vector<uint64_t> m_pageHashes;
+};
+
+/**
+ * @brief Accumulates candidates for one block and picks the smaller encoding
+ */
+class CandidateBlockBuilder {
+public:
+    explicit CandidateBlockBuilder(size_t valueSize);
+    
+    /**
+     * @brief Start a new block
+     */
+    void reset(uintptr_t base, size_t slotCount);
+    
+    /**
+     * @brief Add a candidate; slots must be added in increasing order
+     */
+    void add(size_t slot, const uint8_t* value);
+    
+    /**
+     * @brief Let build() hash the whole pages of a buffer read from address
+     *
+     * The hashes are only computed if the block ends up bitmap-encoded. The
+     * buffer must stay valid until build().
+     */
+    void hashPages(uintptr_t address, const uint8_t* data, size_t size);
+    
+    /**
+     * @brief Check if no candidates were added
+     */
+    bool empty() const { return m_slots.empty(); }
+    
+    /**
+     * @brief Produce a compact block from the added candidates
+     */
+    CandidateBlock build() const;
+    
+private:
+    size_t m_valueSize;
+    uintptr_t m_base = 0;
+    size_t m_slotCount = 0;
+    bool m_uniform = true;
+    std::vector<uint32_t> m_slots;
+    std::vector<uint8_t> m_values;
+    uintptr_t m_hashAddress = 0;
+    const uint8_t* m_hashData = nullptr;
+    size_t m_hashSize = 0;
+};
+
+/**
+ * @brief Compact set of scan candidates across all scanned regions
+ *
+ * Blocks are immutable and shared, so sets derived from one another (such
+ * as successive scan generations) can reference the same unchanged blocks.
+ */
+class CandidateSet {
+public:
+    /**
+     * @brief Address span covered by one block
+     */
+    static constexpr size_t BLOCK_BYTES = 64 * 1024;
+    
+    CandidateSet(size_t valueSize = 0, size_t stride = 0)
+        : m_valueSize(valueSize), m_stride(stride) {}
+    
+    /**
+     * @brief Append a block; blocks must be added in address order
+     */
+    void addBlock(CandidateBlock block);
+    
+    /**
+     * @brief Append a block shared with another set
+     */
+    void addBlock(std::shared_ptr<const CandidateBlock> block);
+    
+    /**
+     * @brief Total number of candidates
+     */
+    size_t count() const { return m_count; }
+    
+    /**
+     * @brief Check if the set holds no candidates
+     */
+    bool empty() const { return m_count == 0; }
+    
+    /**
+     * @brief Size in bytes of each stored value
+     */
+    size_t getValueSize() const { return m_valueSize; }
+    
+    /**
+     * @brief Distance in bytes between consecutive slots
+     */
+    size_t getStride() const { return m_stride; }
+    
+    /**
+     * @brief Get the candidate blocks
+     */
+    const std::vector<std::shared_ptr<const CandidateBlock>>& getBlocks() const { return m_blocks; }
+    
+    /**
+     * @brief Heap bytes used by the set, counting shared blocks in full
+     */
+    size_t memoryUsage() const;
+    
+    /**
+     * @brief Visit all candidates in address order
+     *
+     * @param fn Callable as fn(uintptr_t address, const uint8_t* previousValue)
+     */
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& block : m_blocks) {
+            block->forEach([&](size_t slot, size_t rank) {
+                fn(block->getBase() + slot * m_stride, block->getValue(rank));
+            });
+        }
+    }
+    
+    /**
+     * @brief Collect up to limit candidate addresses
+     */
+    std::vector<uintptr_t> getAddresses(size_t limit) const;
+    
+    /**
+     * @brief Remove all candidates
+     */
+    void clear();
+    
+private:
+    size_t m_valueSize;
+    size_t m_stride;
+    size_t m_count = 0;
+    std::vector<std::shared_ptr<const CandidateBlock>> m_blocks;
+};
+
+} // namespace scanner
\ No newline at end of file
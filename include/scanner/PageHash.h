@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scanner {
+
+/**
+ * @brief Page size used by snapshots and page-level change detection
+ */
+constexpr size_t SNAPSHOT_PAGE_BYTES = 4096;
+
+/**
+ * @brief Fast non-cryptographic 64-bit hash (XXH64 construction)
+ *
+ * @param data Bytes to hash
+ * @param size Number of bytes
+ * @param seed Optional seed
+ */
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+/**
+ * @brief Check if a buffer contains only zero bytes
+ *
+ * Uses SSE2 where available and returns at the first non-zero block.
+ */
+bool isZeroPage(const uint8_t* data, size_t size);
+
+} // namespace scanner
\ No newline at end of file
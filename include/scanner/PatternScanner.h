@@ -2,14 +2,75 @@
 
 #include "memory/Pattern.h"
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
 #include <optional>
+#include <string>
 
 namespace scanner {
 
+class ScanResultStore;
+
+/**
+ * @brief Protection flags for a memory region
+ */
+enum MemoryProtection : uint32_t {
+    MEMORY_NONE = 0,
+    MEMORY_READ = 1 << 0,
+    MEMORY_WRITE = 1 << 1,
+    MEMORY_EXECUTE = 1 << 2
+};
+
+/**
+ * @brief A committed memory region of the target process
+ */
+struct MemoryRegion {
+    uintptr_t base;
+    size_t size;
+    uint32_t protection;
+    
+    MemoryRegion(uintptr_t b = 0, size_t s = 0, uint32_t prot = MEMORY_NONE)
+        : base(b), size(s), protection(prot) {}
+    
+    bool isReadable() const { return (protection & MEMORY_READ) != 0; }
+    bool isWritable() const { return (protection & MEMORY_WRITE) != 0; }
+    uintptr_t end() const { return base + size; }
+};
+
+/**
+ * @brief One entry of a batched memory read
+ */
+struct MemoryRead {
+    uintptr_t address;
+    void* buffer;
+    size_t size;
+};
+
+/**
+ * @brief One entry of a batched memory write
+ */
+struct MemoryWrite {
+    uintptr_t address;
+    const void* data;
+    size_t size;
+};
+
+/**
+ * @brief Outcome of one entry of a batched memory write
+ */
+enum class WriteResult {
+    WRITE_OK,
+    WRITE_FAILED,
+    WRITE_VERIFY_FAILED     ///< Written, but reading it back gave other bytes
+};
+
 /**
  * @brief Interface for memory region providers
+ *
+ * Implementations must be thread-safe: the trainer shares one provider
+ * between scans on the UI thread and the ValueFreezer and WatchList threads,
+ * which call any of these methods concurrently.
  */
 class IMemoryProvider {
 public:
@@ -25,6 +86,43 @@ public:
      */
     virtual bool readMemory(uintptr_t address, void* buffer, size_t size) = 0;
     
+    /**
+     * @brief Read several memory ranges, reporting each one
+     * 
+     * Providers that can gather-read in one call override this; the
+     * default issues one readMemory() per entry.
+     * 
+     * @param reads Entries to read, in any order
+     * @param results Receives true for every entry that was read completely
+     * @return Number of entries read
+     */
+    virtual size_t readMemoryBatch(const std::vector<MemoryRead>& reads, std::vector<bool>& results);
+    
+    /**
+     * @brief Write memory of a process
+     * 
+     * @param address Starting address
+     * @param buffer Bytes to write
+     * @param size Number of bytes to write
+     * @return true if all bytes were written
+     */
+    virtual bool writeMemory(uintptr_t address, const void* buffer, size_t size) = 0;
+    
+    /**
+     * @brief Write several memory ranges, reporting each one
+     * 
+     * Providers that can scatter-write in one call override this; the
+     * default issues one writeMemory() per entry.
+     * 
+     * @param writes Entries to write, in any order
+     * @param results Receives one result per entry
+     * @param verify Read every written entry back and compare it
+     * @return Number of entries with WRITE_OK
+     */
+    virtual size_t writeMemoryBatch(const std::vector<MemoryWrite>& writes,
+                                    std::vector<WriteResult>& results,
+                                    bool verify = false);
+    
     /**
      * @brief Get base address of a module
      * 
@@ -42,6 +140,104 @@ public:
      * @brief Check if an address is valid
      */
     virtual bool isValidAddress(uintptr_t address) = 0;
+    
+    /**
+     * @brief Enumerate committed memory regions, sorted by address
+     */
+    virtual std::vector<MemoryRegion> getMemoryRegions() = 0;
+    
+    /**
+     * @brief Granularity of page state queries (write tracking, residency)
+     */
+    static constexpr size_t PAGE_STATE_BYTES = 4096;
+    
+    /**
+     * @brief Start a new write-tracking interval
+     * 
+     * Providers that can tell which pages the target wrote override this
+     * and getWrittenPages(); the default reports no support. There is one
+     * interval per provider, so only one client should take checkpoints.
+     * 
+     * @return true if pages written from now on can be reported
+     */
+    virtual bool checkpointWrites();
+    
+    /**
+     * @brief Report the pages written since the last checkpointWrites()
+     * 
+     * Providers may over-report, never under-report. The query is separate
+     * from the next checkpoint, so a write landing between the two is lost;
+     * scans use collectWrittenPages() instead.
+     * 
+     * @param address Start of the range; a multiple of PAGE_STATE_BYTES
+     * @param size Length of the range, rounded up to whole pages
+     * @param written Receives one flag per page of the range
+     * @return false if the provider cannot tell
+     */
+    virtual bool getWrittenPages(uintptr_t address, size_t size, std::vector<bool>& written);
+    
+    /**
+     * @brief Report the pages written since the last checkpoint and start a new interval
+     * 
+     * The query and the checkpoint are one step: every write shows up
+     * either in this report or in the next. Ranges the provider cannot
+     * report that way get an empty flag vector, and scans then read all
+     * their pages. The default reports nothing and calls checkpointWrites().
+     * 
+     * @param ranges Ranges to report, each starting at a multiple of PAGE_STATE_BYTES
+     * @param written Receives one flag vector per range, one flag per page
+     * @return true if pages written from now on can be reported
+     */
+    virtual bool collectWrittenPages(const std::vector<MemoryRegion>& ranges,
+                                     std::vector<std::vector<bool>>& written);
+    
+    /**
+     * @brief Report the pages the target never touched
+     * 
+     * Such pages are known to read as zeros, so scans can skip them without
+     * reading. Providers may under-report, never over-report; the default
+     * reports nothing.
+     * 
+     * @param address Start of the range; a multiple of PAGE_STATE_BYTES
+     * @param size Length of the range, rounded up to whole pages
+     * @param untouched Receives one flag per page of the range
+     * @return false if the provider cannot tell
+     */
+    virtual bool getUntouchedPages(uintptr_t address, size_t size, std::vector<bool>& untouched);
+    
+protected:
+    /**
+     * @brief Read back entries marked WRITE_OK and downgrade mismatches
+     * 
+     * @return Number of entries still WRITE_OK
+     */
+    size_t verifyWrites(const std::vector<MemoryWrite>& writes, std::vector<WriteResult>& results);
+};
+
+/**
+ * @brief Character encoding used by string scans
+ */
+enum class StringEncoding {
+    ASCII,
+    UTF16LE
+};
+
+/**
+ * @brief Options for string scans
+ */
+struct StringScanOptions {
+    StringEncoding encoding = StringEncoding::ASCII;
+    bool caseInsensitive = false;   ///< Folds ASCII letters only
+    size_t maxResults = 0;          ///< 0 = unlimited
+};
+
+/**
+ * @brief Read counters of the last whole-process scan
+ */
+struct RegionScanStats {
+    uint64_t bytesRead = 0;
+    size_t pagesUntouched = 0;  ///< Skipped unread; the provider reported them never touched
+    size_t pagesZero = 0;       ///< Read but not searched; all zeros
 };
 
 /**
@@ -106,6 +302,55 @@ public:
         const memory::Pattern& pattern,
         memory::PatternResult& result);
     
+    /**
+     * @brief Scan for a string in a memory region
+     * 
+     * The text is encoded as requested (ASCII or UTF-16LE without a
+     * terminator) and located with a SIMD first/last-byte filter, so no
+     * hex Pattern has to be written by hand.
+     * 
+     * @param text Text to search for (ASCII)
+     * @param startAddress Starting address for scan
+     * @param size Size of region to scan
+     * @param result Output parameter for result if found
+     * @param options Encoding and case folding
+     * @return true if the string was found, false otherwise
+     */
+    bool scanString(
+        const std::string& text,
+        uintptr_t startAddress,
+        size_t size,
+        memory::PatternResult& result,
+        const StringScanOptions& options = StringScanOptions());
+    
+    /**
+     * @brief Find all occurrences of a string in readable process memory
+     * 
+     * Matched bytes are not captured; the store re-reads them on request.
+     * 
+     * @param text Text to search for (ASCII)
+     * @param results Store that receives the matches in address order
+     * @param options Encoding, case folding and result limit
+     * @return Number of matches added; the scan stops early if the store cannot grow
+     */
+    size_t scanStringAll(
+        const std::string& text,
+        ScanResultStore& results,
+        const StringScanOptions& options = StringScanOptions());
+    
+    /**
+     * @brief Find all occurrences of a pattern in readable process memory
+     * 
+     * @param pattern Pattern to search for
+     * @param results Store that receives the matches in address order
+     * @param maxResults Stop after this many matches (0 = unlimited)
+     * @return Number of matches added; the scan stops early if the store cannot grow
+     */
+    size_t scanAll(
+        const memory::Pattern& pattern,
+        ScanResultStore& results,
+        size_t maxResults = 0);
+    
     /**
      * @brief Set scan algorithm
      * 
@@ -118,9 +363,15 @@ public:
      */
     IMemoryProvider* getMemoryProvider() const { return m_memoryProvider.get(); }
     
+    /**
+     * @brief Get the read counters of the last scanAll() or scanStringAll()
+     */
+    const RegionScanStats& getLastScanStats() const { return m_lastScanStats; }
+    
 private:
     std::unique_ptr<IMemoryProvider> m_memoryProvider;
     bool m_useBoyerMoore = true;
+    RegionScanStats m_lastScanStats;
     
     /**
      * @brief Naive pattern scanning algorithm
@@ -150,6 +401,23 @@ private:
         size_t size,
         memory::PatternResult& result);
     
+    /**
+     * @brief Read all readable regions in overlapping chunks
+     * 
+     * When every match has a non-zero byte at a known offset, pages that
+     * are all zeros cannot hold that byte: untouched pages are not read and
+     * zero pages are cut out of the ranges handed to fn.
+     * 
+     * @param overlap Match length; consecutive chunks share overlap - 1 bytes
+     * @param nonZeroOffset Offset of a byte that is non-zero in every match,
+     *                      or overlap if there is none
+     * @param fn Called as fn(address, data, size); returns false to stop
+     */
+    void forEachReadableChunk(
+        size_t overlap,
+        size_t nonZeroOffset,
+        const std::function<bool(uintptr_t, const uint8_t*, size_t)>& fn);
+    
     /**
      * @brief Read memory region into buffer
      */
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scanner {
+
+/**
+ * @brief Mark floats that fall inside a range
+ *
+ * Sets bit i of mask (64 bits per word) when lo <= value[i] <= hi, or
+ * lo <= value[i] < hi if hiInclusive is false. NaNs never match. Data may
+ * be unaligned. Uses SSE2/AVX when available.
+ *
+ * @param data Packed float32 values
+ * @param count Number of values
+ * @param mask Output of (count + 63) / 64 words
+ */
+void floatRangeMask(const uint8_t* data, size_t count, float lo, float hi,
+                    bool hiInclusive, uint64_t* mask);
+
+/**
+ * @brief Mark doubles that fall inside a range
+ *
+ * Same contract as floatRangeMask() for packed float64 values.
+ */
+void doubleRangeMask(const uint8_t* data, size_t count, double lo, double hi,
+                     bool hiInclusive, uint64_t* mask);
+
+/**
+ * @brief Mark float pairs whose x and y both fall inside their ranges
+ *
+ * Pair s has x at float index s * floatStride and y right after it; bit s of
+ * mask is set when x is in [loX, hiX] and y is in [loY, hiY] (upper bounds
+ * exclusive if hiInclusive is false).
+ *
+ * @param data Packed float32 values
+ * @param floatCount Number of floats available in data
+ * @param pairCount Number of pairs to evaluate
+ * @param floatStride Distance between pairs in floats (>= 1)
+ * @param mask Output of (pairCount + 63) / 64 words
+ */
+void float2RangeMask(const uint8_t* data, size_t floatCount, size_t pairCount, size_t floatStride,
+                     float loX, float hiX, float loY, float hiY,
+                     bool hiInclusive, uint64_t* mask);
+
+/**
+ * @brief Find the first occurrence of a byte string with per-byte folding
+ *
+ * Position i matches when (data[i + j] | fold[j]) == needle[j] for every j;
+ * a fold byte of 0x20 on a lowercase ASCII letter makes that byte
+ * case-insensitive. Candidates are found with SSE2/AVX2 compares of the
+ * first and last significant needle bytes before the full comparison.
+ *
+ * @param data Haystack
+ * @param size Haystack size in bytes
+ * @param needle Needle bytes (already folded)
+ * @param fold Bits to OR into haystack bytes before comparing
+ * @param needleSize Needle size in bytes (>= 1)
+ * @return Offset of the first match, or size if there is none
+ */
+size_t findString(const uint8_t* data, size_t size, const uint8_t* needle,
+                  const uint8_t* fold, size_t needleSize);
+
+} // namespace scanner
\ No newline at end of file
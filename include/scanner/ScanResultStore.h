@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace memory {
+struct PatternResult;
+}
+
+namespace scanner {
+
+class IMemoryProvider;
+
+/**
+ * @brief Growable byte buffer that can move into a memory-mapped temp file
+ *
+ * Stays on the heap until spill() is called; afterwards it lives in an
+ * anonymous temporary file mapped into memory, so the page cache rather
+ * than the heap holds it. Spilling is a no-op where mmap is unavailable.
+ */
+class SpillBuffer {
+public:
+    SpillBuffer() = default;
+    ~SpillBuffer();
+    
+    SpillBuffer(const SpillBuffer&) = delete;
+    SpillBuffer& operator=(const SpillBuffer&) = delete;
+    
+    /**
+     * @brief Append bytes
+     * @return false if the buffer could not grow
+     */
+    bool append(const void* data, size_t size);
+    
+    /**
+     * @brief Drop the bytes past size, e.g. to undo an append
+     */
+    void truncate(size_t size);
+    
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    
+    /**
+     * @brief Move the contents into a memory-mapped temp file
+     * @return true if the buffer is (now) file-backed
+     */
+    bool spill();
+    
+    /**
+     * @brief Check if the buffer is file-backed
+     */
+    bool isSpilled() const { return m_file != nullptr; }
+    
+    /**
+     * @brief Heap bytes used (0 once spilled)
+     */
+    size_t heapUsage() const { return isSpilled() ? 0 : m_heap.capacity(); }
+    
+    /**
+     * @brief Release all contents and any backing file
+     */
+    void clear();
+    
+private:
+    std::vector<uint8_t> m_heap;
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+    void* m_file = nullptr;
+    
+    bool remap(size_t capacity);
+    void unmap();
+};
+
+/**
+ * @brief Compact structure-of-arrays store for pattern/string scan hits
+ *
+ * Each hit costs an address and an interned pattern ID. Pattern names and
+ * match lengths are stored once per pattern. Matched bytes are either
+ * captured into one shared arena or, by default, re-read from the memory
+ * provider on request. Once the number of hits passes the spill threshold,
+ * all columns move into memory-mapped temp files. A hit that a spilled
+ * column cannot grow for is rejected whole, so the columns stay aligned.
+ */
+class ScanResultStore {
+public:
+    using PatternId = uint32_t;
+    
+    /**
+     * @brief Default number of hits after which columns are spilled
+     */
+    static constexpr size_t DEFAULT_SPILL_THRESHOLD = 1 << 20;
+    
+    /**
+     * @brief Construct a store
+     *
+     * @param memoryProvider Provider used to fetch lazy bytes (not owned, may be null)
+     * @param spillThreshold Hits after which columns are spilled (0 = never)
+     */
+    explicit ScanResultStore(IMemoryProvider* memoryProvider = nullptr,
+                             size_t spillThreshold = DEFAULT_SPILL_THRESHOLD);
+    
+    /**
+     * @brief Intern a pattern name; the same name and length yield the same ID
+     *
+     * @param name Pattern name
+     * @param length Number of matched bytes per hit
+     */
+    PatternId internPattern(const std::string& name, uint32_t length);
+    
+    /**
+     * @brief Add a hit whose bytes are re-read from memory on request
+     *
+     * @return false if the store could not grow; the hit is not added
+     */
+    bool add(uintptr_t address, PatternId pattern);
+    
+    /**
+     * @brief Add a hit and capture its matched bytes into the arena
+     *
+     * @param bytes Matched bytes (the pattern's length)
+     * @return false if the store could not grow; the hit is not added
+     */
+    bool add(uintptr_t address, PatternId pattern, const uint8_t* bytes);
+    
+    /**
+     * @brief Add a PatternResult, capturing its matched bytes
+     *
+     * @return false if the store could not grow; the hit is not added
+     */
+    bool add(const memory::PatternResult& result);
+    
+    /**
+     * @brief Number of hits
+     */
+    size_t size() const { return m_addresses.size() / sizeof(uintptr_t); }
+    
+    /**
+     * @brief Check if the store holds no hits
+     */
+    bool empty() const { return size() == 0; }
+    
+    uintptr_t getAddress(size_t index) const;
+    PatternId getPatternId(size_t index) const;
+    
+    /**
+     * @brief Get the name of an interned pattern
+     */
+    const std::string& getPatternName(PatternId pattern) const { return m_patterns[pattern].name; }
+    
+    /**
+     * @brief Get the match length of an interned pattern
+     */
+    uint32_t getPatternLength(PatternId pattern) const { return m_patterns[pattern].length; }
+    
+    /**
+     * @brief Number of interned patterns
+     */
+    size_t patternCount() const { return m_patterns.size(); }
+    
+    /**
+     * @brief Get the matched bytes of a hit
+     *
+     * Captured bytes come from the arena; others are read from memory and
+     * reflect its current contents.
+     *
+     * @return true if the bytes are available
+     */
+    bool getBytes(size_t index, std::vector<uint8_t>& out) const;
+    
+    /**
+     * @brief Materialize a hit as a PatternResult
+     */
+    memory::PatternResult get(size_t index) const;
+    
+    /**
+     * @brief Check if the columns have been spilled to disk
+     */
+    bool isSpilled() const { return m_addresses.isSpilled(); }
+    
+    /**
+     * @brief Heap bytes used by the store
+     */
+    size_t memoryUsage() const;
+    
+    /**
+     * @brief Remove all hits and patterns
+     */
+    void clear();
+    
+private:
+    /**
+     * @brief Arena offset marking a hit without captured bytes
+     */
+    static constexpr uint64_t NO_BYTES = ~uint64_t(0);
+    
+    struct PatternInfo {
+        std::string name;
+        uint32_t length;
+    };
+    
+    IMemoryProvider* m_memoryProvider;
+    size_t m_spillThreshold;
+    std::vector<PatternInfo> m_patterns;
+    std::unordered_map<std::string, PatternId> m_patternIds;
+    
+    SpillBuffer m_addresses;
+    SpillBuffer m_patternColumn;
+    SpillBuffer m_byteOffsets;   ///< Only filled once a hit captures bytes
+    SpillBuffer m_arena;
+    
+    /**
+     * @brief Append one row to every column, or to none of them
+     */
+    bool appendHit(uintptr_t address, PatternId pattern, uint64_t byteOffset);
+};
+
+} // namespace scanner
\ No newline at end of file
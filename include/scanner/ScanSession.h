@@ -0,0 +1,97 @@
+#pragma once
+
+#include "scanner/CandidateSet.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scanner {
+
+enum class ValueType;
+class SnapshotStore;
+
+/**
+ * @brief Candidates found for one scanned type
+ */
+struct TypedCandidates {
+    ValueType type;
+    size_t alignment;
+    CandidateSet candidates;
+};
+
+/**
+ * @brief Immutable result of one scan step
+ *
+ * Generations point to their parent and share candidate blocks with it
+ * wherever a block came through the step unchanged.
+ */
+struct ScanGeneration {
+    std::vector<TypedCandidates> results;
+    std::shared_ptr<const SnapshotStore> snapshot;  ///< Pending unknown-value snapshot
+    std::shared_ptr<const ScanGeneration> parent;
+    size_t depth;
+    std::string label;
+};
+
+/**
+ * @brief History of scan generations with O(1) undo and redo
+ */
+class ScanSession {
+public:
+    /**
+     * @brief Start a new history with a root generation
+     */
+    void start(std::vector<TypedCandidates> results, const std::string& label,
+               std::shared_ptr<const SnapshotStore> snapshot = nullptr);
+    
+    /**
+     * @brief Add a generation derived from the current one
+     *
+     * Discards any generations that could have been redone.
+     */
+    void commit(std::vector<TypedCandidates> results, const std::string& label);
+    
+    /**
+     * @brief Step back to the parent generation
+     * @return false if the current generation is the root
+     */
+    bool undo();
+    
+    /**
+     * @brief Step forward to the most recently undone generation
+     * @return false if nothing was undone
+     */
+    bool redo();
+    
+    bool canUndo() const { return m_current && m_current->parent; }
+    bool canRedo() const { return !m_redo.empty(); }
+    
+    /**
+     * @brief Get the current generation, or nullptr if no scan was started
+     */
+    const ScanGeneration* current() const { return m_current.get(); }
+    
+    /**
+     * @brief Get the current generation followed by its ancestors
+     */
+    std::vector<const ScanGeneration*> history() const;
+    
+    /**
+     * @brief Heap bytes used by all retained generations
+     *
+     * Candidate blocks shared between generations are counted once.
+     */
+    size_t memoryUsage() const;
+    
+    /**
+     * @brief Drop all generations
+     */
+    void clear();
+    
+private:
+    std::shared_ptr<const ScanGeneration> m_current;
+    std::vector<std::shared_ptr<const ScanGeneration>> m_redo;
+};
+
+} // namespace scanner
\ No newline at end of file
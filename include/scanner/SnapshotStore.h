@@ -0,0 +1,136 @@
+#pragma once
+
+#include "scanner/PageHash.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace scanner {
+
+class IMemoryProvider;
+struct MemoryRegion;
+
+/**
+ * @brief Compressed, deduplicated copy of memory pages
+ *
+ * Used by unknown-initial-value scans to remember every writable page until
+ * the first filter runs. All-zero pages cost no storage, identical pages are
+ * stored once, and the rest are LZ-compressed one page at a time so they can
+ * be decoded individually.
+ */
+class SnapshotStore {
+public:
+    /**
+     * @brief Marker blob index for pages that are entirely zero
+     */
+    static constexpr uint32_t ZERO_PAGE = 0xFFFFFFFF;
+    
+    /**
+     * @brief One captured page
+     */
+    struct PageRecord {
+        uintptr_t address;
+        uint32_t size;
+        uint32_t blobIndex;
+        uint64_t hash;
+    };
+    
+    /**
+     * @brief Capture all pages of the given regions
+     *
+     * Unreadable pages are skipped.
+     *
+     * @return Number of pages captured
+     */
+    size_t capture(IMemoryProvider& provider, const std::vector<MemoryRegion>& regions);
+    
+    /**
+     * @brief Get captured pages in address order
+     */
+    const std::vector<PageRecord>& getPages() const { return m_pages; }
+    
+    /**
+     * @brief Decode a captured page
+     *
+     * @param index Index into getPages()
+     * @param out Buffer of at least SNAPSHOT_PAGE_BYTES bytes
+     * @return true if successful
+     */
+    bool readPage(size_t index, uint8_t* out) const;
+    
+    /**
+     * @brief Visit every page with its decoded contents
+     *
+     * @param fn Callable as fn(const PageRecord& page, const uint8_t* data)
+     */
+    template<typename Fn>
+    void forEachPage(Fn&& fn) const {
+        uint8_t buffer[SNAPSHOT_PAGE_BYTES];
+        for (size_t i = 0; i < m_pages.size(); ++i) {
+            if (readPage(i, buffer)) {
+                fn(m_pages[i], static_cast<const uint8_t*>(buffer));
+            }
+        }
+    }
+    
+    /**
+     * @brief Number of bytes captured (uncompressed)
+     */
+    size_t capturedBytes() const { return m_capturedBytes; }
+    
+    /**
+     * @brief Number of pages that were entirely zero
+     */
+    size_t zeroPageCount() const { return m_zeroPages; }
+    
+    /**
+     * @brief Number of distinct non-zero pages stored
+     */
+    size_t uniquePageCount() const { return m_blobs.size(); }
+    
+    /**
+     * @brief Heap bytes used by the store
+     */
+    size_t memoryUsage() const;
+    
+    /**
+     * @brief Release all pages
+     */
+    void clear();
+    
+    /**
+     * @brief Compress one page into out
+     *
+     * @return Compressed size, or 0 if the page does not compress
+     */
+    static size_t compressPage(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+    
+    /**
+     * @brief Decompress a page produced by compressPage
+     *
+     * @return true if exactly size bytes were produced
+     */
+    static bool decompressPage(const uint8_t* data, size_t compressedSize,
+                               uint8_t* out, size_t size);
+    
+private:
+    struct Blob {
+        size_t offset;
+        uint32_t storedSize;
+        uint32_t pageSize;
+        bool compressed;
+    };
+    
+    std::vector<PageRecord> m_pages;
+    std::vector<Blob> m_blobs;
+    std::vector<uint8_t> m_arena;
+    std::unordered_map<uint64_t, uint32_t> m_dedupe;
+    size_t m_capturedBytes = 0;
+    size_t m_zeroPages = 0;
+    
+    uint32_t storePage(const uint8_t* data, size_t size, uint64_t hash);
+    bool decodeBlob(const Blob& blob, uint8_t* out) const;
+};
+
+} // namespace scanner
\ No newline at end of file
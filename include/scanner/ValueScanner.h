@@ -0,0 +1,340 @@
+#pragma once
+
+#include "scanner/CandidateSet.h"
+#include "scanner/ScanSession.h"
+#include "scanner/SnapshotStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scanner {
+
+class IMemoryProvider;
+
+/**
+ * @brief Value types understood by the value scanner
+ */
+enum class ValueType {
+    INT8,
+    INT16,
+    INT32,
+    INT64,
+    FLOAT,
+    DOUBLE,
+    VECTOR2F
+};
+
+/**
+ * @brief Comparison applied by a value scan
+ */
+enum class ScanCompare {
+    EXACT,
+    CHANGED,
+    UNCHANGED,
+    INCREASED,
+    DECREASED,
+    WITHIN,
+    BETWEEN,
+    ROUNDED
+};
+
+/**
+ * @brief Get the size in bytes of a value type
+ */
+size_t valueTypeSize(ValueType type);
+
+/**
+ * @brief Get the natural alignment in bytes of a value type
+ */
+size_t valueTypeAlignment(ValueType type);
+
+/**
+ * @brief Get the display name of a value type (e.g. "int32")
+ */
+const char* valueTypeName(ValueType type);
+
+/**
+ * @brief Parse a value type name
+ *
+ * @return true if the name is known
+ */
+bool parseValueType(const std::string& name, ValueType& type);
+
+/**
+ * @brief Get the display name of a scan comparison (e.g. "exact")
+ */
+const char* scanCompareName(ScanCompare compare);
+
+/**
+ * @brief Parse a scan comparison name ("exact", "changed", ...)
+ *
+ * @return true if the name is known
+ */
+bool parseScanCompare(const std::string& name, ScanCompare& compare);
+
+/**
+ * @brief A scan operand, kept both as integer and floating point
+ */
+struct ScanValue {
+    int64_t intValue;
+    double floatValue;
+    
+    ScanValue() : intValue(0), floatValue(0.0) {}
+    
+    static ScanValue fromInt(int64_t value);
+    static ScanValue fromFloat(double value);
+    
+    /**
+     * @brief Parse a decimal, hex (0x...) or floating point literal
+     * @throws std::invalid_argument on malformed input
+     */
+    static ScanValue fromString(const std::string& text);
+    
+    /**
+     * @brief Encode the value as the given type into out
+     */
+    void toBytes(ValueType type, uint8_t* out) const;
+};
+
+/**
+ * @brief Parameters of a single scan step
+ *
+ * EXACT, WITHIN, BETWEEN and ROUNDED compare against fixed operands:
+ * - EXACT:   x == value
+ * - WITHIN:  |x - value| <= epsilon
+ * - BETWEEN: value <= x <= value2
+ * - ROUNDED: floor(x + 0.5) == value
+ * For VECTOR2F, value holds x and value2 holds y (BETWEEN is not supported).
+ * NaNs never satisfy these comparisons.
+ */
+struct ScanCriteria {
+    ScanCompare compare;
+    ScanValue value;
+    ScanValue value2;
+    double epsilon;
+    
+    ScanCriteria(ScanCompare c = ScanCompare::EXACT, const ScanValue& v = ScanValue())
+        : compare(c), value(v), epsilon(0.0) {}
+    
+    /**
+     * @brief Check if the comparison depends only on fixed operands
+     */
+    bool isRange() const {
+        return compare == ScanCompare::EXACT || compare == ScanCompare::WITHIN ||
+               compare == ScanCompare::BETWEEN || compare == ScanCompare::ROUNDED;
+    }
+    
+    /**
+     * @brief Parse an operand expression
+     *
+     * Accepts "X" (exact), "X~E" (within E), "A..B" (between), "~X" (rounded)
+     * and "X,Y" / "X,Y~E" for vector pairs.
+     *
+     * @throws std::invalid_argument on malformed input
+     */
+    static ScanCriteria parse(const std::string& text);
+};
+
+/**
+ * @brief A value type and slot alignment to scan for
+ */
+struct ScanTypeSpec {
+    ValueType type;
+    size_t alignment;
+    
+    ScanTypeSpec(ValueType t, size_t a = 0) : type(t), alignment(a) {}
+};
+
+/**
+ * @brief One typed value of a group scan, at an offset from the group base
+ */
+struct GroupMember {
+    ptrdiff_t offset;
+    ValueType type;
+    ScanCriteria criteria;
+};
+
+class WrittenPages;
+
+/**
+ * @brief Page-level change detection counters of the last filter step
+ *
+ * Relative compares hash each re-read page first and only compare the
+ * values of pages whose hash differs from the one taken on the last read.
+ */
+struct PageScanStats {
+    size_t pagesCompared = 0;   ///< Pages whose values were compared
+    size_t pagesSkipped = 0;    ///< Pages skipped because their hash was unchanged
+    size_t pagesUntouched = 0;  ///< Pages skipped unread because the target did not write them
+};
+
+/**
+ * @brief Finds and narrows addresses holding a value of a given type
+ *
+ * A first scan walks every writable region; following scans re-read only the
+ * blocks that still hold candidates and filter them against their previous
+ * values. An unknown-initial-value scan instead snapshots every writable page
+ * and defers candidate selection to the first filter.
+ *
+ * Several types can be scanned at once: each chunk is read once and every
+ * requested type and alignment is evaluated on it while it is in cache, with
+ * candidates kept per type.
+ *
+ * Every scan step is recorded as a generation in a ScanSession. A filter
+ * step shares the candidate blocks it left untouched with its parent, so
+ * keeping the history costs only what changed and undo() is O(1).
+ *
+ * Snapshot pages and dense candidate blocks carry per-page hashes, so that
+ * CHANGED/UNCHANGED/INCREASED/DECREASED filters skip pages that did not change.
+ * Where the provider tracks writes, every scan step takes a checkpoint and
+ * the next relative filter does not even read the pages left unwritten.
+ */
+class ValueScanner {
+public:
+    /**
+     * @brief Construct a value scanner over a memory provider (not owned)
+     */
+    explicit ValueScanner(IMemoryProvider* memoryProvider);
+    
+    /**
+     * @brief Scan all writable memory for values matching the criteria
+     *
+     * @param type Value type to scan for
+     * @param criteria Comparison; must be a range comparison (see ScanCriteria)
+     * @param alignment Slot alignment in bytes (0 = natural alignment)
+     * @return true if the scan ran
+     */
+    bool firstScan(ValueType type, const ScanCriteria& criteria, size_t alignment = 0);
+    
+    /**
+     * @brief Scan all writable memory for several value types in one pass
+     *
+     * Integer types only match operands representable in them, so e.g. 100000
+     * is not searched for as an int16.
+     *
+     * @param types Value types and alignments (0 = natural alignment)
+     * @param criteria Comparison; must be a range comparison (see ScanCriteria)
+     * @return true if the scan ran
+     */
+    bool firstScan(const std::vector<ScanTypeSpec>& types, const ScanCriteria& criteria);
+    
+    /**
+     * @brief Scan for a group of values at fixed offsets from each other
+     *
+     * The member that matches least often in a sample of chunks is scanned
+     * for; the others are only checked at its hits. Candidates are the
+     * addresses of the first member, so following scans narrow on it.
+     *
+     * @param members Group layout; every criteria must be a range comparison
+     * @param alignment Alignment of the first member's address, whatever its
+     * offset (0 = the first member's natural alignment)
+     * @return true if the scan ran
+     */
+    bool groupScan(const std::vector<GroupMember>& members, size_t alignment = 0);
+    
+    /**
+     * @brief Start a scan for a value whose initial value is unknown
+     *
+     * Captures a compressed snapshot of all writable pages; the next call to
+     * nextScan() compares memory against it page by page.
+     *
+     * @param type Value type to scan for
+     * @param alignment Slot alignment in bytes (0 = natural alignment)
+     * @return true if the snapshot was captured
+     */
+    bool firstScanUnknown(ValueType type, size_t alignment = 0);
+    
+    /**
+     * @brief Filter the current candidates of every scanned type
+     *
+     * @return true if the scan ran
+     */
+    bool nextScan(const ScanCriteria& criteria);
+    
+    /**
+     * @brief Return to the candidates before the last scan step
+     *
+     * @return false if there is no earlier step
+     */
+    bool undo() { return m_session.undo(); }
+    
+    /**
+     * @brief Re-apply the most recently undone scan step
+     *
+     * @return false if nothing was undone
+     */
+    bool redo() { return m_session.redo(); }
+    
+    /**
+     * @brief Discard all candidates and history
+     */
+    void reset();
+    
+    /**
+     * @brief Check if a scan is in progress
+     */
+    bool isActive() const { return m_session.current() != nullptr; }
+    
+    /**
+     * @brief Get the (first) scanned value type
+     */
+    ValueType getValueType() const;
+    
+    /**
+     * @brief Get the current candidates of the (first) scanned type
+     */
+    const CandidateSet& getCandidates() const;
+    
+    /**
+     * @brief Get the current candidates of every scanned type
+     */
+    const std::vector<TypedCandidates>& getResults() const;
+    
+    /**
+     * @brief Get the pending unknown-value snapshot, or nullptr
+     */
+    const SnapshotStore* getSnapshot() const;
+    
+    /**
+     * @brief Get the scan history
+     */
+    const ScanSession& getSession() const { return m_session; }
+    
+    /**
+     * @brief Get the page hash counters of the last nextScan()
+     */
+    const PageScanStats& getPageStats() const { return m_pageStats; }
+    
+private:
+    IMemoryProvider* m_memoryProvider;
+    ScanSession m_session;
+    PageScanStats m_pageStats;
+    const ScanGeneration* m_trackedGeneration = nullptr;    ///< Read right after the last write checkpoint
+    
+    /**
+     * @brief Get writable regions to scan
+     */
+    std::vector<MemoryRegion> getScanRegions() const;
+    
+    /**
+     * @brief Scan all writable memory for several types with a range criteria
+     *
+     * @param results Filled with one candidate set per type
+     * @param tracking Set to whether the write checkpoint taken before reading succeeded
+     * @return false if an alignment is too large for a candidate block
+     */
+    bool rangeScan(const std::vector<ScanTypeSpec>& types, const ScanCriteria& criteria,
+                   std::vector<TypedCandidates>& results, bool& tracking);
+    
+    template<typename T>
+    void nextScanTyped(const ScanCriteria& criteria, const CandidateSet& in,
+                       const WrittenPages& written, CandidateSet& out);
+    
+    template<typename T>
+    void snapshotScanTyped(const ScanCriteria& criteria, size_t alignment,
+                           const WrittenPages& written, CandidateSet& out);
+};
+
+} // namespace scanner
\ No newline at end of file
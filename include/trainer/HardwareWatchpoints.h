@@ -0,0 +1,202 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace trainer {
+
+/**
+ * @brief Access that triggers a hardware watchpoint
+ */
+enum class WatchpointKind {
+    WRITE,          ///< Data writes
+    READ_WRITE,     ///< Data reads or writes
+    EXECUTE         ///< Instruction fetch (length must be 1)
+};
+
+/**
+ * @brief General purpose registers of a thread when it hit a watchpoint
+ */
+struct RegisterContext {
+    uint64_t rax, rbx, rcx, rdx, rsi, rdi, rbp, rsp;
+    uint64_t r8, r9, r10, r11, r12, r13, r14, r15;
+    uint64_t rip, eflags;
+};
+
+/**
+ * @brief One watchpoint hit
+ *
+ * Data watchpoints trap after the accessing instruction retired, so rip is
+ * the address of the instruction following the access; execute watchpoints
+ * report the watched instruction itself.
+ */
+struct WatchpointHit {
+    int slot;
+    int threadId;
+    uintptr_t address;      ///< Watched address
+    uintptr_t rip;
+    RegisterContext registers;
+};
+
+/**
+ * @brief Instruction address that hit a watchpoint, with its hit count
+ */
+struct AccessSite {
+    int slot;
+    uintptr_t rip;
+    uint64_t hits;
+};
+
+/**
+ * @brief Counters of a watchpoint session
+ */
+struct WatchpointStats {
+    uint64_t hits = 0;      ///< Hits collected
+    uint64_t dropped = 0;   ///< Hits overwritten in the ring buffer before being drained
+    size_t threads = 0;     ///< Target threads currently traced
+};
+
+/**
+ * @brief "What accesses this address" through the x86 debug registers
+ *
+ * attach() seizes every thread of the target with ptrace, including threads
+ * it creates later, and programs DR0-DR3/DR7 on each of them. A tracer thread
+ * then blocks in waitpid(): the target runs at full speed and the trainer
+ * does no polling until a watched address is accessed. Each hit records the
+ * thread, instruction address and registers into a fixed-size ring buffer,
+ * overwriting the oldest hit when full, and counts the hit per instruction.
+ *
+ * All ptrace requests are issued by the tracer thread. set()/clear()/detach()
+ * wake it with SIGUSR2 (a no-op handler is installed on first attach) and
+ * return once every thread runs with the new registers.
+ *
+ * Only available on x86-64 Linux; elsewhere attach() fails.
+ */
+class HardwareWatchpoints {
+public:
+    static constexpr int SLOTS = 4;
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    
+    /**
+     * @brief Construct a session for a target process
+     *
+     * @param processId Target process
+     * @param capacity Hits kept in the ring buffer
+     */
+    explicit HardwareWatchpoints(int processId, size_t capacity = DEFAULT_CAPACITY);
+    
+    /**
+     * @brief Detaches from the target
+     */
+    ~HardwareWatchpoints();
+    
+    HardwareWatchpoints(const HardwareWatchpoints&) = delete;
+    HardwareWatchpoints& operator=(const HardwareWatchpoints&) = delete;
+    
+    /**
+     * @brief Attach to every thread of the target
+     *
+     * @return false if ptrace is not permitted or the target does not exist
+     */
+    bool attach();
+    
+    /**
+     * @brief Clear the debug registers and detach from every thread
+     */
+    void detach();
+    
+    /**
+     * @brief Check if the target is traced
+     */
+    bool isAttached() const;
+    
+    /**
+     * @brief Watch an address
+     *
+     * @param address Watched address; must be aligned to length
+     * @param length 1, 2, 4 or 8 bytes (1 for EXECUTE)
+     * @param kind Accesses that trigger the watchpoint
+     * @return Slot index, or -1 if the arguments are invalid or all slots are used
+     */
+    int set(uintptr_t address, size_t length, WatchpointKind kind);
+    
+    /**
+     * @brief Stop watching a slot and forget its access sites
+     *
+     * @return false if the slot is not in use
+     */
+    bool clear(int slot);
+    
+    /**
+     * @brief Move the buffered hits, oldest first, to out
+     *
+     * @return Number of hits moved
+     */
+    size_t drain(std::vector<WatchpointHit>& out);
+    
+    /**
+     * @brief Get the instructions that hit each slot, most frequent first
+     */
+    std::vector<AccessSite> getAccessSites() const;
+    
+    /**
+     * @brief Get the watched address of a slot, or 0 if unused
+     */
+    uintptr_t getAddress(int slot) const;
+    
+    /**
+     * @brief Get the session counters
+     */
+    WatchpointStats getStats() const;
+    
+private:
+    struct Slot {
+        bool active = false;
+        uintptr_t address = 0;
+        size_t length = 0;
+        WatchpointKind kind = WatchpointKind::WRITE;
+    };
+    
+    int m_processId;
+    size_t m_capacity;
+    
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    Slot m_slots[SLOTS];
+    uint64_t m_version = 1;             ///< Bumped by set(), clear() and detach()
+    uint64_t m_appliedVersion = 0;      ///< Version every traced thread runs with
+    bool m_attached = false;
+    bool m_tracerDone = true;
+    bool m_detachRequested = false;
+    int m_tracerThreadId = 0;
+    
+    std::vector<WatchpointHit> m_hits;  ///< Ring buffer of m_capacity hits
+    size_t m_hitHead = 0;
+    size_t m_hitCount = 0;
+    std::map<std::pair<int, uintptr_t>, uint64_t> m_sites;
+    WatchpointStats m_stats;
+    std::thread m_tracer;
+    
+    /**
+     * @brief Tracer thread body; owns every ptrace request
+     */
+    void trace();
+    
+    /**
+     * @brief Record a hit of the given slots (under m_mutex)
+     */
+    void recordHit(unsigned slotMask, int threadId, const RegisterContext& registers);
+    
+    /**
+     * @brief Wake the tracer until it applied the current version or exited
+     */
+    void waitApplied(std::unique_lock<std::mutex>& lock);
+};
+
+} // namespace trainer
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "scanner/PatternScanner.h"
+#include "scanner/ValueScanner.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trainer {
+
+/**
+ * @brief A value held constant by the freezer
+ */
+struct FrozenValue {
+    uintptr_t address;
+    scanner::ValueType type;
+    scanner::ScanValue value;
+};
+
+/**
+ * @brief Timing and write counters of a value freezer
+ */
+struct FreezerStats {
+    uint64_t ticks = 0;
+    uint64_t writes = 0;           ///< Provider writes issued (after coalescing)
+    uint64_t failedWrites = 0;
+    uint64_t overruns = 0;         ///< Ticks that started after the next deadline
+    uint64_t maxTickNanos = 0;
+    uint64_t totalTickNanos = 0;
+};
+
+/**
+ * @brief Rewrites frozen values from a background thread at a fixed rate
+ *
+ * Entries are turned into a write plan whenever the set changes: they are
+ * sorted by address and adjacent or overlapping entries are merged into one
+ * contiguous write, and a tick hands all writes to the provider as one batch.
+ * A tick only takes a reference to the current plan, so editing the set never
+ * blocks on provider calls.
+ * Ticks are scheduled against absolute deadlines, so the rate does not drift
+ * with the time spent per tick.
+ */
+class ValueFreezer {
+public:
+    static constexpr unsigned DEFAULT_RATE_HZ = 60;
+    
+    /**
+     * @brief Construct a stopped freezer over a memory provider (not owned)
+     */
+    explicit ValueFreezer(scanner::IMemoryProvider* memoryProvider, unsigned rateHz = DEFAULT_RATE_HZ);
+    
+    /**
+     * @brief Stops the thread
+     */
+    ~ValueFreezer();
+    
+    ValueFreezer(const ValueFreezer&) = delete;
+    ValueFreezer& operator=(const ValueFreezer&) = delete;
+    
+    /**
+     * @brief Hold a value at an address, replacing any entry already there
+     *
+     * The value is written once immediately.
+     *
+     * @return false if the initial write failed (the entry is not kept)
+     */
+    bool freeze(uintptr_t address, scanner::ValueType type, const scanner::ScanValue& value);
+    
+    /**
+     * @brief Stop holding the value at an address
+     * @return false if no entry starts at the address
+     */
+    bool unfreeze(uintptr_t address);
+    
+    /**
+     * @brief Remove all entries
+     */
+    void clear();
+    
+    /**
+     * @brief Get the frozen entries in address order
+     */
+    std::vector<FrozenValue> getEntries() const;
+    
+    /**
+     * @brief Number of provider writes issued per tick
+     */
+    size_t writesPerTick() const;
+    
+    /**
+     * @brief Set the number of ticks per second
+     */
+    void setRate(unsigned rateHz);
+    
+    unsigned getRate() const { return m_rateHz.load(); }
+    
+    /**
+     * @brief Start the freezer thread
+     * @return false if it is already running
+     */
+    bool start();
+    
+    /**
+     * @brief Stop the freezer thread and wait for it to exit
+     */
+    void stop();
+    
+    bool isRunning() const { return m_thread.joinable(); }
+    
+    /**
+     * @brief Apply the write plan once on the calling thread
+     *
+     * @return Number of writes that succeeded
+     */
+    size_t tick();
+    
+    /**
+     * @brief Get a copy of the counters
+     */
+    FreezerStats getStats() const;
+    
+private:
+    /**
+     * @brief One contiguous write covering one or more entries
+     */
+    struct WriteSpan {
+        uintptr_t address;
+        size_t offset;      ///< Into WritePlan::bytes
+        size_t size;
+    };
+    
+    struct WritePlan {
+        std::vector<uint8_t> bytes;
+        std::vector<scanner::MemoryWrite> writes;   ///< Point into bytes
+    };
+    
+    scanner::IMemoryProvider* m_memoryProvider;
+    std::atomic<unsigned> m_rateHz;
+    
+    mutable std::mutex m_mutex;
+    std::map<uintptr_t, FrozenValue> m_entries;
+    std::shared_ptr<const WritePlan> m_plan;
+    
+    std::thread m_thread;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    
+    std::atomic<uint64_t> m_ticks{0};
+    std::atomic<uint64_t> m_writes{0};
+    std::atomic<uint64_t> m_failedWrites{0};
+    std::atomic<uint64_t> m_overruns{0};
+    std::atomic<uint64_t> m_maxTickNanos{0};
+    std::atomic<uint64_t> m_totalTickNanos{0};
+    
+    /**
+     * @brief Rebuild the write plan from the entries (caller holds m_mutex)
+     */
+    void rebuildPlan();
+    
+    void run();
+};
+
+} // namespace trainer
\ No newline at end of file
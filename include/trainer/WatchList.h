@@ -0,0 +1,183 @@
+#pragma once
+
+#include "scanner/PatternScanner.h"
+#include "scanner/ValueScanner.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace trainer {
+
+using WatchId = uint32_t;
+
+/**
+ * @brief A multi-level pointer path to a value
+ *
+ * The address is base, then for each offset: address = *address + offset.
+ * With no offsets, base is the value's address.
+ */
+struct PointerChain {
+    uintptr_t base = 0;
+    std::vector<ptrdiff_t> offsets;
+    size_t pointerSize = sizeof(uintptr_t);     ///< 4 for 32-bit targets
+};
+
+/**
+ * @brief A watched value and its polling state
+ */
+struct WatchEntry {
+    WatchId id;
+    PointerChain chain;
+    scanner::ValueType type;
+    uintptr_t address;                  ///< Last resolved address (0 if unresolved)
+    std::vector<uint8_t> value;         ///< Last value read (empty until read)
+    std::chrono::milliseconds interval; ///< Current polling interval
+    uint64_t changes;
+};
+
+/**
+ * @brief A value change delivered to subscribers
+ */
+struct WatchChange {
+    WatchId id;
+    uintptr_t address;
+    scanner::ValueType type;
+    std::vector<uint8_t> previous;      ///< Empty for the first read
+    std::vector<uint8_t> current;
+};
+
+/**
+ * @brief Read counters of a watch list
+ */
+struct WatchStats {
+    uint64_t polls = 0;         ///< Poll passes that read at least one entry
+    uint64_t entryReads = 0;    ///< Entries read
+    uint64_t batches = 0;       ///< readMemoryBatch calls (one per chain level)
+};
+
+/**
+ * @brief Polls watched values at intervals that follow how often they change
+ *
+ * Every entry starts at the minimum interval. A read that sees a change
+ * halves the interval; an unchanged or failed read grows it by half, up to
+ * the maximum. Entries falling due within half a minimum interval of each other
+ * are read in the same pass, and a pass issues one batched provider read per
+ * pointer level plus one for the values themselves.
+ */
+class WatchList {
+public:
+    using Callback = std::function<void(const WatchChange&)>;
+    
+    static constexpr std::chrono::milliseconds DEFAULT_MIN_INTERVAL{10};
+    static constexpr std::chrono::milliseconds DEFAULT_MAX_INTERVAL{1000};
+    
+    /**
+     * @brief Construct a stopped watch list over a memory provider (not owned)
+     */
+    explicit WatchList(scanner::IMemoryProvider* memoryProvider,
+                       std::chrono::milliseconds minInterval = DEFAULT_MIN_INTERVAL,
+                       std::chrono::milliseconds maxInterval = DEFAULT_MAX_INTERVAL);
+    
+    /**
+     * @brief Stops the thread
+     */
+    ~WatchList();
+    
+    WatchList(const WatchList&) = delete;
+    WatchList& operator=(const WatchList&) = delete;
+    
+    /**
+     * @brief Watch the value at a fixed address
+     */
+    WatchId add(uintptr_t address, scanner::ValueType type);
+    
+    /**
+     * @brief Watch the value at the end of a pointer chain
+     *
+     * The chain is re-resolved on every read.
+     */
+    WatchId add(const PointerChain& chain, scanner::ValueType type);
+    
+    /**
+     * @brief Stop watching an entry
+     * @return false if the ID is unknown
+     */
+    bool remove(WatchId id);
+    
+    /**
+     * @brief Get all entries in ID order
+     */
+    std::vector<WatchEntry> getEntries() const;
+    
+    /**
+     * @brief Register a change callback
+     *
+     * Callbacks run on the polling thread (or the caller of poll()) without
+     * any lock held, so they may call back into the watch list.
+     *
+     * @return Subscription ID for unsubscribe()
+     */
+    size_t subscribe(Callback callback);
+    
+    /**
+     * @brief Remove a change callback
+     */
+    bool unsubscribe(size_t subscription);
+    
+    /**
+     * @brief Read every entry due at the given time
+     *
+     * @return Number of entries read
+     */
+    size_t poll(std::chrono::steady_clock::time_point now);
+    
+    /**
+     * @brief Start the polling thread
+     * @return false if it is already running
+     */
+    bool start();
+    
+    /**
+     * @brief Stop the polling thread and wait for it to exit
+     */
+    void stop();
+    
+    bool isRunning() const { return m_thread.joinable(); }
+    
+    /**
+     * @brief Get a copy of the counters
+     */
+    WatchStats getStats() const;
+    
+private:
+    struct Slot {
+        WatchEntry entry;
+        std::chrono::steady_clock::time_point due;
+    };
+    
+    scanner::IMemoryProvider* m_memoryProvider;
+    const std::chrono::milliseconds m_minInterval;
+    const std::chrono::milliseconds m_maxInterval;
+    
+    mutable std::mutex m_mutex;
+    std::map<WatchId, Slot> m_slots;
+    WatchId m_nextId = 1;
+    std::map<size_t, Callback> m_subscribers;
+    size_t m_nextSubscription = 1;
+    WatchStats m_stats;
+    
+    std::thread m_thread;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    bool m_rescheduled = false;     ///< An entry was added while the thread slept
+    
+    void run();
+};
+
+} // namespace trainer
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -8,16 +10,20 @@
 namespace scanner {
 class PatternScanner;
 class IMemoryProvider;
-}
-
-namespace memory {
-struct PatternResult;
+class ValueScanner;
+class ScanResultStore;
 }
 
 namespace hooks {
 class FunctionHook;
 }
 
+namespace trainer {
+class HardwareWatchpoints;
+class ValueFreezer;
+class WatchList;
+}
+
 namespace ui {
 
 /**
@@ -35,6 +41,11 @@ public:
      */
     ~ConsoleUI();
     
+    /**
+     * @brief Set the target process for debug register watchpoints (0 = none)
+     */
+    void setProcessId(int processId) { m_processId = processId; }
+    
     /**
      * @brief Run the console interface
      */
@@ -42,8 +53,15 @@ public:
     
 private:
     std::unique_ptr<scanner::PatternScanner> m_scanner;
-    std::vector<memory::PatternResult> m_scanResults;
+    std::unique_ptr<scanner::ValueScanner> m_valueScanner;
+    std::unique_ptr<scanner::ScanResultStore> m_scanResults;
+    std::unique_ptr<trainer::ValueFreezer> m_freezer;
+    std::unique_ptr<trainer::WatchList> m_watchList;
+    std::mutex m_watchMutex;
+    std::deque<std::string> m_watchChanges;     ///< Recent changes, filled by the watch thread
     std::vector<std::unique_ptr<hooks::FunctionHook>> m_hooks;
+    std::unique_ptr<trainer::HardwareWatchpoints> m_watchpoints;
+    int m_processId = 0;
     bool m_running;
     
     /**
@@ -61,6 +79,21 @@ private:
      */
     void processScanCommand(std::istringstream& iss);
     
+    /**
+     * @brief Process findall command (all matches of a pattern)
+     */
+    void processFindAllCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Process string command (ASCII/UTF-16 string scan)
+     */
+    void processStringCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Print stored scan result addresses starting at index first
+     */
+    void showScanResults(size_t first, size_t limit);
+    
     /**
      * @brief Show available patterns
      */
@@ -76,11 +109,91 @@ private:
      */
     void showHooks();
     
+    /**
+     * @brief Enable or disable every hook in one queued batch
+     */
+    void setAllHooks(bool enable);
+    
+    /**
+     * @brief Turn hook call counting on or off, or reset the counts
+     */
+    void processHookStatsCommand(std::istringstream& iss);
+    
     /**
      * @brief Process memory command
      */
     void processMemoryCommand(std::istringstream& iss);
     
+    /**
+     * @brief Process value command (first value scan)
+     */
+    void processValueCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Process group command (values at fixed relative offsets)
+     */
+    void processGroupCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Process unknown command (unknown-initial-value scan)
+     */
+    void processUnknownCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Process next command (filter value scan candidates)
+     */
+    void processNextCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Process freeze command (hold a value constant)
+     */
+    void processFreezeCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Process unfreeze command
+     */
+    void processUnfreezeCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Show frozen values and freezer timing
+     */
+    void showFrozenValues();
+    
+    /**
+     * @brief Process watch command (poll a value or pointer chain)
+     */
+    void processWatchCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Show watched values, their intervals and recent changes
+     */
+    void showWatches();
+    
+    /**
+     * @brief Process hwwatch command (debug register watchpoint)
+     */
+    void processHardwareWatchCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Process hwunwatch command
+     */
+    void processHardwareUnwatchCommand(std::istringstream& iss);
+    
+    /**
+     * @brief Show the instructions that hit each watchpoint and the last hit
+     */
+    void showAccessSites();
+    
+    /**
+     * @brief Print a summary of the current value scan candidates
+     */
+    void showValueCandidates();
+    
+    /**
+     * @brief Print the value scan steps that can be undone
+     */
+    void showScanHistory();
+    
     /**
      * @brief Run demonstration tests
      */
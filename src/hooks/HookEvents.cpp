@@ -0,0 +1,150 @@
+#include "hooks/HookEvents.h"
+
+namespace hooks {
+
+namespace {
+
+uint64_t nextPumpId() {
+    static std::atomic<uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+thread_local HookEventPump::ProducerCache HookEventPump::s_producer;
+
+const char* hookEventName(HookEventType type) {
+    switch (type) {
+        case HookEventType::CALL: return "call";
+        case HookEventType::HEALTH: return "health";
+        case HookEventType::COINS: return "coins";
+        case HookEventType::LIVES: return "lives";
+        case HookEventType::VALUE: return "value";
+    }
+    return "unknown";
+}
+
+HookEventPump::HookEventPump(std::chrono::milliseconds pollInterval)
+    : m_id(nextPumpId()),
+      m_pollInterval(pollInterval.count() > 0 ? pollInterval : std::chrono::milliseconds(1)) {}
+
+HookEventPump::~HookEventPump() {
+    stop();
+}
+
+void HookEventPump::addSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    m_sinks.push_back(std::move(sink));
+}
+
+void HookEventPump::clearSinks() {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    m_sinks.clear();
+}
+
+bool HookEventPump::start() {
+    if (isRunning()) {
+        return false;
+    }
+    
+    m_stopping = false;
+    m_thread = std::thread(&HookEventPump::run, this);
+    return true;
+}
+
+void HookEventPump::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+uint64_t HookEventPump::getDropped() const {
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    uint64_t dropped = 0;
+    for (const auto& producer : m_producers) {
+        dropped += producer->ring.dropped();
+    }
+    return dropped;
+}
+
+size_t HookEventPump::pending() const {
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    size_t waiting = 0;
+    for (const auto& producer : m_producers) {
+        waiting += producer->ring.size();
+    }
+    return waiting;
+}
+
+size_t HookEventPump::producerCount() const {
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    return m_producers.size();
+}
+
+HookEventPump::Ring& HookEventPump::producerRing() {
+    std::lock_guard<std::mutex> lock(m_producerMutex);
+    
+    // Found when the thread posted to another pump in between
+    std::thread::id self = std::this_thread::get_id();
+    for (const auto& producer : m_producers) {
+        if (producer->thread == self) {
+            return producer->ring;
+        }
+    }
+    
+    m_producers.push_back(std::make_unique<Producer>());
+    m_producers.back()->thread = self;
+    return m_producers.back()->ring;
+}
+
+size_t HookEventPump::drain() {
+    {
+        std::lock_guard<std::mutex> lock(m_producerMutex);
+        m_draining.clear();
+        for (const auto& producer : m_producers) {
+            m_draining.push_back(producer.get());
+        }
+    }
+    
+    HookEvent batch[BATCH];
+    size_t delivered = 0;
+    size_t count;
+    
+    for (Producer* producer : m_draining) {
+        while ((count = producer->ring.pop(batch, BATCH)) > 0) {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            for (const Sink& sink : m_sinks) {
+                sink(batch, count);
+            }
+            delivered += count;
+        }
+    }
+    
+    m_delivered.fetch_add(delivered, std::memory_order_relaxed);
+    return delivered;
+}
+
+void HookEventPump::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    // post() never signals, so the producer stays free of system calls; the
+    // consumer polls instead and takes whatever accumulated in one pass
+    while (!m_stopping) {
+        lock.unlock();
+        drain();
+        lock.lock();
+        m_wake.wait_for(lock, m_pollInterval, [this] { return m_stopping; });
+    }
+    
+    lock.unlock();
+    drain();
+}
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,292 @@
+#include "hooks/HookRegistry.h"
+
+namespace hooks {
+
+namespace {
+
+constexpr uintptr_t EMPTY_KEY = 0;
+constexpr uintptr_t TOMBSTONE_KEY = 1;
+
+/**
+ * @brief Fibonacci hash of a target address into a power-of-two table
+ */
+size_t bucketOf(uintptr_t target, size_t mask) {
+    uint64_t hash = static_cast<uint64_t>(target) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash ^ (hash >> 32)) & mask;
+}
+
+HookHandle makeHandle(uint32_t generation, uint32_t index) {
+    return static_cast<HookHandle>((static_cast<uint64_t>(generation) << 32) | (index + 1ull));
+}
+
+/**
+ * @brief Counts a lookup in progress for as long as it probes a table
+ */
+class ReadGuard {
+public:
+    explicit ReadGuard(std::atomic<uint32_t>& readers) : m_readers(readers) { m_readers.fetch_add(1); }
+    ~ReadGuard() { m_readers.fetch_sub(1); }
+    
+private:
+    std::atomic<uint32_t>& m_readers;
+};
+
+} // anonymous namespace
+
+HookRegistry::Table::Table(size_t buckets)
+    : mask(buckets - 1),
+      keys(new std::atomic<uintptr_t>[buckets]),
+      records(new std::atomic<uint32_t>[buckets]) {
+    for (size_t i = 0; i < buckets; ++i) {
+        keys[i].store(EMPTY_KEY, std::memory_order_relaxed);
+        records[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+HookRegistry::HookRegistry()
+    : m_chunks(new std::atomic<Record*>[MAX_CHUNKS]) {
+    for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+        m_chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+    
+    m_tables.push_back(std::make_unique<Table>(INITIAL_BUCKETS));
+    m_table.store(m_tables.back().get());
+}
+
+HookRegistry::~HookRegistry() {
+    for (size_t i = 0; i < MAX_CHUNKS; ++i) {
+        delete[] m_chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+HookRegistry::Record& HookRegistry::recordAt(uint32_t index) const {
+    return m_chunks[index / CHUNK_RECORDS].load(std::memory_order_acquire)[index % CHUNK_RECORDS];
+}
+
+HookRegistry::Record* HookRegistry::record(HookHandle handle) const {
+    uint64_t value = static_cast<uint64_t>(handle);
+    uint32_t generation = static_cast<uint32_t>(value >> 32);
+    uint64_t index = (value & 0xFFFFFFFFull) - 1;
+    if (value == 0 || (generation & 1) == 0 || index >= CHUNK_RECORDS * MAX_CHUNKS) {
+        return nullptr;
+    }
+    
+    Record* chunk = m_chunks[index / CHUNK_RECORDS].load(std::memory_order_acquire);
+    if (!chunk) {
+        return nullptr;
+    }
+    
+    Record* rec = &chunk[index % CHUNK_RECORDS];
+    return rec->generation.load(std::memory_order_acquire) == generation ? rec : nullptr;
+}
+
+HookHandle HookRegistry::find(uintptr_t target) const {
+    if (target <= TOMBSTONE_KEY) {
+        return HookHandle::INVALID;
+    }
+    
+    ReadGuard guard(m_readers);
+    const Table* table = m_table.load();
+    for (size_t i = bucketOf(target, table->mask);; i = (i + 1) & table->mask) {
+        uintptr_t key = table->keys[i].load(std::memory_order_acquire);
+        if (key == EMPTY_KEY) {
+            return HookHandle::INVALID;
+        }
+        if (key != target) {
+            continue;
+        }
+        
+        // The record may be erased or reused meanwhile: accept it only if its
+        // generation is live and unchanged around the target check
+        uint32_t index = table->records[i].load(std::memory_order_relaxed);
+        const Record& rec = recordAt(index);
+        uint32_t generation = rec.generation.load(std::memory_order_acquire);
+        bool same = rec.target.load(std::memory_order_acquire) == target;
+        if ((generation & 1) && same && rec.generation.load(std::memory_order_acquire) == generation) {
+            return makeHandle(generation, index);
+        }
+    }
+}
+
+bool HookRegistry::isEnabled(HookHandle handle) const {
+    const Record* rec = record(handle);
+    return rec && rec->enabled.load(std::memory_order_acquire) && record(handle) == rec;
+}
+
+uintptr_t HookRegistry::getOriginal(HookHandle handle) const {
+    const Record* rec = record(handle);
+    uintptr_t original = rec ? rec->original.load(std::memory_order_acquire) : 0;
+    return record(handle) == rec ? original : 0;
+}
+
+uintptr_t HookRegistry::getTarget(HookHandle handle) const {
+    const Record* rec = record(handle);
+    uintptr_t target = rec ? rec->target.load(std::memory_order_acquire) : 0;
+    return record(handle) == rec ? target : 0;
+}
+
+bool HookRegistry::get(HookHandle handle, HookInfo& info) const {
+    const Record* rec = record(handle);
+    if (!rec) {
+        return false;
+    }
+    
+    info = HookInfo(rec->name, rec->target.load(), rec->hookFunction, rec->type);
+    info.originalFunction = rec->original.load();
+    info.enabled = rec->enabled.load();
+    return true;
+}
+
+HookHandle HookRegistry::insert(const HookInfo& info) {
+    uintptr_t target = info.targetAddress;
+    if (target <= TOMBSTONE_KEY || find(target) != HookHandle::INVALID) {
+        return HookHandle::INVALID;
+    }
+    
+    // Keep hooks and tombstones under half the table
+    if ((m_size + m_tombstones + 1) * 2 > m_table.load(std::memory_order_relaxed)->mask + 1) {
+        rehash();
+    }
+    
+    uint32_t index;
+    if (!m_freeRecords.empty()) {
+        index = m_freeRecords.back();
+        m_freeRecords.pop_back();
+    } else {
+        if (m_recordCount == CHUNK_RECORDS * MAX_CHUNKS) {
+            return HookHandle::INVALID;
+        }
+        index = static_cast<uint32_t>(m_recordCount++);
+        if (index % CHUNK_RECORDS == 0) {
+            m_chunks[index / CHUNK_RECORDS].store(new Record[CHUNK_RECORDS], std::memory_order_release);
+        }
+    }
+    
+    Record& rec = recordAt(index);
+    rec.name = info.name;
+    rec.hookFunction = info.hookFunction;
+    rec.type = info.type;
+    rec.original.store(info.originalFunction, std::memory_order_relaxed);
+    rec.enabled.store(info.enabled, std::memory_order_relaxed);
+    rec.target.store(target, std::memory_order_relaxed);
+    uint32_t generation = rec.generation.load(std::memory_order_relaxed) + 1;
+    rec.generation.store(generation, std::memory_order_release);
+    
+    Table* table = m_table.load(std::memory_order_relaxed);
+    size_t i = bucketOf(target, table->mask);
+    while (table->keys[i].load(std::memory_order_relaxed) > TOMBSTONE_KEY) {
+        i = (i + 1) & table->mask;
+    }
+    if (table->keys[i].load(std::memory_order_relaxed) == TOMBSTONE_KEY) {
+        --m_tombstones;
+    }
+    table->records[i].store(index, std::memory_order_relaxed);
+    table->keys[i].store(target, std::memory_order_release);
+    
+    ++m_size;
+    reclaimTables();
+    return makeHandle(generation, index);
+}
+
+bool HookRegistry::setEnabled(HookHandle handle, bool enabled) {
+    Record* rec = record(handle);
+    if (!rec) {
+        return false;
+    }
+    rec->enabled.store(enabled, std::memory_order_release);
+    return true;
+}
+
+bool HookRegistry::setOriginal(HookHandle handle, uintptr_t original) {
+    Record* rec = record(handle);
+    if (!rec) {
+        return false;
+    }
+    rec->original.store(original, std::memory_order_release);
+    return true;
+}
+
+bool HookRegistry::erase(HookHandle handle) {
+    Record* rec = record(handle);
+    if (!rec) {
+        return false;
+    }
+    
+    uintptr_t target = rec->target.load(std::memory_order_relaxed);
+    Table* table = m_table.load(std::memory_order_relaxed);
+    for (size_t i = bucketOf(target, table->mask);; i = (i + 1) & table->mask) {
+        uintptr_t key = table->keys[i].load(std::memory_order_relaxed);
+        if (key == target) {
+            table->keys[i].store(TOMBSTONE_KEY, std::memory_order_release);
+            ++m_tombstones;
+            break;
+        }
+        if (key == EMPTY_KEY) {
+            break;
+        }
+    }
+    
+    // Stale the handle before the record can be reused
+    rec->generation.store(rec->generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    rec->target.store(0, std::memory_order_release);
+    rec->enabled.store(false, std::memory_order_relaxed);
+    m_freeRecords.push_back(static_cast<uint32_t>((static_cast<uint64_t>(handle) & 0xFFFFFFFFull) - 1));
+    --m_size;
+    return true;
+}
+
+void HookRegistry::clear() {
+    for (HookHandle handle : handles()) {
+        erase(handle);
+    }
+    rehash();
+    reclaimTables();
+}
+
+std::vector<HookHandle> HookRegistry::handles() const {
+    std::vector<HookHandle> live;
+    for (uint32_t index = 0; index < m_recordCount; ++index) {
+        uint32_t generation = recordAt(index).generation.load(std::memory_order_relaxed);
+        if (generation & 1) {
+            live.push_back(makeHandle(generation, index));
+        }
+    }
+    return live;
+}
+
+void HookRegistry::rehash() {
+    size_t buckets = INITIAL_BUCKETS;
+    while (buckets < (m_size + 1) * 4) {
+        buckets *= 2;
+    }
+    
+    auto table = std::make_unique<Table>(buckets);
+    for (uint32_t index = 0; index < m_recordCount; ++index) {
+        const Record& rec = recordAt(index);
+        if (!(rec.generation.load(std::memory_order_relaxed) & 1)) {
+            continue;
+        }
+        
+        uintptr_t target = rec.target.load(std::memory_order_relaxed);
+        size_t i = bucketOf(target, table->mask);
+        while (table->keys[i].load(std::memory_order_relaxed) != EMPTY_KEY) {
+            i = (i + 1) & table->mask;
+        }
+        table->records[i].store(index, std::memory_order_relaxed);
+        table->keys[i].store(target, std::memory_order_relaxed);
+    }
+    
+    m_table.store(table.get());
+    m_tables.push_back(std::move(table));
+    m_tombstones = 0;
+}
+
+void HookRegistry::reclaimTables() {
+    // A lookup that starts after this check loads the current table, which
+    // was published before it
+    if (m_tables.size() > 1 && m_readers.load() == 0) {
+        m_tables.erase(m_tables.begin(), m_tables.end() - 1);
+    }
+}
+
+} // namespace hooks
\ No newline at end of file
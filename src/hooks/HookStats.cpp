@@ -0,0 +1,53 @@
+#include "hooks/HookStats.h"
+
+namespace hooks {
+
+std::atomic<bool> HookStats::s_enabled{false};
+
+uint64_t HookStatsSnapshot::percentileNanos(double percentile) const {
+    if (timedCalls == 0) {
+        return 0;
+    }
+    
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(timedCalls));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen > rank || seen == timedCalls) {
+            return (2ull << i) - 1;
+        }
+    }
+    return (2ull << (BUCKETS - 1)) - 1;
+}
+
+size_t HookStats::threadShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+    return index;
+}
+
+HookStatsSnapshot HookStats::snapshot() const {
+    HookStatsSnapshot total;
+    for (const Shard& s : m_shards) {
+        total.calls += s.calls.load(std::memory_order_relaxed);
+        total.timedCalls += s.timedCalls.load(std::memory_order_relaxed);
+        total.totalNanos += s.totalNanos.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < HookStatsSnapshot::BUCKETS; ++i) {
+            total.buckets[i] += s.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+void HookStats::reset() {
+    for (Shard& s : m_shards) {
+        s.calls.store(0, std::memory_order_relaxed);
+        s.timedCalls.store(0, std::memory_order_relaxed);
+        s.totalNanos.store(0, std::memory_order_relaxed);
+        for (auto& bucket : s.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace hooks
\ No newline at end of file
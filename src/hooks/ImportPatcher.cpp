@@ -0,0 +1,289 @@
+#include "hooks/ImportPatcher.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__) && defined(__x86_64__)
+#include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hooks {
+
+#if defined(__linux__) && defined(__x86_64__)
+
+namespace {
+
+/**
+ * @brief A loaded module as reported by dl_iterate_phdr
+ */
+struct LoadedModule {
+    std::string path;
+    uintptr_t base = 0;                 ///< Load bias added to every ELF address
+    const ElfW(Dyn)* dynamic = nullptr;
+    uintptr_t start = UINTPTR_MAX;      ///< Lowest and highest PT_LOAD address
+    uintptr_t end = 0;
+};
+
+int collectModule(struct dl_phdr_info* info, size_t, void* data) {
+    LoadedModule module;
+    module.path = info->dlpi_name ? info->dlpi_name : "";
+    module.base = info->dlpi_addr;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+        const ElfW(Phdr)& header = info->dlpi_phdr[i];
+        if (header.p_type == PT_DYNAMIC) {
+            module.dynamic = reinterpret_cast<const ElfW(Dyn)*>(module.base + header.p_vaddr);
+        } else if (header.p_type == PT_LOAD) {
+            module.start = std::min<uintptr_t>(module.start, module.base + header.p_vaddr);
+            module.end = std::max<uintptr_t>(module.end, module.base + header.p_vaddr + header.p_memsz);
+        }
+    }
+    auto* modules = static_cast<std::vector<LoadedModule>*>(data);
+    if (modules->empty() && module.path.empty()) {
+        // The main program comes first and unnamed
+        char path[4096];
+        ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+        module.path.assign(path, length > 0 ? static_cast<size_t>(length) : 0);
+    }
+    modules->push_back(module);
+    return 0;
+}
+
+std::vector<LoadedModule> loadedModules() {
+    std::vector<LoadedModule> modules;
+    dl_iterate_phdr(collectModule, &modules);
+    return modules;
+}
+
+std::string baseName(const std::string& path) {
+    size_t slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+bool matchesModule(const LoadedModule& module, const std::string& name, bool first) {
+    if (name.empty()) {
+        return first;   // dl_iterate_phdr reports the main program first
+    }
+    std::string file = baseName(module.path);
+    if (file.compare(0, name.size(), name) != 0) {
+        return false;
+    }
+    return file.size() == name.size() || file[name.size()] == '.' || file[name.size()] == '-';
+}
+
+/**
+ * @brief Turn a d_ptr into an address
+ *
+ * glibc relocates these entries in place when it loads a module; other
+ * loaders leave them relative to the load bias.
+ */
+uintptr_t dynamicAddress(const LoadedModule& module, ElfW(Addr) value) {
+    return value < module.base ? module.base + value : value;
+}
+
+/**
+ * @brief Append the GOT entries of symbol among count Elf64_Rela records
+ */
+void collectSlots(const LoadedModule& module, const ElfW(Rela)* relocations, size_t count,
+                  const ElfW(Sym)* symbols, const char* strings, size_t stringsSize,
+                  const std::string& symbol, std::vector<uintptr_t>& slots, std::vector<bool>& resolved) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t type = ELF64_R_TYPE(relocations[i].r_info);
+        if (type != R_X86_64_JUMP_SLOT && type != R_X86_64_GLOB_DAT) {
+            continue;
+        }
+        const ElfW(Sym)& entry = symbols[ELF64_R_SYM(relocations[i].r_info)];
+        if (entry.st_name >= stringsSize || symbol != strings + entry.st_name) {
+            continue;
+        }
+        slots.push_back(module.base + relocations[i].r_offset);
+        resolved.push_back(type == R_X86_64_GLOB_DAT);  // bound at load time
+    }
+}
+
+const SelfMapping* findMapping(const std::vector<SelfMapping>& mappings, uintptr_t address) {
+    for (const auto& mapping : mappings) {
+        if (address >= mapping.start && address < mapping.end) {
+            return &mapping;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Store a value into a GOT entry, making a RELRO page writable meanwhile
+ */
+bool storeSlot(const std::vector<SelfMapping>& mappings, uintptr_t slot, uintptr_t value) {
+    const SelfMapping* mapping = findMapping(mappings, slot);
+    if (!mapping) {
+        return false;
+    }
+    
+    uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    void* page = reinterpret_cast<void*>(slot & ~(pageSize - 1));
+    bool writable = mapping->protection & PROT_WRITE;
+    if (!writable && mprotect(page, pageSize, mapping->protection | PROT_WRITE) != 0) {
+        return false;
+    }
+    __atomic_store_n(reinterpret_cast<uintptr_t*>(slot), value, __ATOMIC_SEQ_CST);
+    if (!writable) {
+        mprotect(page, pageSize, mapping->protection);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool ImportPatcher::isSupported() {
+    return true;
+}
+
+std::vector<std::string> ImportPatcher::listModules() {
+    std::vector<std::string> names;
+    for (const auto& module : loadedModules()) {
+        names.push_back(baseName(module.path));
+    }
+    return names;
+}
+
+uintptr_t ImportPatcher::resolve(const std::string& symbol) {
+    return reinterpret_cast<uintptr_t>(dlsym(RTLD_DEFAULT, symbol.c_str()));
+}
+
+PatchStatus ImportPatcher::prepare(const std::string& module, const std::string& symbol, uintptr_t hook,
+                                   ImportPatch& patch) {
+    patch = ImportPatch();
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    const SelfMapping* hookCode = findMapping(mappings, hook);
+    if (!hookCode || !(hookCode->protection & PROT_EXEC)) {
+        return PatchStatus::NOT_EXECUTABLE;
+    }
+    
+    std::vector<LoadedModule> modules = loadedModules();
+    const LoadedModule* found = nullptr;
+    for (size_t i = 0; i < modules.size() && !found; ++i) {
+        if (matchesModule(modules[i], module, i == 0)) {
+            found = &modules[i];
+        }
+    }
+    if (!found || !found->dynamic) {
+        return PatchStatus::MODULE_NOT_FOUND;
+    }
+    
+    const ElfW(Sym)* symbols = nullptr;
+    const char* strings = nullptr;
+    size_t stringsSize = 0;
+    const ElfW(Rela)* plt = nullptr;
+    size_t pltSize = 0;
+    bool pltIsRela = true;
+    const ElfW(Rela)* rela = nullptr;
+    size_t relaSize = 0;
+    for (const ElfW(Dyn)* entry = found->dynamic; entry->d_tag != DT_NULL; ++entry) {
+        uintptr_t address = dynamicAddress(*found, entry->d_un.d_ptr);
+        switch (entry->d_tag) {
+            case DT_SYMTAB: symbols = reinterpret_cast<const ElfW(Sym)*>(address); break;
+            case DT_STRTAB: strings = reinterpret_cast<const char*>(address); break;
+            case DT_STRSZ: stringsSize = entry->d_un.d_val; break;
+            case DT_JMPREL: plt = reinterpret_cast<const ElfW(Rela)*>(address); break;
+            case DT_PLTRELSZ: pltSize = entry->d_un.d_val; break;
+            case DT_PLTREL: pltIsRela = entry->d_un.d_val == DT_RELA; break;
+            case DT_RELA: rela = reinterpret_cast<const ElfW(Rela)*>(address); break;
+            case DT_RELASZ: relaSize = entry->d_un.d_val; break;
+            default: break;
+        }
+    }
+    if (!symbols || !strings) {
+        return PatchStatus::IMPORT_NOT_FOUND;
+    }
+    
+    std::vector<uintptr_t> slots;
+    std::vector<bool> resolved;
+    if (plt && pltIsRela) {
+        collectSlots(*found, plt, pltSize / sizeof(ElfW(Rela)), symbols, strings, stringsSize, symbol,
+                     slots, resolved);
+    }
+    if (rela) {
+        collectSlots(*found, rela, relaSize / sizeof(ElfW(Rela)), symbols, strings, stringsSize, symbol,
+                     slots, resolved);
+    }
+    if (slots.empty()) {
+        return PatchStatus::IMPORT_NOT_FOUND;
+    }
+    
+    // A bound entry (GLOB_DAT, or a JUMP_SLOT pointing out of the module) is
+    // the function itself; a lazy JUMP_SLOT still points at the module's PLT
+    uintptr_t original = 0;
+    for (size_t i = 0; i < slots.size() && !original; ++i) {
+        uintptr_t value = *reinterpret_cast<const uintptr_t*>(slots[i]);
+        if (resolved[i] || value < found->start || value >= found->end) {
+            original = value;
+        }
+    }
+    if (!original) {
+        original = resolve(symbol);
+    }
+    if (!original) {
+        return PatchStatus::IMPORT_NOT_FOUND;
+    }
+    
+    patch.module = module;
+    patch.symbol = symbol;
+    patch.slots = slots;
+    for (uintptr_t slot : slots) {
+        patch.originalEntries.push_back(*reinterpret_cast<const uintptr_t*>(slot));
+    }
+    patch.original = original;
+    patch.hook = hook;
+    return PatchStatus::OK;
+}
+
+PatchStatus ImportPatcher::write(ImportPatch& patch, bool enable) {
+    if (patch.slots.empty()) {
+        return PatchStatus::IMPORT_NOT_FOUND;
+    }
+    if (patch.applied == enable) {
+        return PatchStatus::OK;
+    }
+    
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    for (size_t i = 0; i < patch.slots.size(); ++i) {
+        if (!storeSlot(mappings, patch.slots[i], enable ? patch.hook : patch.originalEntries[i])) {
+            // Put back what was already swapped so the module sees one state
+            for (size_t j = 0; j < i; ++j) {
+                storeSlot(mappings, patch.slots[j], enable ? patch.originalEntries[j] : patch.hook);
+            }
+            return PatchStatus::MEMORY_PROTECT;
+        }
+    }
+    patch.applied = enable;
+    return PatchStatus::OK;
+}
+
+#else
+
+bool ImportPatcher::isSupported() {
+    return false;
+}
+
+std::vector<std::string> ImportPatcher::listModules() {
+    return {};
+}
+
+uintptr_t ImportPatcher::resolve(const std::string&) {
+    return 0;
+}
+
+PatchStatus ImportPatcher::prepare(const std::string&, const std::string&, uintptr_t, ImportPatch& patch) {
+    patch = ImportPatch();
+    return PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+PatchStatus ImportPatcher::write(ImportPatch&, bool) {
+    return PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+#endif
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,542 @@
+#include "hooks/InlinePatcher.h"
+#include "hooks/X86Decoder.h"
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__linux__) && defined(__x86_64__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hooks {
+
+#if defined(__linux__) && defined(__x86_64__)
+
+namespace {
+
+constexpr size_t ABSOLUTE_JUMP_SIZE = 14;   // FF 25 00000000 + abs64
+constexpr size_t NEAR_JUMP_SIZE = 5;        // E9 rel32
+constexpr size_t MAX_TRAMPOLINE = 256;      // Relocated stolen instructions and the jump back
+constexpr size_t MAX_CONTEXT_CALL = 400;    // emitContextCall() output
+constexpr uint32_t RED_ZONE = 128;
+
+static_assert(MAX_CONTEXT_CALL + MAX_TRAMPOLINE <= TrampolineArena::MAX_SLOT, "mid-function stub must fit a slot");
+
+const SelfMapping* findMapping(const std::vector<SelfMapping>& mappings, uintptr_t address) {
+    for (const auto& mapping : mappings) {
+        if (address >= mapping.start && address < mapping.end) {
+            return &mapping;
+        }
+    }
+    return nullptr;
+}
+
+uintptr_t pageSize() {
+    static const uintptr_t size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+bool fitsRel32(int64_t value) {
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+/**
+ * @brief Encode jmp [rip+0] followed by the absolute destination
+ */
+size_t emitAbsoluteJump(uint8_t* out, uintptr_t destination) {
+    const uint8_t jump[6] = {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00};
+    std::memcpy(out, jump, sizeof(jump));
+    std::memcpy(out + sizeof(jump), &destination, sizeof(destination));
+    return ABSOLUTE_JUMP_SIZE;
+}
+
+/**
+ * @brief Copy one stolen instruction to its trampoline address, rewriting what depends on its address
+ *
+ * @param branchTarget Set to the destination of a relative branch, else 0
+ * @return Bytes written, or 0 if the instruction cannot be relocated
+ */
+size_t relocateInstruction(const uint8_t* code, uintptr_t source, const X86Instruction& instruction,
+                           uint8_t* out, uintptr_t destination, uintptr_t& branchTarget) {
+    uintptr_t next = source + instruction.length;
+    branchTarget = 0;
+    
+    if (instruction.relativeSize) {
+        branchTarget = next + static_cast<uintptr_t>(instruction.relative);
+        switch (instruction.branch) {
+            case X86Branch::JMP_REL:
+                return emitAbsoluteJump(out, branchTarget);
+            case X86Branch::CALL_REL: {
+                // call [rip+2]; jmp over the address; .quad target
+                const uint8_t call[8] = {0xFF, 0x15, 0x02, 0x00, 0x00, 0x00, 0xEB, 0x08};
+                std::memcpy(out, call, sizeof(call));
+                std::memcpy(out + sizeof(call), &branchTarget, sizeof(branchTarget));
+                return sizeof(call) + sizeof(branchTarget);
+            }
+            case X86Branch::JCC_REL: {
+                // Inverted short Jcc over an absolute jump
+                out[0] = static_cast<uint8_t>(0x70 | ((instruction.opcode & 0x0F) ^ 1));
+                out[1] = static_cast<uint8_t>(ABSOLUTE_JUMP_SIZE);
+                return 2 + emitAbsoluteJump(out + 2, branchTarget);
+            }
+            default:
+                return 0;   // LOOPcc/JrCXZ have no rel32 form
+        }
+    }
+    
+    std::memcpy(out, code, instruction.length);
+    if (instruction.ripRelative) {
+        int32_t displacement;
+        std::memcpy(&displacement, code + instruction.displacementOffset, sizeof(displacement));
+        uintptr_t absolute = next + static_cast<uintptr_t>(static_cast<int64_t>(displacement));
+        int64_t moved = static_cast<int64_t>(absolute - (destination + instruction.length));
+        if (!fitsRel32(moved)) {
+            return 0;
+        }
+        displacement = static_cast<int32_t>(moved);
+        std::memcpy(out + instruction.displacementOffset, &displacement, sizeof(displacement));
+    }
+    return instruction.length;
+}
+
+/**
+ * @brief Check if an instruction is filler after the end of a function
+ */
+bool isPadding(const X86Instruction& instruction) {
+    if (instruction.opcode == 0xCC || instruction.opcode == 0x90) {
+        return instruction.length <= 2;
+    }
+    return instruction.opcode == 0x1F && instruction.length >= 3;  // 0F 1F multi-byte NOP
+}
+
+/**
+ * @brief Relocate whole instructions from target until patchSize bytes are covered
+ *
+ * After the last instruction of a function only padding may be overwritten.
+ * The output size does not depend on destination, only whether the
+ * RIP-relative operands still reach their data.
+ *
+ * @param destination Where the relocated code will run
+ * @param stolen Set to the bytes taken from the target
+ */
+PatchStatus relocatePrologue(uintptr_t target, size_t readable, size_t patchSize, uintptr_t destination,
+                             uint8_t* out, size_t& outSize, size_t& stolen) {
+    const uint8_t* source = reinterpret_cast<const uint8_t*>(target);
+    std::vector<uintptr_t> branchTargets;
+    bool ended = false;
+    outSize = 0;
+    stolen = 0;
+    
+    while (stolen < patchSize) {
+        X86Instruction instruction;
+        if (!decodeX86(source + stolen, readable - stolen, instruction)) {
+            return PatchStatus::UNSUPPORTED_FUNCTION;
+        }
+        
+        if (ended) {
+            if (!isPadding(instruction)) {
+                return PatchStatus::UNSUPPORTED_FUNCTION;
+            }
+            stolen += instruction.length;
+            continue;
+        }
+        
+        uintptr_t branchTarget = 0;
+        size_t size = 0;
+        if (outSize + 2 * ABSOLUTE_JUMP_SIZE + 2 <= MAX_TRAMPOLINE) {
+            size = relocateInstruction(source + stolen, target + stolen, instruction,
+                                       out + outSize, destination + outSize, branchTarget);
+        }
+        if (size == 0) {
+            return PatchStatus::UNSUPPORTED_FUNCTION;
+        }
+        if (branchTarget) {
+            branchTargets.push_back(branchTarget);
+        }
+        
+        outSize += size;
+        stolen += instruction.length;
+        ended = instruction.endsFlow();
+    }
+    
+    // A branch back into the stolen bytes would land inside the jump
+    for (uintptr_t branchTarget : branchTargets) {
+        if (branchTarget > target && branchTarget < target + stolen) {
+            return PatchStatus::UNSUPPORTED_FUNCTION;
+        }
+    }
+    
+    if (!ended) {
+        outSize += emitAbsoluteJump(out + outSize, target + stolen);
+    }
+    return PatchStatus::OK;
+}
+
+/**
+ * @brief Appends machine code to a buffer
+ */
+struct CodeWriter {
+    uint8_t* out;
+    size_t size = 0;
+    
+    void emit(std::initializer_list<uint8_t> bytes) {
+        for (uint8_t byte : bytes) {
+            out[size++] = byte;
+        }
+    }
+    
+    template<typename T>
+    void value(T v) {
+        std::memcpy(out + size, &v, sizeof(v));
+        size += sizeof(v);
+    }
+};
+
+/**
+ * @brief Store (0x7F) or load (0x6F) XMM register index at [rsp + index * 16] with movdqu
+ */
+void emitXmmMove(CodeWriter& code, uint8_t opcode, unsigned index) {
+    code.emit({0xF3});
+    if (index >= 8) {
+        code.emit({0x44});  // REX.R
+    }
+    code.emit({0x0F, opcode, static_cast<uint8_t>(0x84 | ((index & 7) << 3)), 0x24});
+    code.value<uint32_t>(index * 16);
+}
+
+/**
+ * @brief Encode the register save, handler call and restore of a mid-function hook
+ *
+ * The stack then holds a HookContext: RFLAGS is pushed first, so it ends up
+ * highest, and the XMM registers are stored last, lowest.
+ */
+size_t emitContextCall(uint8_t* out, uintptr_t handler) {
+    CodeWriter code{out};
+    
+    code.emit({0x48, 0x8D, 0x64, 0x24, 0x80});      // lea rsp, [rsp-128]
+    code.emit({0x9C});                              // pushfq
+    for (int r = 7; r >= 0; --r) {
+        code.emit({0x41, static_cast<uint8_t>(0x50 + r)});  // push r15 ... r8
+    }
+    code.emit({0x54});                              // push rsp
+    code.emit({0x55, 0x57, 0x56, 0x52, 0x51, 0x53, 0x50});  // push rbp, rdi, rsi, rdx, rcx, rbx, rax
+    
+    // push rsp stored its value after the red zone, RFLAGS and R15-R8
+    code.emit({0x48, 0x81, 0x44, 0x24, 0x38});      // add qword [rsp+56], imm32
+    code.value<uint32_t>(RED_ZONE + 9 * 8);
+    
+    code.emit({0x48, 0x81, 0xEC});                  // sub rsp, 256
+    code.value<uint32_t>(256);
+    for (unsigned i = 0; i < 16; ++i) {
+        emitXmmMove(code, 0x7F, i);
+    }
+    
+    code.emit({0xFC});                              // cld
+    code.emit({0x48, 0x89, 0xE3});                  // mov rbx, rsp
+    code.emit({0x48, 0x83, 0xE4, 0xF0});            // and rsp, -16
+    code.emit({0x48, 0x89, 0xDF});                  // mov rdi, rbx
+    code.emit({0x48, 0xB8});                        // mov rax, handler
+    code.value<uint64_t>(handler);
+    code.emit({0xFF, 0xD0});                        // call rax
+    code.emit({0x48, 0x89, 0xDC});                  // mov rsp, rbx
+    
+    for (unsigned i = 0; i < 16; ++i) {
+        emitXmmMove(code, 0x6F, i);
+    }
+    code.emit({0x48, 0x81, 0xC4});                  // add rsp, 256
+    code.value<uint32_t>(256);
+    code.emit({0x58, 0x5B, 0x59, 0x5A, 0x5E, 0x5F, 0x5D});  // pop rax, rbx, rcx, rdx, rsi, rdi, rbp
+    code.emit({0x48, 0x83, 0xC4, 0x08});            // add rsp, 8 (the saved rsp is not loaded)
+    for (int r = 0; r < 8; ++r) {
+        code.emit({0x41, static_cast<uint8_t>(0x58 + r)});  // pop r8 ... r15
+    }
+    code.emit({0x9D});                              // popfq
+    code.emit({0x48, 0x8D, 0xA4, 0x24});            // lea rsp, [rsp+128]
+    code.value<uint32_t>(RED_ZONE);
+    return code.size;
+}
+
+/**
+ * @brief Encode the jump written at target, rel32 if destination is near
+ */
+size_t emitPatchJump(uint8_t* out, uintptr_t target, uintptr_t destination, bool near) {
+    if (!near) {
+        return emitAbsoluteJump(out, destination);
+    }
+    int32_t rel = static_cast<int32_t>(static_cast<int64_t>(destination - (target + NEAR_JUMP_SIZE)));
+    out[0] = 0xE9;
+    std::memcpy(out + 1, &rel, sizeof(rel));
+    return NEAR_JUMP_SIZE;
+}
+
+/**
+ * @brief Atomically store 2 bytes that do not straddle a cache line
+ */
+void store16(uintptr_t address, uint16_t value) {
+    __asm__ __volatile__("movw %1, %0"
+                         : "=m"(*reinterpret_cast<volatile uint16_t*>(address))
+                         : "r"(value)
+                         : "memory");
+}
+
+/**
+ * @brief Write patch bytes so that no thread can execute a torn jump
+ */
+void storePatch(uintptr_t target, const uint8_t* bytes, size_t size) {
+    uintptr_t word = target & ~static_cast<uintptr_t>(7);
+    if ((target & 7) + size <= 8) {
+        uint64_t value;
+        std::memcpy(&value, reinterpret_cast<const void*>(word), sizeof(value));
+        std::memcpy(reinterpret_cast<uint8_t*>(&value) + (target & 7), bytes, size);
+        __atomic_store_n(reinterpret_cast<uint64_t*>(word), value, __ATOMIC_SEQ_CST);
+        return;
+    }
+    
+    if ((target & 63) == 63) {
+        // The first instruction bytes straddle a cache line, where no 2-byte
+        // store is atomic; entry points are practically never placed there
+        std::memcpy(reinterpret_cast<void*>(target), bytes, size);
+        return;
+    }
+    
+    // Park entering threads on "jmp $" while the tail is written
+    store16(target, 0xFEEB);
+    std::memcpy(reinterpret_cast<void*>(target + 2), bytes + 2, size - 2);
+    uint16_t head;
+    std::memcpy(&head, bytes, sizeof(head));
+    store16(target, head);
+}
+
+} // anonymous namespace
+
+bool InlinePatcher::isSupported() {
+    return true;
+}
+
+TrampolineArena& InlinePatcher::arena() {
+    // Never destroyed: a jump still applied at exit may lead into it
+    static TrampolineArena* trampolines = new TrampolineArena();
+    return *trampolines;
+}
+
+bool InlinePatcher::isExecutable(uintptr_t address) {
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    const SelfMapping* mapping = findMapping(mappings, address);
+    return mapping && (mapping->protection & PROT_EXEC);
+}
+
+PatchStatus InlinePatcher::prepare(uintptr_t target, uintptr_t detour, InlinePatch& patch) {
+    patch = InlinePatch();
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    const SelfMapping* code = findMapping(mappings, target);
+    const SelfMapping* hook = findMapping(mappings, detour);
+    if (!code || !hook || !(code->protection & PROT_EXEC) || !(hook->protection & PROT_EXEC) ||
+        !(code->protection & PROT_READ)) {
+        return PatchStatus::NOT_EXECUTABLE;
+    }
+    
+    TrampolineArena& slots = arena();
+    uintptr_t relay = slots.allocate(target, ABSOLUTE_JUMP_SIZE);
+    if (!relay) {
+        return PatchStatus::MEMORY_ALLOC;
+    }
+    bool near = TrampolineArena::isNear(target + NEAR_JUMP_SIZE, relay);
+    size_t patchSize = near ? NEAR_JUMP_SIZE : ABSOLUTE_JUMP_SIZE;
+    
+    // A dry run sizes the trampoline slot, then the real one relocates into it
+    size_t readable = code->end - target;
+    uint8_t relocated[MAX_TRAMPOLINE];
+    size_t relocatedSize = 0;
+    size_t stolen = 0;
+    uintptr_t trampoline = 0;
+    PatchStatus status = relocatePrologue(target, readable, patchSize, relay, relocated, relocatedSize, stolen);
+    if (status == PatchStatus::OK) {
+        trampoline = slots.allocate(target, relocatedSize);
+        status = trampoline ? relocatePrologue(target, readable, patchSize, trampoline, relocated, relocatedSize, stolen)
+                            : PatchStatus::MEMORY_ALLOC;
+    }
+    
+    uint8_t relayCode[ABSOLUTE_JUMP_SIZE];
+    emitAbsoluteJump(relayCode, detour);
+    if (status == PatchStatus::OK && (!slots.write(relay, relayCode, sizeof(relayCode)) ||
+                                      !slots.write(trampoline, relocated, relocatedSize))) {
+        status = PatchStatus::MEMORY_PROTECT;
+    }
+    if (status != PatchStatus::OK) {
+        slots.release(relay);
+        if (trampoline) {
+            slots.release(trampoline);
+        }
+        return status;
+    }
+    
+    patch.target = target;
+    patch.detour = detour;
+    patch.trampoline = trampoline;
+    patch.relay = relay;
+    patch.patchSize = patchSize;
+    patch.stolenSize = stolen;
+    std::memcpy(patch.originalBytes, reinterpret_cast<const void*>(target), patchSize);
+    emitPatchJump(patch.jumpBytes, target, near ? relay : detour, near);
+    return PatchStatus::OK;
+}
+
+PatchStatus InlinePatcher::prepareMid(uintptr_t target, MidHookHandler handler, InlinePatch& patch) {
+    patch = InlinePatch();
+    uintptr_t detour = reinterpret_cast<uintptr_t>(handler);
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    const SelfMapping* code = findMapping(mappings, target);
+    const SelfMapping* hook = findMapping(mappings, detour);
+    if (!code || !hook || !(code->protection & PROT_EXEC) || !(hook->protection & PROT_EXEC) ||
+        !(code->protection & PROT_READ)) {
+        return PatchStatus::NOT_EXECUTABLE;
+    }
+    
+    TrampolineArena& slots = arena();
+    uintptr_t trampoline = slots.allocate(target, MAX_CONTEXT_CALL + MAX_TRAMPOLINE);
+    if (!trampoline) {
+        return PatchStatus::MEMORY_ALLOC;
+    }
+    
+    uint8_t stub[MAX_CONTEXT_CALL + MAX_TRAMPOLINE];
+    size_t callSize = emitContextCall(stub, detour);
+    size_t readable = code->end - target;
+    size_t relocatedSize = 0;
+    size_t stolen = 0;
+    bool near = TrampolineArena::isNear(target + NEAR_JUMP_SIZE, trampoline);
+    size_t patchSize = near ? NEAR_JUMP_SIZE : ABSOLUTE_JUMP_SIZE;
+    PatchStatus status = relocatePrologue(target, readable, patchSize, trampoline + callSize, stub + callSize,
+                                          relocatedSize, stolen);
+    if (status == PatchStatus::OK && !slots.write(trampoline, stub, callSize + relocatedSize)) {
+        status = PatchStatus::MEMORY_PROTECT;
+    }
+    if (status != PatchStatus::OK) {
+        slots.release(trampoline);
+        return status;
+    }
+    
+    patch.target = target;
+    patch.detour = detour;
+    patch.trampoline = trampoline;
+    patch.patchSize = patchSize;
+    patch.stolenSize = stolen;
+    std::memcpy(patch.originalBytes, reinterpret_cast<const void*>(target), patchSize);
+    emitPatchJump(patch.jumpBytes, target, trampoline, near);
+    return PatchStatus::OK;
+}
+
+PatchStatus InlinePatcher::write(InlinePatch& patch, bool enable) {
+    return writeBatch({{&patch, enable}});
+}
+
+PatchStatus InlinePatcher::writeBatch(const std::vector<std::pair<InlinePatch*, bool>>& changes) {
+    struct Page {
+        uintptr_t address;
+        int protection;
+    };
+    
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    std::vector<Page> pages;
+    uintptr_t mask = ~(pageSize() - 1);
+    uintptr_t low = UINTPTR_MAX;
+    uintptr_t high = 0;
+    
+    for (const auto& change : changes) {
+        const InlinePatch* patch = change.first;
+        if (!patch->trampoline || patch->applied == change.second) {
+            continue;
+        }
+        low = std::min(low, patch->target);
+        high = std::max(high, patch->target + patch->patchSize);
+        
+        for (uintptr_t page = patch->target & mask; page < patch->target + patch->patchSize; page += pageSize()) {
+            bool known = std::any_of(pages.begin(), pages.end(), [page](const Page& p) { return p.address == page; });
+            if (known) {
+                continue;
+            }
+            const SelfMapping* mapping = findMapping(mappings, page);
+            if (!mapping) {
+                return PatchStatus::MEMORY_PROTECT;
+            }
+            pages.push_back(Page{page, mapping->protection});
+        }
+    }
+    
+    for (size_t i = 0; i < pages.size(); ++i) {
+        if (mprotect(reinterpret_cast<void*>(pages[i].address), pageSize(),
+                     PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+            for (size_t j = 0; j < i; ++j) {
+                mprotect(reinterpret_cast<void*>(pages[j].address), pageSize(), pages[j].protection);
+            }
+            return PatchStatus::MEMORY_PROTECT;
+        }
+    }
+    
+    for (const auto& change : changes) {
+        InlinePatch* patch = change.first;
+        if (!patch->trampoline || patch->applied == change.second) {
+            continue;
+        }
+        storePatch(patch->target, change.second ? patch->jumpBytes : patch->originalBytes, patch->patchSize);
+        patch->applied = change.second;
+    }
+    
+    for (const auto& page : pages) {
+        mprotect(reinterpret_cast<void*>(page.address), pageSize(), page.protection);
+    }
+    
+    if (low < high) {
+        __builtin___clear_cache(reinterpret_cast<char*>(low), reinterpret_cast<char*>(high));
+    }
+    return PatchStatus::OK;
+}
+
+void InlinePatcher::release(InlinePatch& patch) {
+    if (patch.trampoline && !patch.applied) {
+        if (patch.relay) {
+            arena().release(patch.relay);
+        }
+        arena().release(patch.trampoline);
+        patch = InlinePatch();
+    }
+}
+
+#else
+
+bool InlinePatcher::isSupported() {
+    return false;
+}
+
+TrampolineArena& InlinePatcher::arena() {
+    static TrampolineArena* trampolines = new TrampolineArena();
+    return *trampolines;
+}
+
+bool InlinePatcher::isExecutable(uintptr_t) {
+    return false;
+}
+
+PatchStatus InlinePatcher::prepare(uintptr_t, uintptr_t, InlinePatch& patch) {
+    patch = InlinePatch();
+    return PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+PatchStatus InlinePatcher::prepareMid(uintptr_t, MidHookHandler, InlinePatch& patch) {
+    patch = InlinePatch();
+    return PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+PatchStatus InlinePatcher::write(InlinePatch&, bool) {
+    return PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+PatchStatus InlinePatcher::writeBatch(const std::vector<std::pair<InlinePatch*, bool>>& changes) {
+    return changes.empty() ? PatchStatus::OK : PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+void InlinePatcher::release(InlinePatch&) {}
+
+#endif
+
+} // namespace hooks
\ No newline at end of file
@@ -1,38 +1,129 @@
 #include "hooks/MinHookWrapper.h"
+#include "hooks/HookRegistry.h"
 #include <algorithm>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace hooks {
 
+namespace {
+
+MHStatus toStatus(PatchStatus status) {
+    switch (status) {
+        case PatchStatus::OK: return MHStatus::MH_OK;
+        case PatchStatus::NOT_EXECUTABLE: return MHStatus::MH_ERROR_NOT_EXECUTABLE;
+        case PatchStatus::UNSUPPORTED_FUNCTION: return MHStatus::MH_ERROR_UNSUPPORTED_FUNCTION;
+        case PatchStatus::MEMORY_ALLOC: return MHStatus::MH_ERROR_MEMORY_ALLOC;
+        case PatchStatus::MEMORY_PROTECT: return MHStatus::MH_ERROR_MEMORY_PROTECT;
+        case PatchStatus::BAD_VTABLE: return MHStatus::MH_ERROR_FUNCTION_NOT_FOUND;
+        case PatchStatus::VIRTUAL_BASES: return MHStatus::MH_ERROR_UNSUPPORTED_FUNCTION;
+        case PatchStatus::MODULE_NOT_FOUND: return MHStatus::MH_ERROR_MODULE_NOT_FOUND;
+        case PatchStatus::IMPORT_NOT_FOUND: return MHStatus::MH_ERROR_FUNCTION_NOT_FOUND;
+    }
+    return MHStatus::MH_ERROR_UNSUPPORTED_FUNCTION;
+}
+
+const char* describe(PatchStatus status) {
+    switch (status) {
+        case PatchStatus::OK: return "OK";
+        case PatchStatus::NOT_EXECUTABLE: return "Target or hook function is not executable";
+        case PatchStatus::UNSUPPORTED_FUNCTION: return "Cannot relocate the instructions at the target";
+        case PatchStatus::MEMORY_ALLOC: return "Cannot allocate a trampoline";
+        case PatchStatus::MEMORY_PROTECT: return "Cannot make the target writable";
+        case PatchStatus::BAD_VTABLE: return "Object has no virtual function in that slot";
+        case PatchStatus::VIRTUAL_BASES: return "Class has virtual bases; hook it with CLASS scope";
+        case PatchStatus::MODULE_NOT_FOUND: return "No loaded module has that name";
+        case PatchStatus::IMPORT_NOT_FOUND: return "Module does not import that symbol";
+    }
+    return "Unknown patch error";
+}
+
+// Registry key for a mock import hook, one per module!symbol name. The keys
+// start above the user address space so no real target can share one.
+// Callers hold MinHookWrapper's mutex.
+uintptr_t mockImportKey(const std::string& name) {
+    static std::unordered_map<std::string, uintptr_t> keys;
+    auto it = keys.emplace(name, 0x0000800000000000ULL + keys.size() * 16).first;
+    return it->second;
+}
+
+} // anonymous namespace
+
 // Static member initialization
-bool MinHookWrapper::s_initialized = false;
-std::string MinHookWrapper::s_lastError = "";
-std::vector<HookInfo> MinHookWrapper::s_hooks;
+std::atomic<bool> MinHookWrapper::s_initialized{false};
+std::atomic<HookEngine> MinHookWrapper::s_engine{HookEngine::MOCK};
+thread_local std::string MinHookWrapper::s_lastError = "";
+std::mutex MinHookWrapper::s_mutex;
 
-MHStatus MinHookWrapper::initialize() {
+HookRegistry& MinHookWrapper::registry() {
+    static HookRegistry hooks;
+    return hooks;
+}
+
+std::unordered_map<uint64_t, InlinePatch>& MinHookWrapper::patches() {
+    static std::unordered_map<uint64_t, InlinePatch> inlinePatches;
+    return inlinePatches;
+}
+
+std::unordered_map<uint64_t, VTablePatch>& MinHookWrapper::vtablePatches() {
+    static std::unordered_map<uint64_t, VTablePatch> slotPatches;
+    return slotPatches;
+}
+
+std::unordered_map<uint64_t, ImportPatch>& MinHookWrapper::importPatches() {
+    static std::unordered_map<uint64_t, ImportPatch> gotPatches;
+    return gotPatches;
+}
+
+std::vector<QueuedHookChange>& MinHookWrapper::queue() {
+    static std::vector<QueuedHookChange> changes;
+    return changes;
+}
+
+MHStatus MinHookWrapper::initialize(HookEngine engine) {
+    std::lock_guard<std::mutex> lock(s_mutex);
     if (s_initialized) {
         s_lastError = "MinHook already initialized";
         return MHStatus::MH_ERROR_ALREADY_INITIALIZED;
     }
     
+    if (engine == HookEngine::INLINE && !InlinePatcher::isSupported()) {
+        s_lastError = "Inline hooks are not supported on this platform";
+        return MHStatus::MH_ERROR_UNSUPPORTED_FUNCTION;
+    }
+    
+    s_engine = engine;
     s_initialized = true;
-    s_lastError = "Initialized successfully (mock implementation)";
+    s_lastError = engine == HookEngine::INLINE ? "Initialized successfully (inline engine)"
+                                               : "Initialized successfully (mock implementation)";
     return MHStatus::MH_OK;
 }
 
 MHStatus MinHookWrapper::uninitialize() {
+    std::lock_guard<std::mutex> lock(s_mutex);
     if (!s_initialized) {
         s_lastError = "MinHook not initialized";
         return MHStatus::MH_ERROR_NOT_INITIALIZED;
     }
     
     // Remove all hooks
-    for (auto& hook : s_hooks) {
-        if (hook.enabled) {
-            disableHook(reinterpret_cast<void*>(hook.targetAddress));
+    for (HookHandle handle : registry().handles()) {
+        if (registry().isEnabled(handle)) {
+            setEnabledLocked(handle, false);
         }
     }
-    s_hooks.clear();
+    for (auto& entry : patches()) {
+        InlinePatcher::release(entry.second);
+    }
+    patches().clear();
+    for (auto& entry : vtablePatches()) {
+        VTablePatcher::release(entry.second);
+    }
+    vtablePatches().clear();
+    importPatches().clear();
+    registry().clear();
+    queue().clear();
     
     s_initialized = false;
     s_lastError = "Uninitialized successfully";
@@ -40,34 +131,174 @@ MHStatus MinHookWrapper::uninitialize() {
 }
 
 MHStatus MinHookWrapper::createHook(void* target, void* hook, void** original) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    uintptr_t originalAddr = 0;
+    MHStatus status = createHookLocked(reinterpret_cast<uintptr_t>(target), reinterpret_cast<uintptr_t>(hook),
+                                       HookType::HOOK_JMP, &originalAddr);
+    if (status == MHStatus::MH_OK && original) {
+        *original = reinterpret_cast<void*>(originalAddr);
+    }
+    return status;
+}
+
+MHStatus MinHookWrapper::createMidHook(void* address, MidHookHandler handler) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return createHookLocked(reinterpret_cast<uintptr_t>(address), reinterpret_cast<uintptr_t>(handler),
+                            HookType::HOOK_MID, nullptr);
+}
+
+MHStatus MinHookWrapper::createVTableHook(void* object, size_t slot, void* hook, void** original,
+                                          VTableScope scope, HookHandle* handle) {
+    std::lock_guard<std::mutex> lock(s_mutex);
     if (!s_initialized) {
         s_lastError = "MinHook not initialized";
         return MHStatus::MH_ERROR_NOT_INITIALIZED;
     }
     
-    uintptr_t targetAddr = reinterpret_cast<uintptr_t>(target);
+    // The mock engine cannot read the object, so it keys the hook by object and slot
     uintptr_t hookAddr = reinterpret_cast<uintptr_t>(hook);
+    VTablePatch patch;
+    uintptr_t key = reinterpret_cast<uintptr_t>(object) + slot * sizeof(uintptr_t);
+    if (s_engine == HookEngine::INLINE) {
+        PatchStatus prepared = VTablePatcher::prepare(object, slot, hookAddr, scope, patch);
+        if (prepared != PatchStatus::OK) {
+            s_lastError = describe(prepared);
+            return toStatus(prepared);
+        }
+        key = patch.slotAddress;
+    }
     
-    // Check if hook already exists
-    auto it = std::find_if(s_hooks.begin(), s_hooks.end(),
-        [targetAddr](const HookInfo& h) { return h.targetAddress == targetAddr; });
+    if (registry().find(key) != HookHandle::INVALID) {
+        VTablePatcher::release(patch);
+        s_lastError = "Hook already exists for this virtual function";
+        return MHStatus::MH_ERROR_ALREADY_CREATED;
+    }
+    
+    HookInfo hookInfo("", key, hookAddr, HookType::HOOK_VTABLE);
+    hookInfo.originalFunction = patch.original;
+    HookHandle created = registry().insert(hookInfo);
+    if (created == HookHandle::INVALID) {
+        VTablePatcher::release(patch);
+        s_lastError = "Cannot register a hook for this virtual function";
+        return MHStatus::MH_ERROR_NOT_EXECUTABLE;
+    }
+    if (s_engine == HookEngine::INLINE) {
+        vtablePatches()[static_cast<uint64_t>(created)] = patch;
+    }
+    
+    if (original) {
+        *original = reinterpret_cast<void*>(patch.original);
+    }
+    if (handle) {
+        *handle = created;
+    }
     
-    if (it != s_hooks.end()) {
+    s_lastError = s_engine == HookEngine::INLINE ? "Hook created successfully" : "Hook created successfully (mock)";
+    return MHStatus::MH_OK;
+}
+
+MHStatus MinHookWrapper::createImportHook(const std::string& module, const std::string& symbol, void* hook,
+                                          void** original, HookHandle* handle) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (!s_initialized) {
+        s_lastError = "MinHook not initialized";
+        return MHStatus::MH_ERROR_NOT_INITIALIZED;
+    }
+    
+    // The mock engine has no GOT to find: it keys the hook by the import's
+    // name and, like createHook(), calls the function itself as the original
+    uintptr_t hookAddr = reinterpret_cast<uintptr_t>(hook);
+    std::string name = module + "!" + symbol;
+    ImportPatch patch;
+    uintptr_t key = mockImportKey(name);
+    patch.original = ImportPatcher::resolve(symbol);
+    if (!patch.original) {
+        patch.original = key;
+    }
+    if (s_engine == HookEngine::INLINE) {
+        PatchStatus prepared = ImportPatcher::prepare(module, symbol, hookAddr, patch);
+        if (prepared != PatchStatus::OK) {
+            s_lastError = describe(prepared);
+            return toStatus(prepared);
+        }
+        key = patch.slots.front();
+    }
+    
+    if (registry().find(key) != HookHandle::INVALID) {
+        s_lastError = "Hook already exists for this import";
+        return MHStatus::MH_ERROR_ALREADY_CREATED;
+    }
+    
+    HookInfo hookInfo(name, key, hookAddr, HookType::HOOK_IMPORT);
+    hookInfo.originalFunction = patch.original;
+    HookHandle created = registry().insert(hookInfo);
+    if (created == HookHandle::INVALID) {
+        s_lastError = "Cannot register a hook for this import";
+        return MHStatus::MH_ERROR_NOT_EXECUTABLE;
+    }
+    if (s_engine == HookEngine::INLINE) {
+        importPatches()[static_cast<uint64_t>(created)] = std::move(patch);
+    }
+    
+    if (original) {
+        *original = reinterpret_cast<void*>(registry().getOriginal(created));
+    }
+    if (handle) {
+        *handle = created;
+    }
+    
+    s_lastError = s_engine == HookEngine::INLINE ? "Hook created successfully" : "Hook created successfully (mock)";
+    return MHStatus::MH_OK;
+}
+
+MHStatus MinHookWrapper::createHookLocked(uintptr_t targetAddr, uintptr_t hookAddr, HookType type,
+                                          uintptr_t* original) {
+    if (!s_initialized) {
+        s_lastError = "MinHook not initialized";
+        return MHStatus::MH_ERROR_NOT_INITIALIZED;
+    }
+    
+    // Check if hook already exists
+    if (registry().find(targetAddr) != HookHandle::INVALID) {
         s_lastError = "Hook already exists for this address";
         return MHStatus::MH_ERROR_ALREADY_CREATED;
     }
     
-    // Create mock hook
-    HookInfo hookInfo("", targetAddr, hookAddr);
-    hookInfo.originalFunction = targetAddr; // In real MinHook, this would be different
+    // The mock engine calls the target itself as the original; a mid-function
+    // hook has none
+    bool mid = type == HookType::HOOK_MID;
+    HookInfo hookInfo("", targetAddr, hookAddr, type);
+    hookInfo.originalFunction = mid ? 0 : targetAddr;
+    
+    InlinePatch patch;
+    if (s_engine == HookEngine::INLINE) {
+        PatchStatus prepared = mid
+            ? InlinePatcher::prepareMid(targetAddr, reinterpret_cast<MidHookHandler>(hookAddr), patch)
+            : InlinePatcher::prepare(targetAddr, hookAddr, patch);
+        if (prepared != PatchStatus::OK) {
+            s_lastError = describe(prepared);
+            return toStatus(prepared);
+        }
+        if (!mid) {
+            hookInfo.originalFunction = patch.trampoline;
+        }
+    }
     
-    s_hooks.push_back(hookInfo);
+    HookHandle handle = registry().insert(hookInfo);
+    if (handle == HookHandle::INVALID) {
+        InlinePatcher::release(patch);
+        s_lastError = "Cannot register a hook for this address";
+        return MHStatus::MH_ERROR_NOT_EXECUTABLE;
+    }
+    if (s_engine == HookEngine::INLINE) {
+        patches()[static_cast<uint64_t>(handle)] = patch;
+    }
     
     if (original) {
-        *original = reinterpret_cast<void*>(hookInfo.originalFunction);
+        *original = hookInfo.originalFunction;
     }
     
-    s_lastError = "Hook created successfully (mock)";
+    s_lastError = s_engine == HookEngine::INLINE ? "Hook created successfully" : "Hook created successfully (mock)";
     return MHStatus::MH_OK;
 }
 
@@ -78,101 +309,275 @@ MHStatus MinHookWrapper::createHook(uintptr_t target, uintptr_t hook, uintptr_t*
 }
 
 MHStatus MinHookWrapper::enableHook(void* target) {
+    return enableHook(findHook(reinterpret_cast<uintptr_t>(target)));
+}
+
+MHStatus MinHookWrapper::enableHook(HookHandle handle) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return setEnabledLocked(handle, true);
+}
+
+MHStatus MinHookWrapper::disableHook(void* target) {
+    return disableHook(findHook(reinterpret_cast<uintptr_t>(target)));
+}
+
+MHStatus MinHookWrapper::disableHook(HookHandle handle) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return setEnabledLocked(handle, false);
+}
+
+MHStatus MinHookWrapper::setEnabledLocked(HookHandle handle, bool enable) {
     if (!s_initialized) {
         s_lastError = "MinHook not initialized";
         return MHStatus::MH_ERROR_NOT_INITIALIZED;
     }
     
-    uintptr_t targetAddr = reinterpret_cast<uintptr_t>(target);
-    
-    auto it = std::find_if(s_hooks.begin(), s_hooks.end(),
-        [targetAddr](const HookInfo& h) { return h.targetAddress == targetAddr; });
-    
-    if (it == s_hooks.end()) {
+    if (registry().getTarget(handle) == 0) {
         s_lastError = "Hook not found";
         return MHStatus::MH_ERROR_NOT_CREATED;
     }
     
-    if (it->enabled) {
-        s_lastError = "Hook already enabled";
-        return MHStatus::MH_ERROR_ENABLED;
+    if (registry().isEnabled(handle) == enable) {
+        s_lastError = enable ? "Hook already enabled" : "Hook already disabled";
+        return enable ? MHStatus::MH_ERROR_ENABLED : MHStatus::MH_ERROR_DISABLED;
+    }
+    
+    auto patch = patches().find(static_cast<uint64_t>(handle));
+    PatchStatus written = PatchStatus::OK;
+    bool patched = patch != patches().end() ? (written = InlinePatcher::write(patch->second, enable), true)
+                                            : writePointerPatch(handle, enable, written);
+    if (patched) {
+        if (written != PatchStatus::OK) {
+            s_lastError = describe(written);
+            return toStatus(written);
+        }
+        registry().setEnabled(handle, enable);
+        s_lastError = enable ? "Hook enabled successfully" : "Hook disabled successfully";
+        return MHStatus::MH_OK;
     }
     
-    it->enabled = true;
-    s_lastError = "Hook enabled successfully (mock)";
+    registry().setEnabled(handle, enable);
+    s_lastError = enable ? "Hook enabled successfully (mock)" : "Hook disabled successfully (mock)";
     return MHStatus::MH_OK;
 }
 
-MHStatus MinHookWrapper::disableHook(void* target) {
+MHStatus MinHookWrapper::removeHook(void* target) {
+    return removeHook(findHook(reinterpret_cast<uintptr_t>(target)));
+}
+
+MHStatus MinHookWrapper::removeHook(HookHandle handle) {
+    std::lock_guard<std::mutex> lock(s_mutex);
     if (!s_initialized) {
         s_lastError = "MinHook not initialized";
         return MHStatus::MH_ERROR_NOT_INITIALIZED;
     }
     
-    uintptr_t targetAddr = reinterpret_cast<uintptr_t>(target);
-    
-    auto it = std::find_if(s_hooks.begin(), s_hooks.end(),
-        [targetAddr](const HookInfo& h) { return h.targetAddress == targetAddr; });
-    
-    if (it == s_hooks.end()) {
+    if (registry().getTarget(handle) == 0) {
         s_lastError = "Hook not found";
         return MHStatus::MH_ERROR_NOT_CREATED;
     }
     
-    if (!it->enabled) {
-        s_lastError = "Hook already disabled";
-        return MHStatus::MH_ERROR_DISABLED;
+    if (registry().isEnabled(handle)) {
+        MHStatus status = setEnabledLocked(handle, false);
+        if (status != MHStatus::MH_OK) {
+            return status;  // the jump is still live, so its trampoline must stay
+        }
     }
     
-    it->enabled = false;
-    s_lastError = "Hook disabled successfully (mock)";
+    auto patch = patches().find(static_cast<uint64_t>(handle));
+    if (patch != patches().end()) {
+        InlinePatcher::release(patch->second);
+        patches().erase(patch);
+    }
+    auto slotPatch = vtablePatches().find(static_cast<uint64_t>(handle));
+    if (slotPatch != vtablePatches().end()) {
+        VTablePatcher::release(slotPatch->second);
+        vtablePatches().erase(slotPatch);
+    }
+    importPatches().erase(static_cast<uint64_t>(handle));
+    registry().erase(handle);
+    s_lastError = "Hook removed successfully";
     return MHStatus::MH_OK;
 }
 
-MHStatus MinHookWrapper::removeHook(void* target) {
+MHStatus MinHookWrapper::queueEnable(void* target) {
+    return queueChange(findHook(reinterpret_cast<uintptr_t>(target)), true);
+}
+
+MHStatus MinHookWrapper::queueEnable(HookHandle handle) {
+    return queueChange(handle, true);
+}
+
+MHStatus MinHookWrapper::queueDisable(void* target) {
+    return queueChange(findHook(reinterpret_cast<uintptr_t>(target)), false);
+}
+
+MHStatus MinHookWrapper::queueDisable(HookHandle handle) {
+    return queueChange(handle, false);
+}
+
+MHStatus MinHookWrapper::queueChange(HookHandle handle, bool enable) {
+    std::lock_guard<std::mutex> lock(s_mutex);
     if (!s_initialized) {
         s_lastError = "MinHook not initialized";
         return MHStatus::MH_ERROR_NOT_INITIALIZED;
     }
     
-    uintptr_t targetAddr = reinterpret_cast<uintptr_t>(target);
-    
-    auto it = std::find_if(s_hooks.begin(), s_hooks.end(),
-        [targetAddr](const HookInfo& h) { return h.targetAddress == targetAddr; });
-    
-    if (it == s_hooks.end()) {
+    uintptr_t target = registry().getTarget(handle);
+    if (target == 0) {
         s_lastError = "Hook not found";
         return MHStatus::MH_ERROR_NOT_CREATED;
     }
     
-    if (it->enabled) {
-        disableHook(target);
+    queue().push_back(QueuedHookChange{handle, target, enable, MHStatus::MH_OK});
+    s_lastError = "Hook change queued";
+    return MHStatus::MH_OK;
+}
+
+MHStatus MinHookWrapper::applyQueued(std::vector<QueuedHookChange>* results) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (!s_initialized) {
+        s_lastError = "MinHook not initialized";
+        return MHStatus::MH_ERROR_NOT_INITIALIZED;
     }
     
-    s_hooks.erase(it);
-    s_lastError = "Hook removed successfully";
-    return MHStatus::MH_OK;
+    // Keep only the last change of each hook, in queue order
+    std::vector<QueuedHookChange> changes;
+    std::unordered_set<uint64_t> seen;
+    std::vector<QueuedHookChange>& pending = queue();
+    for (auto it = pending.rbegin(); it != pending.rend(); ++it) {
+        if (seen.insert(static_cast<uint64_t>(it->handle)).second) {
+            changes.push_back(*it);
+        }
+    }
+    std::reverse(changes.begin(), changes.end());
+    pending.clear();
+    
+    // Validate everything before touching any target
+    MHStatus result = MHStatus::MH_OK;
+    std::vector<QueuedHookChange*> toApply;
+    for (auto& change : changes) {
+        if (registry().getTarget(change.handle) == 0) {
+            change.status = MHStatus::MH_ERROR_NOT_CREATED;
+            if (result == MHStatus::MH_OK) {
+                result = change.status;
+            }
+        } else if (registry().isEnabled(change.handle) != change.enable) {
+            toApply.push_back(&change);
+        }
+    }
+    
+    // Patch window: every jump is written (or prologue restored) with one
+    // protection change per page and one instruction cache flush
+    std::vector<std::pair<InlinePatch*, bool>> batch;
+    for (const QueuedHookChange* change : toApply) {
+        auto patch = patches().find(static_cast<uint64_t>(change->handle));
+        if (patch != patches().end()) {
+            batch.emplace_back(&patch->second, change->enable);
+        }
+    }
+    
+    // writeBatch() stores all of its jumps or none; pointer patches are then
+    // written one by one and only the ones that fail are reported
+    PatchStatus batchWritten = InlinePatcher::writeBatch(batch);
+    PatchStatus firstFailure = batchWritten;
+    for (QueuedHookChange* change : toApply) {
+        PatchStatus status = PatchStatus::OK;
+        if (patches().count(static_cast<uint64_t>(change->handle))) {
+            status = batchWritten;
+        } else if (batchWritten != PatchStatus::OK) {
+            status = batchWritten;      // not attempted: the window failed
+        } else if (writePointerPatch(change->handle, change->enable, status) && status != PatchStatus::OK &&
+                   firstFailure == PatchStatus::OK) {
+            // Vtable and GOT entries are single pointer stores and need no flush
+            firstFailure = status;
+        }
+        if (status == PatchStatus::OK) {
+            registry().setEnabled(change->handle, change->enable);
+        } else {
+            change->status = toStatus(status);
+            if (result == MHStatus::MH_OK) {
+                result = change->status;
+            }
+        }
+    }
+    
+    if (results) {
+        *results = std::move(changes);
+    }
+    
+    std::ostringstream oss;
+    oss << "Applied " << toApply.size() << " queued hook change(s) in one window";
+    if (s_engine == HookEngine::MOCK) {
+        oss << " (mock)";
+    }
+    if (firstFailure != PatchStatus::OK) {
+        s_lastError = describe(firstFailure);
+    } else {
+        s_lastError = result == MHStatus::MH_OK ? oss.str() : "Queued hook not found";
+    }
+    return result;
+}
+
+bool MinHookWrapper::writePointerPatch(HookHandle handle, bool enable, PatchStatus& status) {
+    auto slotPatch = vtablePatches().find(static_cast<uint64_t>(handle));
+    if (slotPatch != vtablePatches().end()) {
+        status = VTablePatcher::write(slotPatch->second, enable);
+        return true;
+    }
+    auto importPatch = importPatches().find(static_cast<uint64_t>(handle));
+    if (importPatch != importPatches().end()) {
+        status = ImportPatcher::write(importPatch->second, enable);
+        return true;
+    }
+    return false;
+}
+
+HookHandle MinHookWrapper::findHook(uintptr_t target) {
+    return registry().find(target);
+}
+
+bool MinHookWrapper::isHookEnabled(HookHandle handle) {
+    return registry().isEnabled(handle);
 }
 
 bool MinHookWrapper::isInitialized() {
     return s_initialized;
 }
 
+HookEngine MinHookWrapper::getEngine() {
+    return s_engine;
+}
+
 std::string MinHookWrapper::getLastError() {
     return s_lastError;
 }
 
 uintptr_t MinHookWrapper::createTrampoline(uintptr_t target, size_t stolenBytes) {
-    // Mock implementation - just return the target address
-    // In real MinHook, this would allocate executable memory and create a trampoline
-    return target;
+    // createHook() builds the trampoline; the decoder picks the stolen bytes
+    (void)stolenBytes;
+    uintptr_t original = registry().getOriginal(registry().find(target));
+    return original ? original : target;
 }
 
 // FunctionHook implementation
 FunctionHook::FunctionHook(const std::string& name, uintptr_t targetAddress, 
                          uintptr_t hookFunction, HookType type)
     : m_name(name), m_targetAddress(targetAddress), m_hookFunction(hookFunction),
-      m_originalFunction(0), m_type(type), m_installed(false), m_enabled(false) {}
+      m_originalFunction(0), m_type(type), m_slot(0), m_scope(VTableScope::INSTANCE),
+      m_handle(HookHandle::INVALID), m_installed(false) {}
+
+FunctionHook::FunctionHook(const std::string& name, const std::string& module, const std::string& symbol,
+                           uintptr_t hookFunction)
+    : m_name(name), m_targetAddress(0), m_hookFunction(hookFunction), m_originalFunction(0),
+      m_type(HookType::HOOK_IMPORT), m_slot(0), m_scope(VTableScope::INSTANCE), m_module(module),
+      m_symbol(symbol), m_handle(HookHandle::INVALID), m_installed(false) {}
+
+FunctionHook::FunctionHook(const std::string& name, void* object, size_t slot,
+                           uintptr_t hookFunction, VTableScope scope)
+    : m_name(name), m_targetAddress(reinterpret_cast<uintptr_t>(object)), m_hookFunction(hookFunction),
+      m_originalFunction(0), m_type(HookType::HOOK_VTABLE), m_slot(slot), m_scope(scope),
+      m_handle(HookHandle::INVALID), m_installed(false) {}
 
 FunctionHook::~FunctionHook() {
     if (m_installed) {
@@ -185,8 +590,31 @@ bool FunctionHook::install() {
         return true;
     }
     
-    MHStatus status = MinHookWrapper::createHook(m_targetAddress, m_hookFunction, &m_originalFunction);
+    if (m_type == HookType::HOOK_IMPORT) {
+        void* original = nullptr;
+        MHStatus status = MinHookWrapper::createImportHook(m_module, m_symbol, reinterpret_cast<void*>(m_hookFunction),
+                                                           &original, &m_handle);
+        m_originalFunction = reinterpret_cast<uintptr_t>(original);
+        m_installed = status == MHStatus::MH_OK;
+        return m_installed;
+    }
+    
+    if (m_type == HookType::HOOK_VTABLE) {
+        void* original = nullptr;
+        MHStatus status = MinHookWrapper::createVTableHook(reinterpret_cast<void*>(m_targetAddress), m_slot,
+                                                           reinterpret_cast<void*>(m_hookFunction), &original,
+                                                           m_scope, &m_handle);
+        m_originalFunction = reinterpret_cast<uintptr_t>(original);
+        m_installed = status == MHStatus::MH_OK;
+        return m_installed;
+    }
+    
+    MHStatus status = m_type == HookType::HOOK_MID
+        ? MinHookWrapper::createMidHook(reinterpret_cast<void*>(m_targetAddress),
+                                        reinterpret_cast<MidHookHandler>(m_hookFunction))
+        : MinHookWrapper::createHook(m_targetAddress, m_hookFunction, &m_originalFunction);
     if (status == MHStatus::MH_OK) {
+        m_handle = MinHookWrapper::findHook(m_targetAddress);
         m_installed = true;
         return true;
     }
@@ -199,14 +627,15 @@ bool FunctionHook::remove() {
         return true;
     }
     
-    if (m_enabled) {
+    if (isEnabled()) {
         disable();
     }
     
-    MHStatus status = MinHookWrapper::removeHook(reinterpret_cast<void*>(m_targetAddress));
+    MHStatus status = MinHookWrapper::removeHook(m_handle);
     if (status == MHStatus::MH_OK) {
         m_installed = false;
         m_originalFunction = 0;
+        m_handle = HookHandle::INVALID;
         return true;
     }
     
@@ -218,13 +647,13 @@ bool FunctionHook::enable() {
         return false;
     }
     
-    if (m_enabled) {
+    if (isEnabled()) {
         return true;
     }
     
-    MHStatus status = MinHookWrapper::enableHook(reinterpret_cast<void*>(m_targetAddress));
-    if (status == MHStatus::MH_OK) {
-        m_enabled = true;
+    // Another thread may have enabled it since the check
+    MHStatus status = MinHookWrapper::enableHook(m_handle);
+    if (status == MHStatus::MH_OK || status == MHStatus::MH_ERROR_ENABLED) {
         return true;
     }
     
@@ -232,17 +661,24 @@ bool FunctionHook::enable() {
 }
 
 bool FunctionHook::disable() {
-    if (!m_installed || !m_enabled) {
+    if (!m_installed || !isEnabled()) {
         return true;
     }
     
-    MHStatus status = MinHookWrapper::disableHook(reinterpret_cast<void*>(m_targetAddress));
-    if (status == MHStatus::MH_OK) {
-        m_enabled = false;
+    MHStatus status = MinHookWrapper::disableHook(m_handle);
+    if (status == MHStatus::MH_OK || status == MHStatus::MH_ERROR_DISABLED) {
         return true;
     }
     
     return false;
 }
 
+bool FunctionHook::queueEnable() {
+    return m_installed && MinHookWrapper::queueEnable(m_handle) == MHStatus::MH_OK;
+}
+
+bool FunctionHook::queueDisable() {
+    return m_installed && MinHookWrapper::queueDisable(m_handle) == MHStatus::MH_OK;
+}
+
 } // namespace hooks
\ No newline at end of file
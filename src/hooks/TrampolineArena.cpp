@@ -0,0 +1,314 @@
+#include "hooks/TrampolineArena.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hooks {
+
+namespace {
+
+constexpr size_t MIN_SLOT = 16;
+constexpr uintptr_t LOWEST_MAPPING = 0x10000;
+constexpr uintptr_t HIGHEST_MAPPING = 0x7FFFFFFFF000ull;
+
+/**
+ * @brief Reach of a rel32 operand, less a margin for the instruction itself
+ */
+constexpr uintptr_t NEAR_RANGE = 0x7FFFFF00ull;
+
+uintptr_t distance(uintptr_t a, uintptr_t b) {
+    return a > b ? a - b : b - a;
+}
+
+size_t classOf(size_t size) {
+    size_t sizeClass = 0;
+    for (size_t slot = MIN_SLOT; slot < size; slot *= 2) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+size_t slotSize(size_t sizeClass) {
+    return MIN_SLOT << sizeClass;
+}
+
+#if defined(__linux__)
+uintptr_t pageSize() {
+    static const uintptr_t size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+#endif
+
+} // anonymous namespace
+
+#if defined(__linux__)
+
+std::vector<SelfMapping> readSelfMappings() {
+    std::vector<SelfMapping> mappings;
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    
+    while (std::getline(maps, line)) {
+        unsigned long long start = 0, end = 0;
+        char perms[5] = {};
+        if (std::sscanf(line.c_str(), "%llx-%llx %4s", &start, &end, perms) < 3) {
+            continue;
+        }
+        
+        int protection = PROT_NONE;
+        if (perms[0] == 'r') protection |= PROT_READ;
+        if (perms[1] == 'w') protection |= PROT_WRITE;
+        if (perms[2] == 'x') protection |= PROT_EXEC;
+        mappings.push_back(SelfMapping{static_cast<uintptr_t>(start), static_cast<uintptr_t>(end), protection});
+    }
+    
+    return mappings;
+}
+
+#else
+
+std::vector<SelfMapping> readSelfMappings() {
+    return {};
+}
+
+#endif
+
+TrampolineArena::TrampolineArena() = default;
+
+TrampolineArena::~TrampolineArena() {
+#if defined(__linux__)
+    for (const auto& region : m_regions) {
+        munmap(reinterpret_cast<void*>(region->base), REGION_SIZE);
+    }
+#endif
+}
+
+bool TrampolineArena::isNear(uintptr_t from, uintptr_t to) {
+    return distance(from, to) < NEAR_RANGE;
+}
+
+uintptr_t TrampolineArena::allocate(uintptr_t target, size_t size) {
+    if (size == 0 || size > MAX_SLOT) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t sizeClass = classOf(size);
+    
+    // Regions wholly within reach of the target, those with a free slot first
+    std::vector<Region*> near;
+    for (const auto& region : m_regions) {
+        if (isNear(region->base, target) && isNear(region->base + REGION_SIZE, target)) {
+            near.push_back(region.get());
+        }
+    }
+    std::stable_partition(near.begin(), near.end(), [sizeClass](const Region* region) {
+        return !region->freeSlots[sizeClass].empty();
+    });
+    
+    for (Region* region : near) {
+        uintptr_t slot = takeSlot(*region, sizeClass);
+        if (slot) {
+            return slot;
+        }
+    }
+    
+    Region* region = reserveNear(target);
+    uintptr_t slot = region ? takeSlot(*region, sizeClass) : 0;
+    if (slot) {
+        return slot;
+    }
+    
+    // Nothing near: any region will do for a caller that can use absolute jumps
+    for (const auto& other : m_regions) {
+        slot = takeSlot(*other, sizeClass);
+        if (slot) {
+            return slot;
+        }
+    }
+    region = reserveAnywhere();
+    return region ? takeSlot(*region, sizeClass) : 0;
+}
+
+uintptr_t TrampolineArena::takeSlot(Region& region, size_t sizeClass) {
+#if defined(__linux__)
+    std::vector<uintptr_t>& freeSlots = region.freeSlots[sizeClass];
+    if (freeSlots.empty()) {
+        if (region.committedPages == region.pageClasses.size()) {
+            return 0;
+        }
+        
+        uintptr_t page = region.base + region.committedPages * pageSize();
+        if (mprotect(reinterpret_cast<void*>(page), pageSize(), PROT_READ | PROT_EXEC) != 0) {
+            return 0;
+        }
+        region.pageClasses[region.committedPages++] = static_cast<uint8_t>(sizeClass);
+        
+        // Carve the page so that the lowest slot is handed out first
+        for (uintptr_t slot = page + pageSize() - slotSize(sizeClass); slot >= page; slot -= slotSize(sizeClass)) {
+            freeSlots.push_back(slot);
+            if (slot == page) {
+                break;
+            }
+        }
+    }
+    
+    uintptr_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    ++m_slotsInUse;
+    return slot;
+#else
+    (void)region;
+    (void)sizeClass;
+    return 0;
+#endif
+}
+
+TrampolineArena::Region* TrampolineArena::reserveNear(uintptr_t target) {
+#if defined(__linux__)
+    uintptr_t low = target > LOWEST_MAPPING + NEAR_RANGE ? target - NEAR_RANGE : LOWEST_MAPPING;
+    uintptr_t high = std::min(target + NEAR_RANGE, HIGHEST_MAPPING);
+    
+    // Nearest end of every free gap that can hold a region
+    std::vector<uintptr_t> candidates;
+    uintptr_t gapStart = LOWEST_MAPPING;
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    mappings.push_back(SelfMapping{HIGHEST_MAPPING, HIGHEST_MAPPING, PROT_NONE});
+    for (const auto& mapping : mappings) {
+        uintptr_t start = std::max(gapStart, low);
+        uintptr_t end = std::min(mapping.start, high);
+        if (end > start && end - start >= REGION_SIZE) {
+            candidates.push_back(end <= target ? end - REGION_SIZE : start);
+        }
+        gapStart = std::max(gapStart, mapping.end);
+    }
+    std::sort(candidates.begin(), candidates.end(), [target](uintptr_t a, uintptr_t b) {
+        return distance(a, target) < distance(b, target);
+    });
+    
+    // Reserve without committing: pages become read/execute as they are used
+    void* base = MAP_FAILED;
+    for (uintptr_t hint : candidates) {
+        base = mmap(reinterpret_cast<void*>(hint), REGION_SIZE, PROT_NONE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED) {
+            continue;
+        }
+        uintptr_t address = reinterpret_cast<uintptr_t>(base);
+        if (isNear(address, target) && isNear(address + REGION_SIZE, target)) {
+            break;
+        }
+        munmap(base, REGION_SIZE);
+        base = MAP_FAILED;
+    }
+    return base == MAP_FAILED ? nullptr : addRegion(base);
+#else
+    (void)target;
+    return nullptr;
+#endif
+}
+
+TrampolineArena::Region* TrampolineArena::reserveAnywhere() {
+#if defined(__linux__)
+    void* base = mmap(nullptr, REGION_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return base == MAP_FAILED ? nullptr : addRegion(base);
+#else
+    return nullptr;
+#endif
+}
+
+TrampolineArena::Region* TrampolineArena::addRegion(void* base) {
+    auto region = std::make_unique<Region>();
+    region->base = reinterpret_cast<uintptr_t>(base);
+#if defined(__linux__)
+    region->pageClasses.assign(REGION_SIZE / pageSize(), UNCOMMITTED);
+#endif
+    m_regions.push_back(std::move(region));
+    return m_regions.back().get();
+}
+
+TrampolineArena::Region* TrampolineArena::regionOf(uintptr_t address) const {
+    for (const auto& region : m_regions) {
+        if (address >= region->base && address < region->base + REGION_SIZE) {
+            return region.get();
+        }
+    }
+    return nullptr;
+}
+
+void TrampolineArena::release(uintptr_t slot) {
+#if defined(__linux__)
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Region* region = regionOf(slot);
+    if (!region) {
+        return;
+    }
+    
+    size_t page = (slot - region->base) / pageSize();
+    uint8_t sizeClass = region->pageClasses[page];
+    if (sizeClass == UNCOMMITTED || (slot - region->base) % slotSize(sizeClass) != 0) {
+        return;
+    }
+    
+    // A stale call into a released slot traps instead of running old code
+    uintptr_t pageStart = region->base + page * pageSize();
+    if (mprotect(reinterpret_cast<void*>(pageStart), pageSize(), PROT_READ | PROT_WRITE | PROT_EXEC) == 0) {
+        std::memset(reinterpret_cast<void*>(slot), 0xCC, slotSize(sizeClass));
+        mprotect(reinterpret_cast<void*>(pageStart), pageSize(), PROT_READ | PROT_EXEC);
+    }
+    region->freeSlots[sizeClass].push_back(slot);
+    --m_slotsInUse;
+#else
+    (void)slot;
+#endif
+}
+
+bool TrampolineArena::write(uintptr_t slot, const void* bytes, size_t size) {
+#if defined(__linux__)
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Region* region = regionOf(slot);
+    if (!region || slot + size > region->base + region->committedPages * pageSize()) {
+        return false;
+    }
+    
+    // Keep execute access: other slots on these pages may be running
+    uintptr_t first = slot & ~(pageSize() - 1);
+    size_t length = ((slot + size + pageSize() - 1) & ~(pageSize() - 1)) - first;
+    if (mprotect(reinterpret_cast<void*>(first), length, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+        return false;
+    }
+    std::memcpy(reinterpret_cast<void*>(slot), bytes, size);
+    mprotect(reinterpret_cast<void*>(first), length, PROT_READ | PROT_EXEC);
+    
+    __builtin___clear_cache(reinterpret_cast<char*>(slot), reinterpret_cast<char*>(slot + size));
+    return true;
+#else
+    (void)slot;
+    (void)bytes;
+    (void)size;
+    return false;
+#endif
+}
+
+ArenaStats TrampolineArena::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ArenaStats stats;
+    stats.regions = m_regions.size();
+    stats.slotsInUse = m_slotsInUse;
+    for (const auto& region : m_regions) {
+        stats.pages += region->committedPages;
+        for (const auto& freeSlots : region->freeSlots) {
+            stats.freeSlots += freeSlots.size();
+        }
+    }
+    return stats;
+}
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "hooks/VTablePatcher.h"
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <cxxabi.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace hooks {
+
+#if defined(__linux__)
+
+namespace {
+
+constexpr size_t PREFIX_ENTRIES = 2;    // offset-to-top and type_info, in front of the address point
+
+/**
+ * @brief A copy of a class vtable owned by one hooked object
+ */
+struct Shadow {
+    std::unique_ptr<uintptr_t[]> entries;   ///< PREFIX_ENTRIES, then the slots
+    uintptr_t vtable;                       ///< The class vtable it copies
+    size_t users;                           ///< Patches sharing it
+    std::vector<bool> hooked;               ///< Slots an INSTANCE hook has enabled; CLASS hooks skip them
+    
+    uintptr_t addressPoint() const { return reinterpret_cast<uintptr_t>(entries.get() + PREFIX_ENTRIES); }
+};
+
+/**
+ * @brief Shadows by object, and released ones by the vtable they copied
+ *
+ * A thread may have loaded an object's shadow pointer just before its last
+ * hook was released and still be reading the copy, so released copies are
+ * never freed. They are reused for the next shadow of the same vtable: the
+ * copy is refilled from the class vtable, so a late reader still finds one
+ * of that class's functions or a detour of it. Retired memory is bounded by
+ * the most objects of one class hooked at once.
+ */
+struct ShadowTable {
+    std::mutex mutex;
+    std::unordered_map<uintptr_t, Shadow> byObject;
+    std::unordered_map<uintptr_t, std::vector<std::unique_ptr<uintptr_t[]>>> retired;
+};
+
+ShadowTable& shadows() {
+    // Never destroyed: objects may still point into it at exit
+    static ShadowTable* table = new ShadowTable();
+    return *table;
+}
+
+const SelfMapping* findMapping(const std::vector<SelfMapping>& mappings, uintptr_t address) {
+    for (const auto& mapping : mappings) {
+        if (address >= mapping.start && address < mapping.end) {
+            return &mapping;
+        }
+    }
+    return nullptr;
+}
+
+bool isReadable(const std::vector<SelfMapping>& mappings, uintptr_t address, size_t size) {
+    const SelfMapping* mapping = findMapping(mappings, address);
+    return mapping && (mapping->protection & PROT_READ) && address + size <= mapping->end;
+}
+
+/**
+ * @brief Check a class's RTTI for a virtual base anywhere in its hierarchy
+ *
+ * Such vtables have vbase and vcall offsets in front of offset-to-top that a
+ * shadow does not copy. Without RTTI (a null type_info entry) nothing is found.
+ */
+bool hasVirtualBase(const std::type_info* type) {
+    if (auto multiple = dynamic_cast<const abi::__vmi_class_type_info*>(type)) {
+        for (unsigned i = 0; i < multiple->__base_count; ++i) {
+            const abi::__base_class_type_info& base = multiple->__base_info[i];
+            if ((base.__offset_flags & abi::__base_class_type_info::__virtual_mask) ||
+                hasVirtualBase(base.__base_type)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (auto single = dynamic_cast<const abi::__si_class_type_info*>(type)) {
+        return hasVirtualBase(single->__base_type);
+    }
+    return false;
+}
+
+size_t slotsOf(const std::vector<SelfMapping>& mappings, uintptr_t vtable) {
+    if (vtable % sizeof(uintptr_t) != 0 ||
+        !isReadable(mappings, vtable - PREFIX_ENTRIES * sizeof(uintptr_t), PREFIX_ENTRIES * sizeof(uintptr_t))) {
+        return 0;
+    }
+    
+    size_t slots = 0;
+    while (slots < VTablePatcher::MAX_SLOTS &&
+           isReadable(mappings, vtable + slots * sizeof(uintptr_t), sizeof(uintptr_t))) {
+        uintptr_t entry = reinterpret_cast<const uintptr_t*>(vtable)[slots];
+        const SelfMapping* code = findMapping(mappings, entry);
+        if (!code || !(code->protection & PROT_EXEC)) {
+            break;
+        }
+        ++slots;
+    }
+    return slots;
+}
+
+} // anonymous namespace
+
+bool VTablePatcher::isSupported() {
+    return true;
+}
+
+size_t VTablePatcher::countSlots(uintptr_t vtable) {
+    return slotsOf(readSelfMappings(), vtable);
+}
+
+PatchStatus VTablePatcher::prepare(void* object, size_t slot, uintptr_t hook, VTableScope scope,
+                                   VTablePatch& patch) {
+    patch = VTablePatch();
+    uintptr_t objectAddress = reinterpret_cast<uintptr_t>(object);
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    const SelfMapping* hookCode = findMapping(mappings, hook);
+    if (!hookCode || !(hookCode->protection & PROT_EXEC)) {
+        return PatchStatus::NOT_EXECUTABLE;
+    }
+    if (objectAddress % sizeof(uintptr_t) != 0 || !isReadable(mappings, objectAddress, sizeof(uintptr_t))) {
+        return PatchStatus::BAD_VTABLE;
+    }
+    
+    ShadowTable& table = shadows();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    uintptr_t* vptr = static_cast<uintptr_t*>(object);
+    uintptr_t current = __atomic_load_n(vptr, __ATOMIC_ACQUIRE);
+    auto shadow = table.byObject.find(objectAddress);
+    if (shadow != table.byObject.end() && shadow->second.addressPoint() != current) {
+        return PatchStatus::BAD_VTABLE;     // reconstructed since it was hooked
+    }
+    
+    uintptr_t vtable = shadow != table.byObject.end() ? shadow->second.vtable : current;
+    size_t slots = slotsOf(mappings, vtable);
+    if (slot >= slots) {
+        return PatchStatus::BAD_VTABLE;
+    }
+    
+    patch.object = objectAddress;
+    patch.slot = slot;
+    patch.scope = scope;
+    patch.vtable = vtable;
+    patch.original = reinterpret_cast<const uintptr_t*>(vtable)[slot];
+    patch.hook = hook;
+    
+    if (scope == VTableScope::CLASS) {
+        patch.slotAddress = vtable + slot * sizeof(uintptr_t);
+        return PatchStatus::OK;
+    }
+    
+    if (shadow == table.byObject.end()) {
+        const auto* typeInfo = reinterpret_cast<const std::type_info*>(reinterpret_cast<const uintptr_t*>(vtable)[-1]);
+        if (typeInfo && hasVirtualBase(typeInfo)) {
+            patch = VTablePatch();
+            return PatchStatus::VIRTUAL_BASES;
+        }
+        
+        // Copied under the lock, so it includes every CLASS hook enabled so far
+        Shadow copy;
+        auto& spare = table.retired[vtable];
+        if (spare.empty()) {
+            copy.entries.reset(new uintptr_t[PREFIX_ENTRIES + slots]);
+        } else {
+            copy.entries = std::move(spare.back());
+            spare.pop_back();
+        }
+        std::memcpy(copy.entries.get(), reinterpret_cast<const void*>(vtable - PREFIX_ENTRIES * sizeof(uintptr_t)),
+                    (PREFIX_ENTRIES + slots) * sizeof(uintptr_t));
+        copy.vtable = vtable;
+        copy.users = 0;
+        copy.hooked.assign(slots, false);
+        shadow = table.byObject.emplace(objectAddress, std::move(copy)).first;
+        __atomic_store_n(vptr, shadow->second.addressPoint(), __ATOMIC_RELEASE);
+    }
+    ++shadow->second.users;
+    patch.slotAddress = shadow->second.addressPoint() + slot * sizeof(uintptr_t);
+    return PatchStatus::OK;
+}
+
+PatchStatus VTablePatcher::write(VTablePatch& patch, bool enable) {
+    if (!patch.slotAddress) {
+        return PatchStatus::BAD_VTABLE;
+    }
+    if (patch.applied == enable) {
+        return PatchStatus::OK;
+    }
+    
+    ShadowTable& table = shadows();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    uintptr_t* entry = reinterpret_cast<uintptr_t*>(patch.slotAddress);
+    if (patch.scope == VTableScope::INSTANCE) {
+        // Disabling falls back to the class vtable, which a CLASS hook may have changed since
+        uintptr_t value = enable ? patch.hook : reinterpret_cast<const uintptr_t*>(patch.vtable)[patch.slot];
+        __atomic_store_n(entry, value, __ATOMIC_SEQ_CST);
+        auto shadow = table.byObject.find(patch.object);
+        if (shadow != table.byObject.end()) {
+            shadow->second.hooked[patch.slot] = enable;
+        }
+        patch.applied = enable;
+        return PatchStatus::OK;
+    }
+    
+    // The class vtable sits in a read-only page (.data.rel.ro)
+    std::vector<SelfMapping> mappings = readSelfMappings();
+    const SelfMapping* mapping = findMapping(mappings, patch.slotAddress);
+    if (!mapping) {
+        return PatchStatus::MEMORY_PROTECT;
+    }
+    uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    void* page = reinterpret_cast<void*>(patch.slotAddress & ~(pageSize - 1));
+    bool writable = mapping->protection & PROT_WRITE;
+    if (!writable && mprotect(page, pageSize, mapping->protection | PROT_WRITE) != 0) {
+        return PatchStatus::MEMORY_PROTECT;
+    }
+    uintptr_t value = enable ? patch.hook : patch.original;
+    __atomic_store_n(entry, value, __ATOMIC_SEQ_CST);
+    if (!writable) {
+        mprotect(page, pageSize, mapping->protection);
+    }
+    
+    // Shadows of this vtable follow it, except in slots they hook themselves
+    for (auto& object : table.byObject) {
+        Shadow& shadow = object.second;
+        if (shadow.vtable == patch.vtable && patch.slot < shadow.hooked.size() && !shadow.hooked[patch.slot]) {
+            __atomic_store_n(reinterpret_cast<uintptr_t*>(shadow.addressPoint()) + patch.slot, value,
+                             __ATOMIC_SEQ_CST);
+        }
+    }
+    patch.applied = enable;
+    return PatchStatus::OK;
+}
+
+void VTablePatcher::release(VTablePatch& patch) {
+    if (!patch.slotAddress || patch.applied) {
+        return;
+    }
+    
+    if (patch.scope == VTableScope::INSTANCE) {
+        ShadowTable& table = shadows();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        auto shadow = table.byObject.find(patch.object);
+        if (shadow != table.byObject.end() && --shadow->second.users == 0) {
+            // Only if the object still uses the shadow; otherwise it has been rebuilt
+            uintptr_t expected = shadow->second.addressPoint();
+            __atomic_compare_exchange_n(reinterpret_cast<uintptr_t*>(patch.object), &expected,
+                                        shadow->second.vtable, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+            table.retired[shadow->second.vtable].push_back(std::move(shadow->second.entries));
+            table.byObject.erase(shadow);
+        }
+    }
+    patch = VTablePatch();
+}
+
+#else
+
+bool VTablePatcher::isSupported() {
+    return false;
+}
+
+size_t VTablePatcher::countSlots(uintptr_t) {
+    return 0;
+}
+
+PatchStatus VTablePatcher::prepare(void*, size_t, uintptr_t, VTableScope, VTablePatch& patch) {
+    patch = VTablePatch();
+    return PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+PatchStatus VTablePatcher::write(VTablePatch&, bool) {
+    return PatchStatus::UNSUPPORTED_FUNCTION;
+}
+
+void VTablePatcher::release(VTablePatch& patch) {
+    patch = VTablePatch();
+}
+
+#endif
+
+} // namespace hooks
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include "hooks/X86Decoder.h"
+#include <cstring>
+
+namespace hooks {
+
+namespace {
+
+constexpr size_t MAX_INSTRUCTION = 15;
+
+/**
+ * @brief Opcode maps reached through 0F escapes, VEX, EVEX and XOP
+ */
+enum class OpcodeMap {
+    ONE_BYTE,
+    MAP_0F,
+    MAP_0F38,
+    MAP_0F3A,
+    XOP_8,
+    XOP_9,
+    XOP_A,
+    OTHER       ///< EVEX maps 5/6: ModRM, no immediate
+};
+
+bool isInvalidOneByte(uint8_t op) {
+    switch (op) {
+        case 0x06: case 0x07: case 0x0E: case 0x16: case 0x17: case 0x1E: case 0x1F:
+        case 0x27: case 0x2F: case 0x37: case 0x3F: case 0x60: case 0x61: case 0x82:
+        case 0x9A: case 0xCE: case 0xD4: case 0xD5: case 0xD6: case 0xEA:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool oneByteHasModRM(uint8_t op) {
+    if (op < 0x40) {
+        return (op & 0x07) < 0x04;
+    }
+    if (op >= 0x80 && op <= 0x8F) {
+        return true;
+    }
+    if (op >= 0xD0 && op <= 0xD3) {
+        return true;
+    }
+    if (op >= 0xD8 && op <= 0xDF) {
+        return true;
+    }
+    switch (op) {
+        case 0x63: case 0x69: case 0x6B: case 0xC0: case 0xC1: case 0xC6: case 0xC7:
+        case 0xF6: case 0xF7: case 0xFE: case 0xFF:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t oneByteImmediate(uint8_t op, uint8_t reg, bool operand16, bool rexW, bool address32) {
+    size_t immz = operand16 ? 2 : 4;
+    if (op < 0x40) {
+        if ((op & 0x07) == 0x04) {
+            return 1;
+        }
+        return (op & 0x07) == 0x05 ? immz : 0;
+    }
+    if (op >= 0xB0 && op <= 0xB7) {
+        return 1;
+    }
+    if (op >= 0xB8 && op <= 0xBF) {
+        return rexW ? 8 : immz;
+    }
+    if (op >= 0xA0 && op <= 0xA3) {
+        return address32 ? 4 : 8;
+    }
+    if (op >= 0xE4 && op <= 0xE7) {
+        return 1;
+    }
+    switch (op) {
+        case 0x6A: case 0x6B: case 0x80: case 0x83: case 0xA8: case 0xC0: case 0xC1:
+        case 0xC6: case 0xCD:
+            return 1;
+        case 0x68: case 0x69: case 0x81: case 0xA9: case 0xC7:
+            return immz;
+        case 0xC2: case 0xCA:
+            return 2;
+        case 0xC8:
+            return 3;
+        case 0xF6:
+            return reg < 2 ? 1 : 0;
+        case 0xF7:
+            return reg < 2 ? immz : 0;
+        default:
+            return 0;
+    }
+}
+
+bool isInvalid0F(uint8_t op) {
+    switch (op) {
+        case 0x04: case 0x0A: case 0x0C: case 0x24: case 0x25: case 0x26: case 0x27:
+        case 0x36: case 0x39: case 0x3B: case 0x3C: case 0x3D: case 0x3E: case 0x3F:
+        case 0x7A: case 0x7B: case 0xA6: case 0xA7:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool map0FHasModRM(uint8_t op) {
+    if ((op >= 0x30 && op <= 0x37) || (op >= 0x80 && op <= 0x8F) || (op >= 0xC8 && op <= 0xCF)) {
+        return false;
+    }
+    switch (op) {
+        case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: case 0x0B: case 0x0E:
+        case 0x77: case 0xA0: case 0xA1: case 0xA2: case 0xA8: case 0xA9: case 0xAA:
+            return false;
+        default:
+            return true;
+    }
+}
+
+bool map0FHasImm8(uint8_t op) {
+    switch (op) {
+        case 0x0F: case 0x70: case 0x71: case 0x72: case 0x73: case 0xA4: case 0xAC:
+        case 0xBA: case 0xC2: case 0xC4: case 0xC5: case 0xC6:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // anonymous namespace
+
+bool decodeX86(const uint8_t* code, size_t available, X86Instruction& instruction) {
+    instruction = X86Instruction();
+    const size_t limit = available < MAX_INSTRUCTION ? available : MAX_INSTRUCTION;
+    size_t pos = 0;
+    
+    bool operand16 = false;
+    bool address32 = false;
+    bool rexW = false;
+    
+    // Legacy prefixes; a REX prefix only counts directly before the opcode
+    uint8_t op = 0;
+    for (;;) {
+        if (pos >= limit) {
+            return false;
+        }
+        op = code[pos++];
+        if (op == 0x66) {
+            operand16 = true;
+        } else if (op == 0x67) {
+            address32 = true;
+        } else if (op == 0xF0 || op == 0xF2 || op == 0xF3 || op == 0x26 || op == 0x2E ||
+                   op == 0x36 || op == 0x3E || op == 0x64 || op == 0x65) {
+            // Lock, repeat and segment prefixes do not change the length
+        } else if (op >= 0x40 && op <= 0x4F) {
+            rexW = (op & 0x08) != 0;
+            if (pos >= limit) {
+                return false;
+            }
+            uint8_t next = code[pos];
+            bool prefix = next == 0x66 || next == 0x67 || next == 0xF0 || next == 0xF2 || next == 0xF3 ||
+                          next == 0x26 || next == 0x2E || next == 0x36 || next == 0x3E ||
+                          next == 0x64 || next == 0x65 || (next >= 0x40 && next <= 0x4F);
+            if (!prefix) {
+                op = code[pos++];
+                break;
+            }
+            rexW = false;
+        } else {
+            break;
+        }
+    }
+    
+    OpcodeMap map = OpcodeMap::ONE_BYTE;
+    bool hasModRM = false;
+    size_t immediate = 0;
+    
+    if (op == 0xC4 || op == 0xC5 || op == 0x62 ||
+        (op == 0x8F && pos < limit && (code[pos] & 0x1F) >= 8)) {
+        // VEX (C4/C5), EVEX (62) and XOP (8F with map >= 8)
+        size_t payload = op == 0xC5 ? 1 : (op == 0x62 ? 3 : 2);
+        if (pos + payload >= limit) {
+            return false;
+        }
+        
+        uint8_t selector = op == 0xC5 ? 1 : code[pos] & (op == 0x62 ? 0x07 : 0x1F);
+        bool xop = op == 0x8F;
+        pos += payload;
+        op = code[pos++];
+        
+        if (xop) {
+            map = selector == 8 ? OpcodeMap::XOP_8 : (selector == 9 ? OpcodeMap::XOP_9 : OpcodeMap::XOP_A);
+        } else {
+            switch (selector) {
+                case 1: map = OpcodeMap::MAP_0F; break;
+                case 2: map = OpcodeMap::MAP_0F38; break;
+                case 3: map = OpcodeMap::MAP_0F3A; break;
+                case 5: case 6: map = OpcodeMap::OTHER; break;
+                default: return false;
+            }
+        }
+        
+        // VZEROUPPER/VZEROALL are the only VEX instructions without ModRM
+        hasModRM = !(map == OpcodeMap::MAP_0F && op == 0x77);
+        if (map == OpcodeMap::MAP_0F3A || map == OpcodeMap::XOP_8 ||
+            (map == OpcodeMap::MAP_0F && op != 0x0F && map0FHasImm8(op))) {
+            immediate = 1;
+        } else if (map == OpcodeMap::XOP_A) {
+            immediate = 4;
+        }
+    } else if (op == 0x0F) {
+        if (pos >= limit) {
+            return false;
+        }
+        op = code[pos++];
+        if (op == 0x38 || op == 0x3A) {
+            if (pos >= limit) {
+                return false;
+            }
+            map = op == 0x38 ? OpcodeMap::MAP_0F38 : OpcodeMap::MAP_0F3A;
+            hasModRM = true;
+            immediate = op == 0x3A ? 1 : 0;
+            op = code[pos++];
+        } else {
+            if (isInvalid0F(op)) {
+                return false;
+            }
+            map = OpcodeMap::MAP_0F;
+            hasModRM = map0FHasModRM(op);
+            immediate = map0FHasImm8(op) ? 1 : 0;
+            if (op >= 0x80 && op <= 0x8F) {
+                instruction.branch = X86Branch::JCC_REL;
+                instruction.relativeSize = 4;
+            }
+        }
+    } else {
+        if (isInvalidOneByte(op)) {
+            return false;
+        }
+        hasModRM = oneByteHasModRM(op);
+        if ((op >= 0x70 && op <= 0x7F) || op == 0xEB) {
+            instruction.branch = op == 0xEB ? X86Branch::JMP_REL : X86Branch::JCC_REL;
+            instruction.relativeSize = 1;
+        } else if (op >= 0xE0 && op <= 0xE3) {
+            instruction.branch = X86Branch::LOOP_REL;
+            instruction.relativeSize = 1;
+        } else if (op == 0xE8 || op == 0xE9) {
+            instruction.branch = op == 0xE8 ? X86Branch::CALL_REL : X86Branch::JMP_REL;
+            instruction.relativeSize = 4;
+        } else if (op == 0xC2 || op == 0xC3 || op == 0xCA || op == 0xCB) {
+            instruction.branch = X86Branch::RET;
+        }
+    }
+    instruction.opcode = op;
+    
+    uint8_t reg = 0;
+    if (hasModRM) {
+        if (pos >= limit) {
+            return false;
+        }
+        uint8_t modrm = code[pos++];
+        uint8_t mod = modrm >> 6;
+        uint8_t rm = modrm & 0x07;
+        reg = (modrm >> 3) & 0x07;
+        
+        size_t displacement = 0;
+        if (mod != 3) {
+            if (rm == 4) {
+                if (pos >= limit) {
+                    return false;
+                }
+                uint8_t sib = code[pos++];
+                if (mod == 0 && (sib & 0x07) == 5) {
+                    displacement = 4;
+                }
+            } else if (mod == 0 && rm == 5) {
+                instruction.ripRelative = true;
+                instruction.displacementOffset = pos;
+                displacement = 4;
+            }
+            if (mod == 1) {
+                displacement = 1;
+            } else if (mod == 2) {
+                displacement = 4;
+            }
+        }
+        pos += displacement;
+        
+        if (map == OpcodeMap::ONE_BYTE && op == 0xFF && (reg == 4 || reg == 5)) {
+            instruction.branch = X86Branch::JMP_INDIRECT;
+        }
+    }
+    
+    if (map == OpcodeMap::ONE_BYTE) {
+        immediate = oneByteImmediate(op, reg, operand16, rexW, address32);
+    }
+    
+    if (instruction.relativeSize) {
+        instruction.relativeOffset = pos;
+        immediate = instruction.relativeSize;
+    }
+    pos += immediate;
+    if (pos > limit) {
+        return false;
+    }
+    
+    if (instruction.relativeSize == 1) {
+        instruction.relative = static_cast<int8_t>(code[instruction.relativeOffset]);
+    } else if (instruction.relativeSize == 4) {
+        int32_t rel;
+        std::memcpy(&rel, code + instruction.relativeOffset, sizeof(rel));
+        instruction.relative = rel;
+    }
+    
+    instruction.length = pos;
+    return true;
+}
+
+} // namespace hooks
\ No newline at end of file
@@ -1,8 +1,22 @@
 #include "ui/ConsoleUI.h"
+#include "hooks/HookEvents.h"
 #include "scanner/PatternScanner.h"
 #include "memory/MockMemoryProvider.cpp"
+#if defined(__linux__)
+#include "memory/LinuxMemoryProvider.cpp"
+#endif
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <string>
+
+/**
+ * @brief Events posted by the hook functions below, printed by the pump's thread
+ */
+hooks::HookEventPump& hookEvents() {
+    static hooks::HookEventPump pump;
+    return pump;
+}
 
 /**
  * @brief Main entry point for the game trainer
@@ -12,8 +26,11 @@
  * 2. Base offset calculation
  * 3. MinHook integration for function hooking
  * 4. Basic trainer functionality against SuperTux
+ * 
+ * Runs against mock memory by default; on Linux, "--pid <pid>" attaches to a
+ * running process instead.
  */
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "=== Game Trainer for SuperTux ===" << std::endl;
     std::cout << "Building a complete game mod with:" << std::endl;
     std::cout << "1. Binary pattern matching scanner" << std::endl;
@@ -24,14 +41,39 @@ int main() {
     
     try {
         // Create mock memory provider (simulates game memory)
-        auto memoryProvider = std::make_unique<scanner::MockMemoryProvider>();
+        std::unique_ptr<scanner::IMemoryProvider> memoryProvider =
+            std::make_unique<scanner::MockMemoryProvider>();
+        int processId = 0;
+
+#if defined(__linux__)
+        if (argc > 2 && std::strcmp(argv[1], "--pid") == 0) {
+            pid_t pid = static_cast<pid_t>(std::stol(argv[2]));
+            memoryProvider = std::make_unique<scanner::LinuxMemoryProvider>(pid);
+            processId = pid;
+            std::cout << "Attached to process " << pid << std::endl;
+        }
+#else
+        (void)argc;
+        (void)argv;
+#endif
         
         // Create pattern scanner
         auto scanner = std::make_unique<scanner::PatternScanner>(std::move(memoryProvider));
         
+        // Hook functions only post events; this sink prints them off the game thread
+        hookEvents().addSink([](const hooks::HookEvent* events, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                std::cout << "[HOOK] " << hooks::hookEventName(events[i].type)
+                          << " function intercepted (value " << events[i].value << ")" << std::endl;
+            }
+        });
+        hookEvents().start();
+        
         // Create and run console UI
         ui::ConsoleUI console(std::move(scanner));
+        console.setProcessId(processId);
         console.run();
+        hookEvents().stop();
         
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
@@ -45,24 +87,26 @@ int main() {
  * @brief Example hook functions for demonstration
  * 
  * These would be the actual functions that get called when hooks are triggered.
- * In a real trainer, these would modify game behavior.
+ * In a real trainer, these would modify game behavior. They run on whichever
+ * game thread calls the hooked function, so they post an event, which goes to
+ * that thread's own ring of the pump, instead of printing.
  */
 
 // Example: Health modification hook
 void health_hook() {
-    std::cout << "[HOOK] Health function intercepted!" << std::endl;
+    hookEvents().post(hooks::HookEventType::HEALTH, 0);
     // In real implementation, we would modify health value here
 }
 
 // Example: Coin modification hook  
 void coin_hook() {
-    std::cout << "[HOOK] Coin function intercepted!" << std::endl;
+    hookEvents().post(hooks::HookEventType::COINS, 0);
     // In real implementation, we would modify coin count here
 }
 
 // Example: Infinite lives hook
 void infinite_lives_hook() {
-    std::cout << "[HOOK] Lives function intercepted - granting infinite lives!" << std::endl;
+    hookEvents().post(hooks::HookEventType::LIVES, 0);
     // In real implementation, we would prevent lives from decreasing
 }
 
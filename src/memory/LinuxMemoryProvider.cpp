@@ -0,0 +1,511 @@
+#include "scanner/PatternScanner.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace scanner {
+
+/**
+ * @brief Memory provider for a Linux process
+ *
+ * Reads and writes go through process_vm_readv/process_vm_writev, which
+ * move a whole batch of ranges in one system call. Where those calls are
+ * unavailable or denied, the provider falls back to /proc/<pid>/mem, which
+ * also allows writing to read-only mappings such as code.
+ *
+ * Write tracking uses the kernel's soft-dirty bits: writing "4" to
+ * /proc/<pid>/clear_refs clears them, and bit 55 of each /proc/<pid>/pagemap
+ * entry is set again once the page is written. Kernels built without
+ * CONFIG_MEM_SOFT_DIRTY reject the clear, which turns tracking off.
+ * Reading the bits and clearing them are two steps, so collectWrittenPages()
+ * stops the target with SIGSTOP around them and reports nothing when it
+ * cannot, as for our own process.
+ *
+ * One provider is shared by the UI thread's scans and the value freezer and
+ * watch list threads. Transfers are plain system calls and run unserialized;
+ * the descriptors are opened once under std::call_once, the fallback flags
+ * are atomic and the cached mappings sit behind a mutex.
+ */
+class LinuxMemoryProvider : public IMemoryProvider {
+public:
+    explicit LinuxMemoryProvider(pid_t processId) : m_processId(processId) {}
+    
+    ~LinuxMemoryProvider() override {
+        if (m_memFd >= 0) {
+            close(m_memFd);
+        }
+        if (m_pagemapFd >= 0) {
+            close(m_pagemapFd);
+        }
+    }
+    
+    LinuxMemoryProvider(const LinuxMemoryProvider&) = delete;
+    LinuxMemoryProvider& operator=(const LinuxMemoryProvider&) = delete;
+    
+    bool readMemory(uintptr_t address, void* buffer, size_t size) override {
+        if (m_useVmCalls.load(std::memory_order_relaxed)) {
+            iovec local{buffer, size};
+            iovec remote{reinterpret_cast<void*>(address), size};
+            ssize_t result = process_vm_readv(m_processId, &local, 1, &remote, 1, 0);
+            if (result == static_cast<ssize_t>(size)) {
+                return true;
+            }
+            if (result >= 0 || !vmCallsUnavailable()) {
+                return false;
+            }
+        }
+        
+        int fd = memFd();
+        return fd >= 0 && pread(fd, buffer, size, static_cast<off_t>(address)) == static_cast<ssize_t>(size);
+    }
+    
+    size_t readMemoryBatch(const std::vector<MemoryRead>& reads, std::vector<bool>& results) override {
+        results.assign(reads.size(), false);
+        
+        size_t next = 0;
+        while (m_useVmCalls.load(std::memory_order_relaxed) && next < reads.size()) {
+            next = transferVectored(reads, next, [&](size_t i) { results[i] = true; });
+        }
+        
+        int fd = next < reads.size() ? memFd() : -1;
+        for (; fd >= 0 && next < reads.size(); ++next) {
+            const MemoryRead& read = reads[next];
+            results[next] = pread(fd, read.buffer, read.size, static_cast<off_t>(read.address)) ==
+                            static_cast<ssize_t>(read.size);
+        }
+        
+        return static_cast<size_t>(std::count(results.begin(), results.end(), true));
+    }
+    
+    bool writeMemory(uintptr_t address, const void* buffer, size_t size) override {
+        MemoryWrite write{address, buffer, size};
+        std::vector<WriteResult> results;
+        return writeMemoryBatch(std::vector<MemoryWrite>{write}, results) == 1;
+    }
+    
+    size_t writeMemoryBatch(const std::vector<MemoryWrite>& writes,
+                            std::vector<WriteResult>& results,
+                            bool verify = false) override {
+        results.assign(writes.size(), WriteResult::WRITE_FAILED);
+        
+        size_t next = 0;
+        while (m_useVmCalls.load(std::memory_order_relaxed) && next < writes.size()) {
+            next = transferVectored(writes, next, [&](size_t i) { results[i] = WriteResult::WRITE_OK; });
+        }
+        
+        // Whatever the vectored path could not attempt goes through /proc/<pid>/mem
+        int fd = next < writes.size() ? memFd() : -1;
+        for (; fd >= 0 && next < writes.size(); ++next) {
+            const MemoryWrite& write = writes[next];
+            if (pwrite(fd, write.data, write.size, static_cast<off_t>(write.address)) ==
+                static_cast<ssize_t>(write.size)) {
+                results[next] = WriteResult::WRITE_OK;
+            }
+        }
+        
+        if (verify) {
+            return verifyWrites(writes, results);
+        }
+        return static_cast<size_t>(std::count(results.begin(), results.end(), WriteResult::WRITE_OK));
+    }
+    
+    uintptr_t getModuleBase(const std::string& moduleName) override {
+        uintptr_t base = 0;
+        size_t size = 0;
+        findModule(moduleName, base, size);
+        return base;
+    }
+    
+    size_t getModuleSize(const std::string& moduleName) override {
+        uintptr_t base = 0;
+        size_t size = 0;
+        findModule(moduleName, base, size);
+        return size;
+    }
+    
+    bool isValidAddress(uintptr_t address) override {
+        for (const auto& mapping : readMaps()) {
+            if (address >= mapping.region.base && address < mapping.region.end()) {
+                return mapping.region.isReadable();
+            }
+        }
+        return false;
+    }
+    
+    std::vector<MemoryRegion> getMemoryRegions() override {
+        std::vector<MemoryRegion> regions;
+        std::vector<Mapping> mappings = readMaps();
+        for (const auto& mapping : mappings) {
+            // The vsyscall page cannot be read through either path
+            if (mapping.region.protection != MEMORY_NONE && mapping.path != "[vsyscall]") {
+                regions.push_back(mapping.region);
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(m_mappingsMutex);
+        m_mappings = std::move(mappings);
+        return regions;
+    }
+    
+    bool checkpointWrites() override {
+        static const bool supported = softDirtySupported();
+        if (!supported) {
+            return false;
+        }
+        
+        std::string path = "/proc/" + std::to_string(m_processId) + "/clear_refs";
+        int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        bool tracking = fd >= 0 && write(fd, "4", 1) == 1;
+        if (fd >= 0) {
+            close(fd);
+        }
+        m_trackingWrites.store(tracking, std::memory_order_relaxed);
+        return tracking;
+    }
+    
+    bool getWrittenPages(uintptr_t address, size_t size, std::vector<bool>& written) override {
+        return m_trackingWrites.load(std::memory_order_relaxed) && pagemapFlags(address, size, PAGEMAP_SOFT_DIRTY, written);
+    }
+    
+    bool collectWrittenPages(const std::vector<MemoryRegion>& ranges,
+                             std::vector<std::vector<bool>>& written) override {
+        written.assign(ranges.size(), std::vector<bool>());
+        bool stopped = false;
+        bool paused = !ranges.empty() && m_trackingWrites.load(std::memory_order_relaxed) &&
+                      m_processId != getpid() && pauseTarget(stopped);
+        for (size_t i = 0; paused && i < ranges.size(); ++i) {
+            if (!pagemapFlags(ranges[i].base, ranges[i].size, PAGEMAP_SOFT_DIRTY, written[i])) {
+                written[i].clear();
+            }
+        }
+        
+        bool tracking = checkpointWrites();
+        if (stopped) {
+            kill(m_processId, SIGCONT);
+        }
+        return tracking;
+    }
+    
+    bool getUntouchedPages(uintptr_t address, size_t size, std::vector<bool>& untouched) override {
+        // Only private anonymous memory reads as zeros before it is touched;
+        // an unfaulted file page still has the file's contents
+        bool anonymous = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mappingsMutex);
+            auto it = std::upper_bound(m_mappings.begin(), m_mappings.end(), address,
+                                       [](uintptr_t value, const Mapping& mapping) {
+                                           return value < mapping.region.base;
+                                       });
+            if (it != m_mappings.begin()) {
+                --it;
+                anonymous = address + size <= it->region.end() && isPrivateAnonymous(it->path);
+            }
+        }
+        if (!anonymous || !pagemapFlags(address, size, PAGEMAP_PRESENT | PAGEMAP_SWAPPED, untouched)) {
+            return false;
+        }
+        
+        untouched.flip();
+        return true;
+    }
+    
+private:
+    struct Mapping {
+        MemoryRegion region;
+        std::string path;
+    };
+    
+    pid_t m_processId;
+    int m_memFd = -1;
+    std::once_flag m_memFdOnce;
+    std::atomic<bool> m_useVmCalls{true};
+    int m_pagemapFd = -1;
+    std::once_flag m_pagemapFdOnce;
+    std::atomic<bool> m_trackingWrites{false};
+    
+    std::mutex m_mappingsMutex;
+    std::vector<Mapping> m_mappings;    ///< As of the last getMemoryRegions()
+    
+    static constexpr uint64_t PAGEMAP_SOFT_DIRTY = uint64_t(1) << 55;
+    static constexpr uint64_t PAGEMAP_SWAPPED = uint64_t(1) << 62;
+    static constexpr uint64_t PAGEMAP_PRESENT = uint64_t(1) << 63;
+    
+    /**
+     * @brief Check errno for a failure of the vm calls themselves
+     *
+     * Disables them for this provider when they are missing or denied.
+     */
+    bool vmCallsUnavailable() {
+        if (errno == ENOSYS || errno == EPERM) {
+            m_useVmCalls.store(false, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+    
+    static void* localBuffer(const MemoryRead& read) { return read.buffer; }
+    static void* localBuffer(const MemoryWrite& write) { return const_cast<void*>(write.data); }
+    
+    static ssize_t transfer(pid_t pid, const iovec* local, const iovec* remote, size_t count, const MemoryRead*) {
+        return process_vm_readv(pid, local, count, remote, count, 0);
+    }
+    static ssize_t transfer(pid_t pid, const iovec* local, const iovec* remote, size_t count, const MemoryWrite*) {
+        return process_vm_writev(pid, local, count, remote, count, 0);
+    }
+    
+    /**
+     * @brief Move entries from first on with as few system calls as possible
+     *
+     * A transfer stops at the first remote range that cannot be accessed, so
+     * every entry before it succeeded and that entry failed.
+     *
+     * @param succeeded Called with the index of every entry transferred
+     * @return Index of the first entry not yet attempted
+     */
+    template<typename Entry, typename Fn>
+    size_t transferVectored(const std::vector<Entry>& entries, size_t first, Fn&& succeeded) {
+        const size_t count = std::min<size_t>(entries.size() - first, IOV_MAX);
+        std::vector<iovec> local(count);
+        std::vector<iovec> remote(count);
+        for (size_t i = 0; i < count; ++i) {
+            const Entry& entry = entries[first + i];
+            local[i] = iovec{localBuffer(entry), entry.size};
+            remote[i] = iovec{reinterpret_cast<void*>(entry.address), entry.size};
+        }
+        
+        ssize_t transferred = transfer(m_processId, local.data(), remote.data(), count,
+                                       static_cast<const Entry*>(nullptr));
+        if (transferred < 0) {
+            // A bad first entry fails the call outright; skip just that entry
+            return vmCallsUnavailable() ? first : first + 1;
+        }
+        
+        size_t remaining = static_cast<size_t>(transferred);
+        size_t i = 0;
+        for (; i < count && remaining >= entries[first + i].size; ++i) {
+            remaining -= entries[first + i].size;
+            succeeded(first + i);
+        }
+        
+        // Skip the entry that stopped the transfer (possibly partly done)
+        return first + std::min(i + 1, count);
+    }
+    
+    int memFd() {
+        std::call_once(m_memFdOnce, [this] {
+            std::string path = "/proc/" + std::to_string(m_processId) + "/mem";
+            m_memFd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (m_memFd < 0) {
+                m_memFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            }
+        });
+        return m_memFd;
+    }
+    
+    static bool isPrivateAnonymous(const std::string& path) {
+        return path.empty() || path == "[heap]" || path == "[stack]" || path.compare(0, 6, "[anon:") == 0;
+    }
+    
+    /**
+     * @brief Flag the pages of a range whose pagemap entry has any bit of mask
+     *
+     * There is one 64-bit pagemap entry per system page, which may be
+     * larger than PAGE_STATE_BYTES.
+     */
+    bool pagemapFlags(uintptr_t address, size_t size, uint64_t mask, std::vector<bool>& flags) {
+        int fd = pagemapFd();
+        if (fd < 0) {
+            return false;
+        }
+        
+        flags.assign((size + PAGE_STATE_BYTES - 1) / PAGE_STATE_BYTES, false);
+        if (size == 0) {
+            return true;
+        }
+        
+        static const size_t systemPage = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t end = address + size;
+        const uintptr_t first = address / systemPage;
+        const uintptr_t last = (end - 1) / systemPage;
+        std::vector<uint64_t> entries(last - first + 1);
+        const size_t bytes = entries.size() * sizeof(uint64_t);
+        if (pread(fd, entries.data(), bytes, static_cast<off_t>(first * sizeof(uint64_t))) !=
+            static_cast<ssize_t>(bytes)) {
+            return false;
+        }
+        
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (!(entries[i] & mask)) {
+                continue;
+            }
+            uintptr_t pageStart = std::max<uintptr_t>((first + i) * systemPage, address);
+            uintptr_t pageEnd = std::min<uintptr_t>((first + i + 1) * systemPage, end);
+            for (uintptr_t page = pageStart; page < pageEnd; page += PAGE_STATE_BYTES) {
+                flags[(page - address) / PAGE_STATE_BYTES] = true;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Stop every thread of the target, unless it is stopped already
+     *
+     * @param stopped Set if we sent SIGSTOP, even on failure; the caller then sends SIGCONT
+     * @return true once no thread of the target can run
+     */
+    bool pauseTarget(bool& stopped) {
+        stopped = false;
+        if (allThreadsStopped()) {
+            return true;
+        }
+        if (kill(m_processId, SIGSTOP) != 0) {
+            return false;
+        }
+        
+        stopped = true;
+        for (int attempt = 0; attempt < 200; ++attempt) {
+            if (allThreadsStopped()) {
+                return true;
+            }
+            usleep(500);
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Check the state field of each /proc/<pid>/task/<tid>/stat
+     */
+    bool allThreadsStopped() {
+        std::string tasks = "/proc/" + std::to_string(m_processId) + "/task";
+        DIR* dir = opendir(tasks.c_str());
+        if (!dir) {
+            return false;
+        }
+        
+        bool stopped = true;
+        size_t threads = 0;
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] == '.') {
+                continue;
+            }
+            std::ifstream stat(tasks + "/" + entry->d_name + "/stat");
+            std::string line;
+            std::getline(stat, line);
+            // The state follows the parenthesized command name, which may hold spaces
+            size_t paren = line.rfind(')');
+            char state = paren != std::string::npos && paren + 2 < line.size() ? line[paren + 2] : '?';
+            if (state != 'T' && state != 't' && state != 'Z' && state != 'X') {
+                stopped = false;
+                break;
+            }
+            ++threads;
+        }
+        closedir(dir);
+        return stopped && threads > 0;
+    }
+    
+    /**
+     * @brief Check that the kernel sets soft-dirty bits, on a fresh page of our own
+     */
+    static bool softDirtySupported() {
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        void* page = mmap(nullptr, pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (page == MAP_FAILED) {
+            return false;
+        }
+        
+        *static_cast<volatile uint8_t*>(page) = 1;
+        uint64_t entry = 0;
+        int fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            off_t offset = static_cast<off_t>(reinterpret_cast<uintptr_t>(page) / pageSize * sizeof(uint64_t));
+            if (pread(fd, &entry, sizeof(entry), offset) != static_cast<ssize_t>(sizeof(entry))) {
+                entry = 0;
+            }
+            close(fd);
+        }
+        munmap(page, pageSize);
+        return (entry & PAGEMAP_SOFT_DIRTY) != 0;
+    }
+    
+    int pagemapFd() {
+        std::call_once(m_pagemapFdOnce, [this] {
+            std::string path = "/proc/" + std::to_string(m_processId) + "/pagemap";
+            m_pagemapFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        });
+        return m_pagemapFd;
+    }
+    
+    /**
+     * @brief Parse /proc/<pid>/maps
+     */
+    std::vector<Mapping> readMaps() const {
+        std::vector<Mapping> mappings;
+        std::ifstream maps("/proc/" + std::to_string(m_processId) + "/maps");
+        std::string line;
+        
+        while (std::getline(maps, line)) {
+            unsigned long long start = 0, end = 0;
+            char perms[5] = {};
+            int pathOffset = 0;
+            if (std::sscanf(line.c_str(), "%llx-%llx %4s %*s %*s %*s %n",
+                            &start, &end, perms, &pathOffset) < 3) {
+                continue;
+            }
+            
+            uint32_t protection = MEMORY_NONE;
+            if (perms[0] == 'r') protection |= MEMORY_READ;
+            if (perms[1] == 'w') protection |= MEMORY_WRITE;
+            if (perms[2] == 'x') protection |= MEMORY_EXECUTE;
+            
+            Mapping mapping;
+            mapping.region = MemoryRegion(static_cast<uintptr_t>(start),
+                                          static_cast<size_t>(end - start), protection);
+            if (pathOffset > 0 && static_cast<size_t>(pathOffset) < line.size()) {
+                mapping.path = line.substr(static_cast<size_t>(pathOffset));
+            }
+            mappings.push_back(mapping);
+        }
+        
+        return mappings;
+    }
+    
+    /**
+     * @brief Find the extent of all mappings of a file by base name
+     */
+    bool findModule(const std::string& moduleName, uintptr_t& base, size_t& size) const {
+        uintptr_t low = UINTPTR_MAX;
+        uintptr_t high = 0;
+        
+        for (const auto& mapping : readMaps()) {
+            size_t slash = mapping.path.find_last_of('/');
+            std::string name = slash == std::string::npos ? mapping.path : mapping.path.substr(slash + 1);
+            if (name == moduleName) {
+                low = std::min(low, mapping.region.base);
+                high = std::max(high, mapping.region.end());
+            }
+        }
+        
+        if (high == 0) {
+            return false;
+        }
+        base = low;
+        size = high - low;
+        return true;
+    }
+};
+
+} // namespace scanner
\ No newline at end of file
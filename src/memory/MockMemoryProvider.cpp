@@ -1,8 +1,12 @@
 #include "scanner/PatternScanner.h"
+#include <algorithm>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <set>
 #include <cstring>
 
 namespace scanner {
@@ -10,7 +14,10 @@ namespace scanner {
 /**
  * @brief Mock memory provider for demonstration and testing
  * 
- * This provider simulates memory reading without requiring Windows APIs
+ * This provider simulates memory reading and writing without requiring
+ * Windows APIs. Access is serialized, so a writer thread such as the value
+ * freezer can run alongside scans. Every write counts as a write by the
+ * target for write tracking.
  */
 class MockMemoryProvider : public IMemoryProvider {
 public:
@@ -20,24 +27,45 @@ public:
     }
     
     bool readMemory(uintptr_t address, void* buffer, size_t size) override {
-        auto it = m_memoryRegions.lower_bound(address);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return readLocked(address, buffer, size);
+    }
+    
+    size_t readMemoryBatch(const std::vector<MemoryRead>& reads, std::vector<bool>& results) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.assign(reads.size(), false);
         
-        if (it == m_memoryRegions.end()) {
-            return false;
+        size_t read = 0;
+        for (size_t i = 0; i < reads.size(); ++i) {
+            if (readLocked(reads[i].address, reads[i].buffer, reads[i].size)) {
+                results[i] = true;
+                ++read;
+            }
         }
-        
-        // Check if the requested range is within a region
-        uintptr_t regionStart = it->first;
-        const std::vector<uint8_t>& regionData = it->second;
-        
-        if (address < regionStart || address + size > regionStart + regionData.size()) {
-            return false;
+        return read;
+    }
+    
+    bool writeMemory(uintptr_t address, const void* buffer, size_t size) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return writeLocked(address, buffer, size);
+    }
+    
+    size_t writeMemoryBatch(const std::vector<MemoryWrite>& writes,
+                            std::vector<WriteResult>& results,
+                            bool verify = false) override {
+        size_t written = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            results.assign(writes.size(), WriteResult::WRITE_FAILED);
+            for (size_t i = 0; i < writes.size(); ++i) {
+                if (writeLocked(writes[i].address, writes[i].data, writes[i].size)) {
+                    results[i] = WriteResult::WRITE_OK;
+                    ++written;
+                }
+            }
         }
         
-        // Copy data from mock memory
-        size_t offset = address - regionStart;
-        std::memcpy(buffer, regionData.data() + offset, size);
-        return true;
+        return verify ? verifyWrites(writes, results) : written;
     }
     
     uintptr_t getModuleBase(const std::string& moduleName) override {
@@ -57,20 +85,117 @@ public:
     }
     
     bool isValidAddress(uintptr_t address) override {
-        for (const auto& region : m_memoryRegions) {
-            if (address >= region.first && 
-                address < region.first + region.second.size()) {
-                return true;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return findRegion(address) != nullptr;
+    }
+    
+    std::vector<MemoryRegion> getMemoryRegions() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<MemoryRegion> regions;
+        for (const auto& entry : m_memoryRegions) {
+            const MockRegion& region = entry.second;
+            regions.emplace_back(region.base, region.data.size(), region.protection);
+        }
+        return regions;
+    }
+    
+    bool checkpointWrites() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_writtenPages.clear();
+        m_trackingWrites = true;
+        return true;
+    }
+    
+    bool collectWrittenPages(const std::vector<MemoryRegion>& ranges,
+                             std::vector<std::vector<bool>>& written) override {
+        std::set<uintptr_t> pages;
+        bool tracked = false;
+        std::function<void()> hook;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            tracked = m_trackingWrites;
+            pages.swap(m_writtenPages);
+            m_trackingWrites = true;
+            hook = m_collectHook;
+        }
+        if (hook) {
+            hook();
+        }
+        
+        written.assign(ranges.size(), std::vector<bool>());
+        for (size_t r = 0; tracked && r < ranges.size(); ++r) {
+            written[r].assign((ranges[r].size + PAGE_STATE_BYTES - 1) / PAGE_STATE_BYTES, false);
+            for (size_t i = 0; i < written[r].size(); ++i) {
+                written[r][i] = pages.count(ranges[r].base / PAGE_STATE_BYTES + i) != 0;
             }
         }
-        return false;
+        return true;
+    }
+    
+    bool getUntouchedPages(uintptr_t address, size_t size, std::vector<bool>& untouched) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const MockRegion* region = findRegion(address);
+        if (!region || region->untouched.empty() || (address - region->base) % PAGE_STATE_BYTES != 0 ||
+            address + size > region->base + region->data.size()) {
+            return false;
+        }
+        
+        size_t first = (address - region->base) / PAGE_STATE_BYTES;
+        untouched.assign(region->untouched.begin() + first,
+                         region->untouched.begin() + first + (size + PAGE_STATE_BYTES - 1) / PAGE_STATE_BYTES);
+        return true;
+    }
+    
+    bool getWrittenPages(uintptr_t address, size_t size, std::vector<bool>& written) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_trackingWrites) {
+            return false;
+        }
+        
+        written.assign((size + PAGE_STATE_BYTES - 1) / PAGE_STATE_BYTES, false);
+        for (size_t i = 0; i < written.size(); ++i) {
+            written[i] = m_writtenPages.count(address / PAGE_STATE_BYTES + i) != 0;
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Run a callback inside each collectWrittenPages(), as a target
+     * thread writing while the pages are collected would
+     *
+     * The callback may use the provider; its writes belong to the new interval.
+     */
+    void setCollectHook(std::function<void()> hook) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_collectHook = std::move(hook);
     }
     
     /**
      * @brief Add mock memory region
      */
-    void addMemoryRegion(uintptr_t baseAddress, const std::vector<uint8_t>& data) {
-        m_memoryRegions[baseAddress] = data;
+    void addMemoryRegion(uintptr_t baseAddress, const std::vector<uint8_t>& data,
+                         uint32_t protection = MEMORY_READ | MEMORY_WRITE) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MockRegion& region = m_memoryRegions[baseAddress];
+        region.base = baseAddress;
+        region.data = data;
+        region.protection = protection;
+        region.untouched.clear();
+        markWritten(baseAddress, data.size());
+    }
+    
+    /**
+     * @brief Add a zero-filled region whose pages count as untouched until written
+     * 
+     * Stands in for memory the game reserved but never used.
+     */
+    void addReservedRegion(uintptr_t baseAddress, size_t size) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MockRegion& region = m_memoryRegions[baseAddress];
+        region.base = baseAddress;
+        region.data.assign(size, 0);
+        region.protection = MEMORY_READ | MEMORY_WRITE;
+        region.untouched.assign((size + PAGE_STATE_BYTES - 1) / PAGE_STATE_BYTES, true);
     }
     
     /**
@@ -82,10 +207,95 @@ public:
     }
     
 private:
-    std::map<uintptr_t, std::vector<uint8_t>> m_memoryRegions;
+    struct MockRegion {
+        uintptr_t base = 0;
+        std::vector<uint8_t> data;
+        uint32_t protection = MEMORY_NONE;
+        std::vector<bool> untouched;    ///< Per page, for reserved regions only
+    };
+    
+    std::mutex m_mutex;
+    std::map<uintptr_t, MockRegion> m_memoryRegions;
+    std::set<uintptr_t> m_writtenPages;     ///< Page numbers written since the checkpoint
+    bool m_trackingWrites = false;
+    std::function<void()> m_collectHook;    ///< Run by collectWrittenPages()
     std::map<std::string, uintptr_t> m_moduleBases;
     std::map<std::string, size_t> m_moduleSizes;
     
+    /**
+     * @brief Read from a region (caller holds m_mutex)
+     */
+    bool readLocked(uintptr_t address, void* buffer, size_t size) {
+        const MockRegion* region = findRegion(address);
+        if (!region) {
+            return false;
+        }
+        
+        // Check if the requested range is within the region
+        uintptr_t regionStart = region->base;
+        const std::vector<uint8_t>& regionData = region->data;
+        
+        if (address + size > regionStart + regionData.size()) {
+            return false;
+        }
+        
+        // Copy data from mock memory
+        size_t offset = address - regionStart;
+        std::memcpy(buffer, regionData.data() + offset, size);
+        return true;
+    }
+    
+    /**
+     * @brief Write into a writable region (caller holds m_mutex)
+     */
+    bool writeLocked(uintptr_t address, const void* buffer, size_t size) {
+        MockRegion* region = findRegion(address);
+        if (!region || !(region->protection & MEMORY_WRITE) ||
+            address + size > region->base + region->data.size()) {
+            return false;
+        }
+        
+        std::memcpy(region->data.data() + (address - region->base), buffer, size);
+        if (!region->untouched.empty() && size > 0) {
+            size_t offset = address - region->base;
+            for (size_t page = offset / PAGE_STATE_BYTES; page <= (offset + size - 1) / PAGE_STATE_BYTES; ++page) {
+                region->untouched[page] = false;
+            }
+        }
+        markWritten(address, size);
+        return true;
+    }
+    
+    /**
+     * @brief Record written pages while tracking (caller holds m_mutex)
+     */
+    void markWritten(uintptr_t address, size_t size) {
+        if (!m_trackingWrites || size == 0) {
+            return;
+        }
+        for (uintptr_t page = address / PAGE_STATE_BYTES;
+             page <= (address + size - 1) / PAGE_STATE_BYTES; ++page) {
+            m_writtenPages.insert(page);
+        }
+    }
+    
+    /**
+     * @brief Find the region containing an address
+     */
+    MockRegion* findRegion(uintptr_t address) {
+        auto it = m_memoryRegions.upper_bound(address);
+        if (it == m_memoryRegions.begin()) {
+            return nullptr;
+        }
+        --it;
+        
+        MockRegion& region = it->second;
+        if (address >= region.base + region.data.size()) {
+            return nullptr;
+        }
+        return &region;
+    }
+    
     void initializeMockMemory() {
         // Add a mock module "supertux.exe" at address 0x400000
         const uintptr_t supertuxBase = 0x400000;
@@ -124,7 +334,7 @@ private:
         mockMemory[0x34568] = 0x8B;  // mov ebp, esp
         mockMemory[0x34569] = 0xEC;  // ...
         
-        addMemoryRegion(supertuxBase, mockMemory);
+        addMemoryRegion(supertuxBase, mockMemory, MEMORY_READ | MEMORY_EXECUTE);
         
         // Add another region for heap data
         std::vector<uint8_t> heapData(0x10000, 0x00);
@@ -134,6 +344,17 @@ private:
         *reinterpret_cast<uint32_t*>(&heapData[0x1004]) = 50;  // Coins = 50
         
         addMemoryRegion(0x500000, heapData);
+        
+        // Add read-only level data with an ASCII and a UTF-16LE string
+        std::vector<uint8_t> levelData(0x1000, 0x00);
+        const std::string levelName = "Icy Island";
+        std::copy(levelName.begin(), levelName.end(), levelData.begin() + 0x100);
+        const std::string sectorName = "Welcome to Antarctica";
+        for (size_t i = 0; i < sectorName.size(); ++i) {
+            levelData[0x200 + i * 2] = static_cast<uint8_t>(sectorName[i]);
+        }
+        
+        addMemoryRegion(0x580000, levelData, MEMORY_READ);
     }
 };
 
@@ -11,7 +11,8 @@ namespace scanner {
 class WindowsMemoryProvider : public IMemoryProvider {
 public:
     WindowsMemoryProvider(DWORD processId) : m_processId(processId), m_hProcess(nullptr) {
-        m_hProcess = OpenProcess(PROCESS_VM_READ | PROCESS_QUERY_INFORMATION, FALSE, processId);
+        m_hProcess = OpenProcess(PROCESS_VM_READ | PROCESS_VM_WRITE | PROCESS_VM_OPERATION |
+                                 PROCESS_QUERY_INFORMATION, FALSE, processId);
     }
     
     ~WindowsMemoryProvider() override {
@@ -28,6 +29,14 @@ public:
                                 buffer, size, &bytesRead) && bytesRead == size;
     }
     
+    bool writeMemory(uintptr_t address, const void* buffer, size_t size) override {
+        if (!m_hProcess) return false;
+        
+        SIZE_T bytesWritten = 0;
+        return WriteProcessMemory(m_hProcess, reinterpret_cast<LPVOID>(address),
+                                 buffer, size, &bytesWritten) && bytesWritten == size;
+    }
+    
     uintptr_t getModuleBase(const std::string& moduleName) override {
         if (!m_hProcess) return 0;
         
@@ -84,6 +93,45 @@ public:
                               PAGE_EXECUTE_READWRITE)) != 0;
     }
     
+    std::vector<MemoryRegion> getMemoryRegions() override {
+        std::vector<MemoryRegion> regions;
+        if (!m_hProcess) return regions;
+        
+        MEMORY_BASIC_INFORMATION mbi;
+        uintptr_t address = 0;
+        
+        while (VirtualQueryEx(m_hProcess, reinterpret_cast<LPCVOID>(address),
+                             &mbi, sizeof(mbi)) == sizeof(mbi)) {
+            uintptr_t regionBase = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+            
+            if (mbi.State == MEM_COMMIT && !(mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS))) {
+                uint32_t protection = MEMORY_NONE;
+                DWORD basic = mbi.Protect & 0xFF;
+                
+                if (basic & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+                            PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) {
+                    protection |= MEMORY_READ;
+                }
+                if (basic & (PAGE_READWRITE | PAGE_WRITECOPY |
+                            PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) {
+                    protection |= MEMORY_WRITE;
+                }
+                if (basic & (PAGE_EXECUTE | PAGE_EXECUTE_READ |
+                            PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) {
+                    protection |= MEMORY_EXECUTE;
+                }
+                
+                regions.emplace_back(regionBase, mbi.RegionSize, protection);
+            }
+            
+            uintptr_t next = regionBase + mbi.RegionSize;
+            if (next <= address) break;
+            address = next;
+        }
+        
+        return regions;
+    }
+    
     static DWORD findProcessId(const std::string& processName) {
         DWORD processId = 0;
         HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
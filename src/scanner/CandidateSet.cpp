@@ -0,0 +1,146 @@
+#include "scanner/CandidateSet.h"
+#include "scanner/PageHash.h"
+#include <algorithm>
+#include <cstring>
+
+namespace scanner {
+
+size_t CandidateBlock::memoryUsage() const {
+    return sizeof(CandidateBlock) +
+           m_bitmap.capacity() * sizeof(uint64_t) +
+           m_deltas.capacity() +
+           m_values.capacity() +
+           m_pageHashes.capacity() * sizeof(uint64_t);
+}
+
+CandidateBlockBuilder::CandidateBlockBuilder(size_t valueSize)
+    : m_valueSize(valueSize) {}
+
+void CandidateBlockBuilder::reset(uintptr_t base, size_t slotCount) {
+    m_base = base;
+    m_slotCount = slotCount;
+    m_uniform = true;
+    m_slots.clear();
+    m_values.clear();
+    m_hashData = nullptr;
+    m_hashSize = 0;
+}
+
+void CandidateBlockBuilder::add(size_t slot, const uint8_t* value) {
+    if (m_uniform && !m_slots.empty() &&
+        std::memcmp(m_values.data(), value, m_valueSize) != 0) {
+        m_uniform = false;
+    }
+    
+    m_slots.push_back(static_cast<uint32_t>(slot));
+    m_values.insert(m_values.end(), value, value + m_valueSize);
+}
+
+void CandidateBlockBuilder::hashPages(uintptr_t address, const uint8_t* data, size_t size) {
+    m_hashAddress = address;
+    m_hashData = data;
+    m_hashSize = size;
+}
+
+CandidateBlock CandidateBlockBuilder::build() const {
+    CandidateBlock block;
+    block.m_base = m_base;
+    block.m_slotCount = m_slotCount;
+    block.m_count = m_slots.size();
+    block.m_valueSize = m_valueSize;
+    block.m_uniform = m_uniform;
+    
+    if (m_uniform) {
+        block.m_values.assign(m_values.begin(), m_values.begin() + m_valueSize);
+    } else {
+        block.m_values = m_values;
+    }
+    
+    // Encode gaps as LEB128 and keep them if smaller than a bitmap
+    std::vector<uint8_t> deltas;
+    size_t bitmapBytes = ((m_slotCount + 63) / 64) * sizeof(uint64_t);
+    uint32_t previous = 0;
+    
+    for (size_t i = 0; i < m_slots.size() && deltas.size() < bitmapBytes; ++i) {
+        uint32_t gap = i == 0 ? m_slots[i] : m_slots[i] - previous - 1;
+        previous = m_slots[i];
+        do {
+            uint8_t byte = gap & 0x7F;
+            gap >>= 7;
+            deltas.push_back(gap ? (byte | 0x80) : byte);
+        } while (gap);
+    }
+    
+    if (deltas.size() < bitmapBytes) {
+        block.m_encoding = CandidateBlock::Encoding::DELTA;
+        block.m_deltas = std::move(deltas);
+        block.m_deltas.shrink_to_fit();
+    } else {
+        block.m_encoding = CandidateBlock::Encoding::BITMAP;
+        block.m_bitmap.assign((m_slotCount + 63) / 64, 0);
+        for (uint32_t slot : m_slots) {
+            block.m_bitmap[slot / 64] |= uint64_t(1) << (slot % 64);
+        }
+        
+        // Hash the pages that lie wholly inside both the buffer and the block
+        if (m_hashData) {
+            uintptr_t start = std::max(m_base, m_hashAddress);
+            block.m_pageBase = (start + SNAPSHOT_PAGE_BYTES - 1) / SNAPSHOT_PAGE_BYTES * SNAPSHOT_PAGE_BYTES;
+            for (uintptr_t page = block.m_pageBase;
+                 page + SNAPSHOT_PAGE_BYTES <= m_hashAddress + m_hashSize;
+                 page += SNAPSHOT_PAGE_BYTES) {
+                block.m_pageHashes.push_back(hashBytes(m_hashData + (page - m_hashAddress), SNAPSHOT_PAGE_BYTES));
+            }
+        }
+    }
+    
+    return block;
+}
+
+void CandidateSet::addBlock(CandidateBlock block) {
+    if (block.count() == 0) {
+        return;
+    }
+    
+    addBlock(std::make_shared<const CandidateBlock>(std::move(block)));
+}
+
+void CandidateSet::addBlock(std::shared_ptr<const CandidateBlock> block) {
+    if (!block || block->count() == 0) {
+        return;
+    }
+    
+    m_count += block->count();
+    m_blocks.push_back(std::move(block));
+}
+
+size_t CandidateSet::memoryUsage() const {
+    size_t total = sizeof(CandidateSet) +
+                   m_blocks.capacity() * sizeof(std::shared_ptr<const CandidateBlock>);
+    for (const auto& block : m_blocks) {
+        total += block->memoryUsage();
+    }
+    return total;
+}
+
+std::vector<uintptr_t> CandidateSet::getAddresses(size_t limit) const {
+    std::vector<uintptr_t> addresses;
+    for (const auto& block : m_blocks) {
+        if (addresses.size() >= limit) {
+            break;
+        }
+        block->forEach([&](size_t slot, size_t) {
+            if (addresses.size() < limit) {
+                addresses.push_back(block->getBase() + slot * m_stride);
+            }
+        });
+    }
+    return addresses;
+}
+
+void CandidateSet::clear() {
+    m_blocks.clear();
+    m_count = 0;
+}
+
+} // namespace scanner
\ No newline at end of file
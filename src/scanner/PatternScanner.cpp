@@ -1,9 +1,115 @@
 #include "scanner/PatternScanner.h"
+#include "scanner/PageHash.h"
+#include "scanner/ScanKernels.h"
+#include "scanner/ScanResultStore.h"
 #include <algorithm>
 #include <cstring>
 
 namespace scanner {
 
+namespace {
+
+constexpr size_t SCAN_CHUNK = 1024 * 1024;
+
+/**
+ * @brief Encode text and build the per-byte case folding mask
+ */
+void encodeString(const std::string& text, const StringScanOptions& options,
+                  std::vector<uint8_t>& needle, std::vector<uint8_t>& fold) {
+    needle.clear();
+    fold.clear();
+    
+    for (char c : text) {
+        uint8_t byte = static_cast<uint8_t>(c);
+        bool letter = (byte | 0x20) >= 'a' && (byte | 0x20) <= 'z';
+        
+        // OR-ing 0x20 maps 'A'..'Z' onto 'a'..'z' and nothing else onto them
+        if (options.caseInsensitive && letter) {
+            needle.push_back(byte | 0x20);
+            fold.push_back(0x20);
+        } else {
+            needle.push_back(byte);
+            fold.push_back(0x00);
+        }
+        
+        if (options.encoding == StringEncoding::UTF16LE) {
+            needle.push_back(0x00);
+            fold.push_back(0x00);
+        }
+    }
+}
+
+} // anonymous namespace
+
+size_t IMemoryProvider::readMemoryBatch(const std::vector<MemoryRead>& reads, std::vector<bool>& results) {
+    results.assign(reads.size(), false);
+    
+    size_t read = 0;
+    for (size_t i = 0; i < reads.size(); ++i) {
+        if (readMemory(reads[i].address, reads[i].buffer, reads[i].size)) {
+            results[i] = true;
+            ++read;
+        }
+    }
+    return read;
+}
+
+size_t IMemoryProvider::writeMemoryBatch(const std::vector<MemoryWrite>& writes,
+                                         std::vector<WriteResult>& results,
+                                         bool verify) {
+    results.assign(writes.size(), WriteResult::WRITE_FAILED);
+    
+    size_t written = 0;
+    for (size_t i = 0; i < writes.size(); ++i) {
+        if (writeMemory(writes[i].address, writes[i].data, writes[i].size)) {
+            results[i] = WriteResult::WRITE_OK;
+            ++written;
+        }
+    }
+    
+    return verify ? verifyWrites(writes, results) : written;
+}
+
+bool IMemoryProvider::checkpointWrites() {
+    return false;
+}
+
+bool IMemoryProvider::getWrittenPages(uintptr_t, size_t, std::vector<bool>&) {
+    return false;
+}
+
+bool IMemoryProvider::collectWrittenPages(const std::vector<MemoryRegion>& ranges,
+                                          std::vector<std::vector<bool>>& written) {
+    written.assign(ranges.size(), std::vector<bool>());
+    return checkpointWrites();
+}
+
+bool IMemoryProvider::getUntouchedPages(uintptr_t, size_t, std::vector<bool>&) {
+    return false;
+}
+
+size_t IMemoryProvider::verifyWrites(const std::vector<MemoryWrite>& writes,
+                                     std::vector<WriteResult>& results) {
+    std::vector<uint8_t> readBack;
+    size_t verified = 0;
+    
+    for (size_t i = 0; i < writes.size(); ++i) {
+        if (results[i] != WriteResult::WRITE_OK) {
+            continue;
+        }
+        
+        readBack.resize(writes[i].size);
+        if (!readMemory(writes[i].address, readBack.data(), readBack.size()) ||
+            std::memcmp(readBack.data(), writes[i].data, writes[i].size) != 0) {
+            results[i] = WriteResult::WRITE_VERIFY_FAILED;
+        } else {
+            ++verified;
+        }
+    }
+    
+    return verified;
+}
+
 PatternScanner::PatternScanner(std::unique_ptr<IMemoryProvider> memoryProvider)
     : m_memoryProvider(std::move(memoryProvider)) {}
 
@@ -68,6 +174,224 @@ bool PatternScanner::scanEntireProcess(
     return scanModule(pattern, "supertux.exe", result);
 }
 
+bool PatternScanner::scanString(
+    const std::string& text,
+    uintptr_t startAddress,
+    size_t size,
+    memory::PatternResult& result,
+    const StringScanOptions& options) {
+    
+    if (!m_memoryProvider || text.empty() || !m_memoryProvider->isValidAddress(startAddress)) {
+        return false;
+    }
+    
+    std::vector<uint8_t> needle, fold;
+    encodeString(text, options, needle, fold);
+    
+    std::vector<uint8_t> memory = readMemoryRegion(startAddress, size);
+    if (memory.size() < needle.size()) {
+        return false;
+    }
+    
+    size_t found = findString(memory.data(), memory.size(), needle.data(), fold.data(), needle.size());
+    if (found == memory.size()) {
+        return false;
+    }
+    
+    result.address = startAddress + found;
+    result.patternName = text;
+    result.matchedBytes.assign(memory.begin() + found, memory.begin() + found + needle.size());
+    return true;
+}
+
+size_t PatternScanner::scanStringAll(
+    const std::string& text,
+    ScanResultStore& results,
+    const StringScanOptions& options) {
+    
+    if (!m_memoryProvider || text.empty()) {
+        return 0;
+    }
+    
+    std::vector<uint8_t> needle, fold;
+    encodeString(text, options, needle, fold);
+    
+    // A non-zero needle byte never matches a zero, with or without folding
+    size_t nonZero = 0;
+    while (nonZero < needle.size() && needle[nonZero] == 0) {
+        ++nonZero;
+    }
+    
+    const ScanResultStore::PatternId id = results.internPattern(text, static_cast<uint32_t>(needle.size()));
+    size_t found = 0;
+    
+    forEachReadableChunk(needle.size(), nonZero, [&](uintptr_t address, const uint8_t* data, size_t size) {
+        size_t offset = 0;
+        while (offset + needle.size() <= size) {
+            size_t match = findString(data + offset, size - offset, needle.data(), fold.data(), needle.size());
+            if (match == size - offset) {
+                break;
+            }
+            
+            offset += match;
+            if (!results.add(address + offset, id)) {
+                return false;
+            }
+            if (++found == options.maxResults) {
+                return false;
+            }
+            ++offset;
+        }
+        return true;
+    });
+    
+    return found;
+}
+
+size_t PatternScanner::scanAll(
+    const memory::Pattern& pattern,
+    ScanResultStore& results,
+    size_t maxResults) {
+    
+    const size_t patternSize = pattern.size();
+    if (!m_memoryProvider || patternSize == 0) {
+        return 0;
+    }
+    
+    // Jump between occurrences of the first fixed byte instead of trying
+    // every position
+    size_t anchor = 0;
+    while (anchor < patternSize && pattern.isWildcard(anchor)) {
+        ++anchor;
+    }
+    
+    size_t nonZero = 0;
+    while (nonZero < patternSize && (pattern.isWildcard(nonZero) || pattern.getBytes()[nonZero] == 0)) {
+        ++nonZero;
+    }
+    
+    const ScanResultStore::PatternId id = results.internPattern(pattern.getName(),
+                                                                static_cast<uint32_t>(patternSize));
+    size_t found = 0;
+    
+    forEachReadableChunk(patternSize, nonZero, [&](uintptr_t address, const uint8_t* data, size_t size) {
+        if (size < patternSize) {
+            return true;
+        }
+        
+        const size_t last = size - patternSize;
+        for (size_t i = 0; i <= last; ++i) {
+            if (anchor < patternSize) {
+                const void* next = std::memchr(data + i + anchor, pattern.getBytes()[anchor], last - i + 1);
+                if (!next) {
+                    break;
+                }
+                i = static_cast<size_t>(static_cast<const uint8_t*>(next) - data) - anchor;
+            }
+            
+            if (pattern.matches(data + i)) {
+                if (!results.add(address + i, id, data + i)) {
+                    return false;
+                }
+                if (++found == maxResults) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+    
+    return found;
+}
+
+void PatternScanner::forEachReadableChunk(
+    size_t overlap,
+    size_t nonZeroOffset,
+    const std::function<bool(uintptr_t, const uint8_t*, size_t)>& fn) {
+    
+    // Chunks overlap by overlap - 1 bytes so matches across chunk boundaries
+    // are found exactly once
+    std::vector<uint8_t> buffer(SCAN_CHUNK + overlap - 1);
+    std::vector<bool> untouched;
+    std::vector<bool> skipPage;
+    const size_t pageBytes = IMemoryProvider::PAGE_STATE_BYTES;
+    const bool skipZeros = nonZeroOffset < overlap;
+    m_lastScanStats = RegionScanStats();
+    
+    for (const auto& region : m_memoryProvider->getMemoryRegions()) {
+        if (!region.isReadable() || region.size < overlap) {
+            continue;
+        }
+        
+        bool queryPages = skipZeros;
+        for (uintptr_t chunkBase = region.base; chunkBase < region.end(); chunkBase += SCAN_CHUNK) {
+            size_t readSize = std::min(buffer.size(), static_cast<size_t>(region.end() - chunkBase));
+            const uintptr_t chunkEnd = chunkBase + readSize;
+            const uintptr_t pageBase = chunkBase / pageBytes * pageBytes;
+            
+            // A provider that cannot tell for one chunk is not asked again for the region
+            bool known = queryPages && m_memoryProvider->getUntouchedPages(pageBase, chunkEnd - pageBase, untouched);
+            queryPages = known;
+            // Pages are counted by the chunk they start in, not by the overlap
+            const size_t ownPages = (std::min<uintptr_t>(chunkBase + SCAN_CHUNK, chunkEnd) - pageBase +
+                                     pageBytes - 1) / pageBytes;
+            if (known && std::find(untouched.begin(), untouched.end(), false) == untouched.end()) {
+                m_lastScanStats.pagesUntouched += ownPages;
+                continue;
+            }
+            
+            if (!m_memoryProvider->readMemory(chunkBase, buffer.data(), readSize)) {
+                continue;
+            }
+            m_lastScanStats.bytesRead += readSize;
+            
+            if (!skipZeros) {
+                if (!fn(chunkBase, buffer.data(), readSize)) {
+                    return;
+                }
+                continue;
+            }
+            
+            // Flag the untouched and all-zero parts of each page in the buffer
+            skipPage.assign((chunkEnd - pageBase + pageBytes - 1) / pageBytes, false);
+            for (size_t page = 0; page < skipPage.size(); ++page) {
+                uintptr_t start = std::max<uintptr_t>(pageBase + page * pageBytes, chunkBase);
+                uintptr_t end = std::min<uintptr_t>(pageBase + (page + 1) * pageBytes, chunkEnd);
+                if (known && untouched[page]) {
+                    skipPage[page] = true;
+                    m_lastScanStats.pagesUntouched += page < ownPages;
+                } else if (isZeroPage(buffer.data() + (start - chunkBase), end - start)) {
+                    skipPage[page] = true;
+                    m_lastScanStats.pagesZero += page < ownPages;
+                }
+            }
+            
+            // Hand over each run of other pages with the matches whose
+            // non-zero byte falls inside it
+            for (size_t page = 0; page < skipPage.size();) {
+                if (skipPage[page]) {
+                    ++page;
+                    continue;
+                }
+                size_t last = page;
+                while (last + 1 < skipPage.size() && !skipPage[last + 1]) {
+                    ++last;
+                }
+                
+                uintptr_t runStart = std::max<uintptr_t>(pageBase + page * pageBytes, chunkBase);
+                uintptr_t runEnd = std::min<uintptr_t>(pageBase + (last + 1) * pageBytes, chunkEnd);
+                uintptr_t start = runStart - std::min<uintptr_t>(nonZeroOffset, runStart - chunkBase);
+                uintptr_t end = std::min<uintptr_t>(runEnd + (overlap - 1 - nonZeroOffset), chunkEnd);
+                if (end >= start + overlap &&
+                    !fn(start, buffer.data() + (start - chunkBase), static_cast<size_t>(end - start))) {
+                    return;
+                }
+                page = last + 1;
+            }
+        }
+    }
+}
+
 bool PatternScanner::naiveScan(
     const memory::Pattern& pattern,
     uintptr_t startAddress,
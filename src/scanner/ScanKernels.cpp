@@ -0,0 +1,252 @@
+#include "scanner/ScanKernels.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace scanner {
+
+namespace {
+
+template<typename T, bool Inclusive>
+inline bool inRange(T value, T lo, T hi) {
+    return value >= lo && (Inclusive ? value <= hi : value < hi);
+}
+
+template<typename T, bool Inclusive>
+void scalarRangeMask(const uint8_t* data, size_t begin, size_t count, T lo, T hi, uint64_t* mask) {
+    for (size_t i = begin; i < count; ++i) {
+        T value;
+        std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+        if (inRange<T, Inclusive>(value, lo, hi)) {
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+template<bool Inclusive>
+void floatRangeMaskImpl(const uint8_t* data, size_t count, float lo, float hi, uint64_t* mask) {
+    size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256 vlo = _mm256_set1_ps(lo);
+    const __m256 vhi = _mm256_set1_ps(hi);
+    
+    // 32 floats per iteration; ordered predicates reject NaN
+    for (; i + 32 <= count; i += 32) {
+        uint64_t bits = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            __m256 v = _mm256_loadu_ps(reinterpret_cast<const float*>(data) + i + lane * 8);
+            __m256 ge = _mm256_cmp_ps(v, vlo, _CMP_GE_OQ);
+            __m256 le = Inclusive ? _mm256_cmp_ps(v, vhi, _CMP_LE_OQ)
+                                  : _mm256_cmp_ps(v, vhi, _CMP_LT_OQ);
+            bits |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_and_ps(ge, le))) << (lane * 8);
+        }
+        mask[i / 64] |= bits << (i % 64);
+    }
+#elif defined(__SSE2__)
+    const __m128 vlo = _mm_set1_ps(lo);
+    const __m128 vhi = _mm_set1_ps(hi);
+    
+    // 16 floats per iteration; ordered predicates reject NaN
+    for (; i + 16 <= count; i += 16) {
+        uint64_t bits = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            __m128 v = _mm_loadu_ps(reinterpret_cast<const float*>(data) + i + lane * 4);
+            __m128 ge = _mm_cmpge_ps(v, vlo);
+            __m128 le = Inclusive ? _mm_cmple_ps(v, vhi) : _mm_cmplt_ps(v, vhi);
+            bits |= static_cast<uint64_t>(_mm_movemask_ps(_mm_and_ps(ge, le))) << (lane * 4);
+        }
+        mask[i / 64] |= bits << (i % 64);
+    }
+#endif
+    
+    scalarRangeMask<float, Inclusive>(data, i, count, lo, hi, mask);
+}
+
+template<bool Inclusive>
+void doubleRangeMaskImpl(const uint8_t* data, size_t count, double lo, double hi, uint64_t* mask) {
+    size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d vlo = _mm256_set1_pd(lo);
+    const __m256d vhi = _mm256_set1_pd(hi);
+    
+    for (; i + 16 <= count; i += 16) {
+        uint64_t bits = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            __m256d v = _mm256_loadu_pd(reinterpret_cast<const double*>(data) + i + lane * 4);
+            __m256d ge = _mm256_cmp_pd(v, vlo, _CMP_GE_OQ);
+            __m256d le = Inclusive ? _mm256_cmp_pd(v, vhi, _CMP_LE_OQ)
+                                   : _mm256_cmp_pd(v, vhi, _CMP_LT_OQ);
+            bits |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_and_pd(ge, le))) << (lane * 4);
+        }
+        mask[i / 64] |= bits << (i % 64);
+    }
+#elif defined(__SSE2__)
+    const __m128d vlo = _mm_set1_pd(lo);
+    const __m128d vhi = _mm_set1_pd(hi);
+    
+    for (; i + 8 <= count; i += 8) {
+        uint64_t bits = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            __m128d v = _mm_loadu_pd(reinterpret_cast<const double*>(data) + i + lane * 2);
+            __m128d ge = _mm_cmpge_pd(v, vlo);
+            __m128d le = Inclusive ? _mm_cmple_pd(v, vhi) : _mm_cmplt_pd(v, vhi);
+            bits |= static_cast<uint64_t>(_mm_movemask_pd(_mm_and_pd(ge, le))) << (lane * 2);
+        }
+        mask[i / 64] |= bits << (i % 64);
+    }
+#endif
+    
+    scalarRangeMask<double, Inclusive>(data, i, count, lo, hi, mask);
+}
+
+inline bool matchesAt(const uint8_t* data, const uint8_t* needle, const uint8_t* fold, size_t size) {
+    for (size_t j = 0; j < size; ++j) {
+        if ((data[j] | fold[j]) != needle[j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+void floatRangeMask(const uint8_t* data, size_t count, float lo, float hi,
+                    bool hiInclusive, uint64_t* mask) {
+    std::fill(mask, mask + (count + 63) / 64, 0);
+    if (hiInclusive) {
+        floatRangeMaskImpl<true>(data, count, lo, hi, mask);
+    } else {
+        floatRangeMaskImpl<false>(data, count, lo, hi, mask);
+    }
+}
+
+void doubleRangeMask(const uint8_t* data, size_t count, double lo, double hi,
+                     bool hiInclusive, uint64_t* mask) {
+    std::fill(mask, mask + (count + 63) / 64, 0);
+    if (hiInclusive) {
+        doubleRangeMaskImpl<true>(data, count, lo, hi, mask);
+    } else {
+        doubleRangeMaskImpl<false>(data, count, lo, hi, mask);
+    }
+}
+
+size_t findString(const uint8_t* data, size_t size, const uint8_t* needle,
+                  const uint8_t* fold, size_t needleSize) {
+    if (needleSize == 0 || needleSize > size) {
+        return size;
+    }
+    
+    // Anchor on the last non-zero needle byte; the high bytes of UTF-16
+    // ASCII text are zero and would filter almost nothing
+    size_t last = needleSize - 1;
+    while (last > 0 && needle[last] == 0) {
+        --last;
+    }
+    
+    const size_t positions = size - needleSize + 1;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i firstByte = _mm256_set1_epi8(static_cast<char>(needle[0]));
+    const __m256i firstFold = _mm256_set1_epi8(static_cast<char>(fold[0]));
+    const __m256i lastByte = _mm256_set1_epi8(static_cast<char>(needle[last]));
+    const __m256i lastFold = _mm256_set1_epi8(static_cast<char>(fold[last]));
+    
+    for (; i + 32 <= positions; i += 32) {
+        __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + last));
+        __m256i hit = _mm256_and_si256(
+            _mm256_cmpeq_epi8(_mm256_or_si256(head, firstFold), firstByte),
+            _mm256_cmpeq_epi8(_mm256_or_si256(tail, lastFold), lastByte));
+        
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        while (bits) {
+            size_t pos = i + static_cast<size_t>(__builtin_ctz(bits));
+            if (matchesAt(data + pos, needle, fold, needleSize)) {
+                return pos;
+            }
+            bits &= bits - 1;
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i firstByte = _mm_set1_epi8(static_cast<char>(needle[0]));
+    const __m128i firstFold = _mm_set1_epi8(static_cast<char>(fold[0]));
+    const __m128i lastByte = _mm_set1_epi8(static_cast<char>(needle[last]));
+    const __m128i lastFold = _mm_set1_epi8(static_cast<char>(fold[last]));
+    
+    for (; i + 16 <= positions; i += 16) {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + last));
+        __m128i hit = _mm_and_si128(_mm_cmpeq_epi8(_mm_or_si128(head, firstFold), firstByte),
+                                    _mm_cmpeq_epi8(_mm_or_si128(tail, lastFold), lastByte));
+        
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        while (bits) {
+            size_t pos = i + static_cast<size_t>(__builtin_ctz(bits));
+            if (matchesAt(data + pos, needle, fold, needleSize)) {
+                return pos;
+            }
+            bits &= bits - 1;
+        }
+    }
+#endif
+    
+    for (; i < positions; ++i) {
+        if (matchesAt(data + i, needle, fold, needleSize)) {
+            return i;
+        }
+    }
+    
+    return size;
+}
+
+void float2RangeMask(const uint8_t* data, size_t floatCount, size_t pairCount, size_t floatStride,
+                     float loX, float hiX, float loY, float hiY,
+                     bool hiInclusive, uint64_t* mask) {
+    const size_t words = (floatCount + 63) / 64;
+    static thread_local std::vector<uint64_t> xMask;
+    static thread_local std::vector<uint64_t> yMask;
+    xMask.resize(words + 1);
+    yMask.resize(words + 1);
+    xMask[words] = 0;
+    yMask[words] = 0;
+    
+    // Both coordinates are tested over the same floats in one pass each
+    floatRangeMask(data, floatCount, loX, hiX, hiInclusive, xMask.data());
+    floatRangeMask(data, floatCount, loY, hiY, hiInclusive, yMask.data());
+    
+    std::fill(mask, mask + (pairCount + 63) / 64, 0);
+    
+    if (floatStride == 1) {
+        // Pair s matches when x bit s and y bit s + 1 are set
+        for (size_t w = 0; w < (pairCount + 63) / 64; ++w) {
+            uint64_t yShifted = (yMask[w] >> 1) | (yMask[w + 1] << 63);
+            mask[w] = xMask[w] & yShifted;
+        }
+        if (pairCount % 64) {
+            mask[pairCount / 64] &= (uint64_t(1) << (pairCount % 64)) - 1;
+        }
+        return;
+    }
+    
+    for (size_t s = 0; s < pairCount; ++s) {
+        size_t x = s * floatStride;
+        size_t y = x + 1;
+        if (y >= floatCount) {
+            break;
+        }
+        bool xHit = (xMask[x / 64] >> (x % 64)) & 1;
+        bool yHit = (yMask[y / 64] >> (y % 64)) & 1;
+        if (xHit && yHit) {
+            mask[s / 64] |= uint64_t(1) << (s % 64);
+        }
+    }
+}
+
+} // namespace scanner
\ No newline at end of file
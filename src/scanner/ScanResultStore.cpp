@@ -0,0 +1,267 @@
+#include "scanner/ScanResultStore.h"
+#include "scanner/PatternScanner.h"
+#include "memory/Pattern.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace scanner {
+
+SpillBuffer::~SpillBuffer() {
+    clear();
+}
+
+bool SpillBuffer::append(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    
+    if (!isSpilled()) {
+        m_heap.insert(m_heap.end(), bytes, bytes + size);
+        m_data = m_heap.data();
+        m_size = m_heap.size();
+        return true;
+    }
+    
+    if (m_size + size > m_capacity &&
+        !remap(std::max(m_capacity * 2, m_size + size))) {
+        return false;
+    }
+    
+    std::memcpy(m_data + m_size, bytes, size);
+    m_size += size;
+    return true;
+}
+
+void SpillBuffer::truncate(size_t size) {
+    if (size >= m_size) {
+        return;
+    }
+    
+    if (!isSpilled()) {
+        m_heap.resize(size);
+        m_data = m_heap.data();
+    }
+    m_size = size;
+}
+
+bool SpillBuffer::spill() {
+#if defined(_WIN32)
+    return false;
+#else
+    if (isSpilled()) {
+        return true;
+    }
+    
+    std::FILE* file = std::tmpfile();
+    if (!file) {
+        return false;
+    }
+    m_file = file;
+    
+    // Map before releasing the heap copy so nothing is lost on failure
+    std::vector<uint8_t> heap;
+    heap.swap(m_heap);
+    m_data = nullptr;
+    m_capacity = 0;
+    
+    if (!remap(std::max<size_t>(heap.size() * 2, 64 * 1024))) {
+        std::fclose(file);
+        m_file = nullptr;
+        m_heap.swap(heap);
+        m_data = m_heap.data();
+        return false;
+    }
+    
+    if (!heap.empty()) {
+        std::memcpy(m_data, heap.data(), heap.size());
+    }
+    return true;
+#endif
+}
+
+bool SpillBuffer::remap(size_t capacity) {
+#if defined(_WIN32)
+    (void)capacity;
+    return false;
+#else
+    int fd = fileno(static_cast<std::FILE*>(m_file));
+    if (ftruncate(fd, static_cast<off_t>(capacity)) != 0) {
+        return false;
+    }
+    
+    void* mapping = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    
+    // The file keeps the contents; the old view can simply go away
+    unmap();
+    m_data = static_cast<uint8_t*>(mapping);
+    m_capacity = capacity;
+    return true;
+#endif
+}
+
+void SpillBuffer::unmap() {
+#if !defined(_WIN32)
+    if (m_data && m_capacity) {
+        munmap(m_data, m_capacity);
+    }
+#endif
+    m_data = nullptr;
+    m_capacity = 0;
+}
+
+void SpillBuffer::clear() {
+    if (isSpilled()) {
+        unmap();
+        std::fclose(static_cast<std::FILE*>(m_file));
+        m_file = nullptr;
+    }
+    
+    m_heap.clear();
+    m_heap.shrink_to_fit();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+ScanResultStore::ScanResultStore(IMemoryProvider* memoryProvider, size_t spillThreshold)
+    : m_memoryProvider(memoryProvider), m_spillThreshold(spillThreshold) {}
+
+ScanResultStore::PatternId ScanResultStore::internPattern(const std::string& name, uint32_t length) {
+    std::string key = name;
+    key.push_back('\0');
+    key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    
+    auto it = m_patternIds.find(key);
+    if (it != m_patternIds.end()) {
+        return it->second;
+    }
+    
+    PatternId id = static_cast<PatternId>(m_patterns.size());
+    m_patterns.push_back(PatternInfo{name, length});
+    m_patternIds.emplace(std::move(key), id);
+    return id;
+}
+
+bool ScanResultStore::add(uintptr_t address, PatternId pattern) {
+    return appendHit(address, pattern, NO_BYTES);
+}
+
+bool ScanResultStore::add(uintptr_t address, PatternId pattern, const uint8_t* bytes) {
+    uint64_t offset = m_arena.size();
+    if (!m_arena.append(bytes, m_patterns[pattern].length)) {
+        return false;
+    }
+    if (!appendHit(address, pattern, offset)) {
+        m_arena.truncate(static_cast<size_t>(offset));
+        return false;
+    }
+    return true;
+}
+
+bool ScanResultStore::add(const memory::PatternResult& result) {
+    PatternId pattern = internPattern(result.patternName, static_cast<uint32_t>(result.matchedBytes.size()));
+    return add(result.address, pattern, result.matchedBytes.data());
+}
+
+bool ScanResultStore::appendHit(uintptr_t address, PatternId pattern, uint64_t byteOffset) {
+    const size_t rows = size();
+    const size_t offsetBytes = m_byteOffsets.size();
+    bool grown = true;
+    
+    // The offset column only exists once some hit has captured bytes
+    if (byteOffset != NO_BYTES && offsetBytes == 0) {
+        for (size_t i = 0; i < rows && grown; ++i) {
+            grown = m_byteOffsets.append(&NO_BYTES, sizeof(NO_BYTES));
+        }
+    }
+    
+    grown = grown && m_addresses.append(&address, sizeof(address)) &&
+            m_patternColumn.append(&pattern, sizeof(pattern));
+    if (grown && (m_byteOffsets.size() != 0 || byteOffset != NO_BYTES)) {
+        grown = m_byteOffsets.append(&byteOffset, sizeof(byteOffset));
+    }
+    if (!grown) {
+        // A spilled column could not be remapped; keep all columns at rows
+        m_addresses.truncate(rows * sizeof(address));
+        m_patternColumn.truncate(rows * sizeof(pattern));
+        m_byteOffsets.truncate(offsetBytes);
+        return false;
+    }
+    
+    if (m_spillThreshold && size() == m_spillThreshold) {
+        m_addresses.spill();
+        m_patternColumn.spill();
+        m_byteOffsets.spill();
+        m_arena.spill();
+    }
+    return true;
+}
+
+uintptr_t ScanResultStore::getAddress(size_t index) const {
+    uintptr_t address;
+    std::memcpy(&address, m_addresses.data() + index * sizeof(address), sizeof(address));
+    return address;
+}
+
+ScanResultStore::PatternId ScanResultStore::getPatternId(size_t index) const {
+    PatternId pattern;
+    std::memcpy(&pattern, m_patternColumn.data() + index * sizeof(pattern), sizeof(pattern));
+    return pattern;
+}
+
+bool ScanResultStore::getBytes(size_t index, std::vector<uint8_t>& out) const {
+    if (index >= size()) {
+        return false;
+    }
+    
+    const uint32_t length = m_patterns[getPatternId(index)].length;
+    
+    uint64_t offset = NO_BYTES;
+    if (m_byteOffsets.size() != 0) {
+        std::memcpy(&offset, m_byteOffsets.data() + index * sizeof(offset), sizeof(offset));
+    }
+    
+    if (offset != NO_BYTES) {
+        out.assign(m_arena.data() + offset, m_arena.data() + offset + length);
+        return true;
+    }
+    
+    out.resize(length);
+    return m_memoryProvider && m_memoryProvider->readMemory(getAddress(index), out.data(), length);
+}
+
+memory::PatternResult ScanResultStore::get(size_t index) const {
+    memory::PatternResult result(getAddress(index), getPatternName(getPatternId(index)));
+    if (!getBytes(index, result.matchedBytes)) {
+        result.matchedBytes.clear();
+    }
+    return result;
+}
+
+size_t ScanResultStore::memoryUsage() const {
+    size_t usage = sizeof(ScanResultStore) +
+                   m_addresses.heapUsage() + m_patternColumn.heapUsage() +
+                   m_byteOffsets.heapUsage() + m_arena.heapUsage() +
+                   m_patterns.capacity() * sizeof(PatternInfo);
+    for (const auto& pattern : m_patterns) {
+        usage += pattern.name.capacity();
+    }
+    return usage;
+}
+
+void ScanResultStore::clear() {
+    m_addresses.clear();
+    m_patternColumn.clear();
+    m_byteOffsets.clear();
+    m_arena.clear();
+    m_patterns.clear();
+    m_patternIds.clear();
+}
+
+} // namespace scanner
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include "scanner/ScanSession.h"
+#include "scanner/SnapshotStore.h"
+#include <unordered_set>
+
+namespace scanner {
+
+void ScanSession::start(std::vector<TypedCandidates> results, const std::string& label,
+                        std::shared_ptr<const SnapshotStore> snapshot) {
+    auto generation = std::make_shared<ScanGeneration>();
+    generation->results = std::move(results);
+    generation->snapshot = std::move(snapshot);
+    generation->depth = 0;
+    generation->label = label;
+    
+    m_current = std::move(generation);
+    m_redo.clear();
+}
+
+void ScanSession::commit(std::vector<TypedCandidates> results, const std::string& label) {
+    auto generation = std::make_shared<ScanGeneration>();
+    generation->results = std::move(results);
+    generation->parent = m_current;
+    generation->depth = m_current ? m_current->depth + 1 : 0;
+    generation->label = label;
+    
+    m_current = std::move(generation);
+    m_redo.clear();
+}
+
+bool ScanSession::undo() {
+    if (!canUndo()) {
+        return false;
+    }
+    
+    std::shared_ptr<const ScanGeneration> parent = m_current->parent;
+    m_redo.push_back(std::move(m_current));
+    m_current = std::move(parent);
+    return true;
+}
+
+bool ScanSession::redo() {
+    if (!canRedo()) {
+        return false;
+    }
+    
+    m_current = std::move(m_redo.back());
+    m_redo.pop_back();
+    return true;
+}
+
+std::vector<const ScanGeneration*> ScanSession::history() const {
+    std::vector<const ScanGeneration*> generations;
+    for (const ScanGeneration* generation = m_current.get(); generation;
+         generation = generation->parent.get()) {
+        generations.push_back(generation);
+    }
+    return generations;
+}
+
+size_t ScanSession::memoryUsage() const {
+    std::unordered_set<const void*> seen;
+    size_t total = sizeof(ScanSession);
+    
+    auto addGeneration = [&](const ScanGeneration* generation) {
+        if (!seen.insert(generation).second) {
+            return false;
+        }
+        
+        total += sizeof(ScanGeneration) + generation->label.capacity();
+        if (generation->snapshot && seen.insert(generation->snapshot.get()).second) {
+            total += generation->snapshot->memoryUsage();
+        }
+        
+        for (const auto& result : generation->results) {
+            const auto& blocks = result.candidates.getBlocks();
+            total += sizeof(TypedCandidates) + blocks.capacity() * sizeof(blocks[0]);
+            for (const auto& block : blocks) {
+                if (seen.insert(block.get()).second) {
+                    total += block->memoryUsage();
+                }
+            }
+        }
+        return true;
+    };
+    
+    // Redo entries share their ancestors with the current chain
+    std::vector<const ScanGeneration*> tips{m_current.get()};
+    for (const auto& generation : m_redo) {
+        tips.push_back(generation.get());
+    }
+    
+    for (const ScanGeneration* generation : tips) {
+        for (; generation && addGeneration(generation); generation = generation->parent.get()) {
+        }
+    }
+    
+    return total;
+}
+
+void ScanSession::clear() {
+    m_current.reset();
+    m_redo.clear();
+}
+
+} // namespace scanner
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include "scanner/SnapshotStore.h"
+#include "scanner/PatternScanner.h"
+#include <algorithm>
+#include <cstring>
+
+namespace scanner {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr int HASH_BITS = 12;
+constexpr uint16_t NO_POSITION = 0xFFFF;
+constexpr size_t CAPTURE_CHUNK = 16 * SNAPSHOT_PAGE_BYTES;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void writeLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void emitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                  size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) |
+                                         std::min<size_t>(matchCode, 15));
+    out.push_back(token);
+    
+    if (literalCount >= 15) {
+        writeLength(out, literalCount - 15);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+    
+    if (matchLength) {
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) {
+            writeLength(out, matchCode - 15);
+        }
+    }
+}
+
+bool readLength(const uint8_t* in, size_t inSize, size_t& ip, size_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= inSize) {
+            return false;
+        }
+        byte = in[ip++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // anonymous namespace
+
+size_t SnapshotStore::compressPage(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    out.clear();
+    if (size <= MIN_MATCH || size > SNAPSHOT_PAGE_BYTES) {
+        return 0;
+    }
+    
+    uint16_t table[1 << HASH_BITS];
+    std::fill(std::begin(table), std::end(table), NO_POSITION);
+    
+    size_t anchor = 0;
+    size_t pos = 0;
+    
+    while (pos + MIN_MATCH <= size) {
+        uint32_t sequence = read32(data + pos);
+        uint32_t slot = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        uint16_t candidate = table[slot];
+        table[slot] = static_cast<uint16_t>(pos);
+        
+        if (candidate == NO_POSITION || read32(data + candidate) != sequence) {
+            ++pos;
+            continue;
+        }
+        
+        size_t length = MIN_MATCH;
+        while (pos + length < size && data[candidate + length] == data[pos + length]) {
+            ++length;
+        }
+        
+        emitSequence(out, data + anchor, pos - anchor, pos - candidate, length);
+        pos += length;
+        anchor = pos;
+        
+        if (out.size() >= size) {
+            return 0;
+        }
+    }
+    
+    if (anchor < size) {
+        emitSequence(out, data + anchor, size - anchor, 0, 0);
+    }
+    
+    return out.size() < size ? out.size() : 0;
+}
+
+bool SnapshotStore::decompressPage(const uint8_t* in, size_t inSize, uint8_t* out, size_t size) {
+    size_t ip = 0;
+    size_t op = 0;
+    
+    while (ip < inSize) {
+        uint8_t token = in[ip++];
+        
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(in, inSize, ip, literalCount)) {
+            return false;
+        }
+        if (ip + literalCount > inSize || op + literalCount > size) {
+            return false;
+        }
+        std::memcpy(out + op, in + ip, literalCount);
+        ip += literalCount;
+        op += literalCount;
+        
+        if (op == size) {
+            break;
+        }
+        
+        if (ip + 2 > inSize) {
+            return false;
+        }
+        size_t offset = in[ip] | (static_cast<size_t>(in[ip + 1]) << 8);
+        ip += 2;
+        
+        size_t length = token & 0x0F;
+        if (length == 15 && !readLength(in, inSize, ip, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        
+        if (offset == 0 || offset > op || op + length > size) {
+            return false;
+        }
+        
+        // Byte-wise copy; matches may overlap their own output
+        for (size_t i = 0; i < length; ++i) {
+            out[op + i] = out[op - offset + i];
+        }
+        op += length;
+    }
+    
+    return op == size && ip == inSize;
+}
+
+size_t SnapshotStore::capture(IMemoryProvider& provider, const std::vector<MemoryRegion>& regions) {
+    std::vector<uint8_t> chunk(CAPTURE_CHUNK);
+    std::vector<bool> untouched;
+    size_t captured = 0;
+    
+    for (const auto& region : regions) {
+        for (uintptr_t chunkBase = region.base; chunkBase < region.end(); chunkBase += CAPTURE_CHUNK) {
+            size_t chunkSize = std::min(CAPTURE_CHUNK, static_cast<size_t>(region.end() - chunkBase));
+            
+            // A chunk the target never touched is known to be zeros
+            bool chunkRead;
+            if (chunkBase % IMemoryProvider::PAGE_STATE_BYTES == 0 &&
+                provider.getUntouchedPages(chunkBase, chunkSize, untouched) &&
+                std::find(untouched.begin(), untouched.end(), false) == untouched.end()) {
+                std::memset(chunk.data(), 0, chunkSize);
+                chunkRead = true;
+            } else {
+                chunkRead = provider.readMemory(chunkBase, chunk.data(), chunkSize);
+            }
+            
+            for (size_t offset = 0; offset < chunkSize; offset += SNAPSHOT_PAGE_BYTES) {
+                size_t pageSize = std::min(SNAPSHOT_PAGE_BYTES, chunkSize - offset);
+                uint8_t* page = chunk.data() + offset;
+                
+                // Fall back to page-sized reads around unreadable pages
+                if (!chunkRead && !provider.readMemory(chunkBase + offset, page, pageSize)) {
+                    continue;
+                }
+                
+                PageRecord record;
+                record.address = chunkBase + offset;
+                record.size = static_cast<uint32_t>(pageSize);
+                record.hash = hashBytes(page, pageSize);
+                
+                if (isZeroPage(page, pageSize)) {
+                    record.blobIndex = ZERO_PAGE;
+                    ++m_zeroPages;
+                } else {
+                    record.blobIndex = storePage(page, pageSize, record.hash);
+                }
+                
+                m_pages.push_back(record);
+                m_capturedBytes += pageSize;
+                ++captured;
+            }
+        }
+    }
+    
+    return captured;
+}
+
+uint32_t SnapshotStore::storePage(const uint8_t* data, size_t size, uint64_t hash) {
+    auto it = m_dedupe.find(hash);
+    if (it != m_dedupe.end()) {
+        // Verify to rule out a hash collision before sharing the blob
+        uint8_t existing[SNAPSHOT_PAGE_BYTES];
+        const Blob& blob = m_blobs[it->second];
+        if (blob.pageSize == size && decodeBlob(blob, existing) &&
+            std::memcmp(existing, data, size) == 0) {
+            return it->second;
+        }
+    }
+    
+    static thread_local std::vector<uint8_t> compressed;
+    size_t compressedSize = compressPage(data, size, compressed);
+    
+    Blob blob;
+    blob.offset = m_arena.size();
+    blob.pageSize = static_cast<uint32_t>(size);
+    blob.compressed = compressedSize != 0;
+    
+    if (blob.compressed) {
+        blob.storedSize = static_cast<uint32_t>(compressedSize);
+        m_arena.insert(m_arena.end(), compressed.begin(), compressed.begin() + compressedSize);
+    } else {
+        blob.storedSize = static_cast<uint32_t>(size);
+        m_arena.insert(m_arena.end(), data, data + size);
+    }
+    
+    uint32_t index = static_cast<uint32_t>(m_blobs.size());
+    m_blobs.push_back(blob);
+    m_dedupe.emplace(hash, index);
+    return index;
+}
+
+bool SnapshotStore::readPage(size_t index, uint8_t* out) const {
+    if (index >= m_pages.size()) {
+        return false;
+    }
+    
+    const PageRecord& page = m_pages[index];
+    if (page.blobIndex == ZERO_PAGE) {
+        std::memset(out, 0, page.size);
+        return true;
+    }
+    
+    return decodeBlob(m_blobs[page.blobIndex], out);
+}
+
+bool SnapshotStore::decodeBlob(const Blob& blob, uint8_t* out) const {
+    if (!blob.compressed) {
+        std::memcpy(out, m_arena.data() + blob.offset, blob.pageSize);
+        return true;
+    }
+    
+    return decompressPage(m_arena.data() + blob.offset, blob.storedSize, out, blob.pageSize);
+}
+
+size_t SnapshotStore::memoryUsage() const {
+    return sizeof(SnapshotStore) +
+           m_pages.capacity() * sizeof(PageRecord) +
+           m_blobs.capacity() * sizeof(Blob) +
+           m_arena.capacity() +
+           m_dedupe.bucket_count() * sizeof(void*) +
+           m_dedupe.size() * (sizeof(std::pair<uint64_t, uint32_t>) + sizeof(void*));
+}
+
+void SnapshotStore::clear() {
+    m_pages.clear();
+    m_pages.shrink_to_fit();
+    m_blobs.clear();
+    m_blobs.shrink_to_fit();
+    m_arena.clear();
+    m_arena.shrink_to_fit();
+    m_dedupe.clear();
+    m_capturedBytes = 0;
+    m_zeroPages = 0;
+}
+
+} // namespace scanner
\ No newline at end of file
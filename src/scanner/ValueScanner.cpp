@@ -0,0 +1,1169 @@
+#include "scanner/ValueScanner.h"
+#include "scanner/PatternScanner.h"
+#include "scanner/ScanKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace scanner {
+
+namespace {
+
+/**
+ * @brief Number of chunks sampled to pick a group scan anchor
+ */
+constexpr size_t GROUP_SAMPLE_CHUNKS = 16;
+
+/**
+ * @brief In-memory layout of a VECTOR2F value
+ */
+struct Vector2f {
+    float x;
+    float y;
+};
+
+template<typename T>
+T loadValue(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template<typename T>
+T clampToType(int64_t value) {
+    if (value < static_cast<int64_t>(std::numeric_limits<T>::min())) {
+        return std::numeric_limits<T>::min();
+    }
+    if (value > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+        return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(value);
+}
+
+int64_t saturatingAdd(int64_t a, int64_t b) {
+    int64_t result;
+    if (__builtin_add_overflow(a, b, &result)) {
+        return b > 0 ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min();
+    }
+    return result;
+}
+
+/**
+ * @brief Lower/upper bound of a range comparison
+ */
+template<typename T>
+struct ValueRange {
+    T lo;
+    T hi;
+    bool hiInclusive;
+    
+    bool contains(T value) const {
+        return value >= lo && (hiInclusive ? value <= hi : value < hi);
+    }
+};
+
+template<typename T>
+ValueRange<T> makeRange(ScanCompare compare, const ScanValue& value, const ScanValue& value2,
+                        double epsilon) {
+    ValueRange<T> range{T(), T(), true};
+    
+    if (std::is_floating_point<T>::value) {
+        double v = value.floatValue;
+        double eps = std::fabs(epsilon);
+        switch (compare) {
+            case ScanCompare::WITHIN:
+                range.lo = static_cast<T>(v - eps);
+                range.hi = static_cast<T>(v + eps);
+                break;
+            case ScanCompare::BETWEEN:
+                range.lo = static_cast<T>(std::min(v, value2.floatValue));
+                range.hi = static_cast<T>(std::max(v, value2.floatValue));
+                break;
+            case ScanCompare::ROUNDED:
+                range.lo = static_cast<T>(v - 0.5);
+                range.hi = static_cast<T>(v + 0.5);
+                range.hiInclusive = false;
+                break;
+            default:
+                range.lo = range.hi = static_cast<T>(v);
+                break;
+        }
+    } else {
+        int64_t v = value.intValue;
+        switch (compare) {
+            case ScanCompare::WITHIN: {
+                int64_t eps = static_cast<int64_t>(std::floor(std::fabs(epsilon)));
+                range.lo = clampToType<T>(saturatingAdd(v, -eps));
+                range.hi = clampToType<T>(saturatingAdd(v, eps));
+                break;
+            }
+            case ScanCompare::BETWEEN:
+                range.lo = clampToType<T>(std::min(v, value2.intValue));
+                range.hi = clampToType<T>(std::max(v, value2.intValue));
+                break;
+            default:
+                if (clampToType<T>(v) != v) {
+                    // Not representable; nothing can match
+                    range.lo = 1;
+                    range.hi = 0;
+                } else {
+                    range.lo = range.hi = static_cast<T>(v);
+                }
+                break;
+        }
+    }
+    
+    return range;
+}
+
+/**
+ * @brief Evaluates a scan comparison on raw value bytes
+ */
+template<typename T>
+class ValueMatcher {
+public:
+    explicit ValueMatcher(const ScanCriteria& criteria)
+        : m_compare(criteria.compare),
+          m_range(makeRange<T>(criteria.compare, criteria.value, criteria.value2, criteria.epsilon)) {}
+    
+    bool isRange() const {
+        return ScanCriteria(m_compare).isRange();
+    }
+    
+    const ValueRange<T>& getRange() const { return m_range; }
+    
+    bool operator()(const uint8_t* current, const uint8_t* previous) const {
+        switch (m_compare) {
+            case ScanCompare::CHANGED:
+                // Bitwise so that NaN payloads compare consistently
+                return std::memcmp(current, previous, sizeof(T)) != 0;
+            case ScanCompare::UNCHANGED:
+                return std::memcmp(current, previous, sizeof(T)) == 0;
+            case ScanCompare::INCREASED:
+                return loadValue<T>(current) > loadValue<T>(previous);
+            case ScanCompare::DECREASED:
+                return loadValue<T>(current) < loadValue<T>(previous);
+            default:
+                return m_range.contains(loadValue<T>(current));
+        }
+    }
+    
+private:
+    ScanCompare m_compare;
+    ValueRange<T> m_range;
+};
+
+template<>
+class ValueMatcher<Vector2f> {
+public:
+    explicit ValueMatcher(const ScanCriteria& criteria)
+        : m_compare(criteria.compare),
+          m_x(makeRange<float>(criteria.compare, criteria.value, ScanValue(), criteria.epsilon)),
+          m_y(makeRange<float>(criteria.compare, criteria.value2, ScanValue(), criteria.epsilon)) {
+        if (m_compare == ScanCompare::BETWEEN) {
+            // No single range describes a box from two scalar operands
+            m_x = ValueRange<float>{1.0f, 0.0f, true};
+            m_y = m_x;
+        }
+    }
+    
+    bool isRange() const {
+        return ScanCriteria(m_compare).isRange();
+    }
+    
+    const ValueRange<float>& getRangeX() const { return m_x; }
+    const ValueRange<float>& getRangeY() const { return m_y; }
+    
+    bool operator()(const uint8_t* current, const uint8_t* previous) const {
+        switch (m_compare) {
+            case ScanCompare::CHANGED:
+                return std::memcmp(current, previous, sizeof(Vector2f)) != 0;
+            case ScanCompare::UNCHANGED:
+                return std::memcmp(current, previous, sizeof(Vector2f)) == 0;
+            case ScanCompare::INCREASED:
+            case ScanCompare::DECREASED:
+                return false;
+            default: {
+                Vector2f value = loadValue<Vector2f>(current);
+                return m_x.contains(value.x) && m_y.contains(value.y);
+            }
+        }
+    }
+    
+private:
+    ScanCompare m_compare;
+    ValueRange<float> m_x;
+    ValueRange<float> m_y;
+};
+
+/**
+ * @brief Fill mask with range matches using a vector kernel
+ *
+ * @return false if no kernel applies to this type and alignment
+ */
+template<typename T>
+bool kernelRangeMask(const ValueMatcher<T>&, const uint8_t*, size_t, size_t, size_t, uint64_t*) {
+    return false;
+}
+
+template<>
+bool kernelRangeMask<float>(const ValueMatcher<float>& matcher, const uint8_t* data,
+                            size_t, size_t slotCount, size_t alignment, uint64_t* mask) {
+    if (!matcher.isRange() || alignment != sizeof(float)) {
+        return false;
+    }
+    const ValueRange<float>& range = matcher.getRange();
+    floatRangeMask(data, slotCount, range.lo, range.hi, range.hiInclusive, mask);
+    return true;
+}
+
+template<>
+bool kernelRangeMask<double>(const ValueMatcher<double>& matcher, const uint8_t* data,
+                             size_t, size_t slotCount, size_t alignment, uint64_t* mask) {
+    if (!matcher.isRange() || alignment != sizeof(double)) {
+        return false;
+    }
+    const ValueRange<double>& range = matcher.getRange();
+    doubleRangeMask(data, slotCount, range.lo, range.hi, range.hiInclusive, mask);
+    return true;
+}
+
+template<>
+bool kernelRangeMask<Vector2f>(const ValueMatcher<Vector2f>& matcher, const uint8_t* data,
+                               size_t dataSize, size_t slotCount, size_t alignment, uint64_t* mask) {
+    if (!matcher.isRange() || alignment % sizeof(float) != 0) {
+        return false;
+    }
+    // x and y share hiInclusive since both come from the same comparison
+    const ValueRange<float>& x = matcher.getRangeX();
+    const ValueRange<float>& y = matcher.getRangeY();
+    float2RangeMask(data, dataSize / sizeof(float), slotCount, alignment / sizeof(float),
+                    x.lo, x.hi, y.lo, y.hi, x.hiInclusive, mask);
+    return true;
+}
+
+/**
+ * @brief First-scan matcher for one type and alignment
+ *
+ * Evaluates all slots of a shared chunk buffer and appends one candidate
+ * block per chunk to its own result set. Slots sit at addresses congruent
+ * to phase modulo the alignment.
+ */
+class ChunkScanner {
+public:
+    virtual ~ChunkScanner() = default;
+    
+    /**
+     * @brief Scan the slots that start in [chunkBase, slotLimit)
+     *
+     * @param data Bytes read from chunkBase
+     * @param dataSize Number of bytes read; slots must end inside them
+     */
+    virtual void scan(uintptr_t chunkBase, const uint8_t* data, size_t dataSize,
+                      uintptr_t slotLimit, CandidateSet& out) = 0;
+    
+    /**
+     * @brief Check a single value against the criteria
+     */
+    virtual bool matches(const uint8_t* value) const = 0;
+};
+
+template<typename T>
+class TypedChunkScanner : public ChunkScanner {
+public:
+    TypedChunkScanner(const ScanCriteria& criteria, size_t alignment, size_t phase)
+        : m_matcher(criteria), m_alignment(alignment), m_phase(phase % alignment),
+          m_builder(sizeof(T)), m_mask((CandidateSet::BLOCK_BYTES / alignment + 64) / 64) {}
+    
+    void scan(uintptr_t chunkBase, const uint8_t* data, size_t dataSize,
+              uintptr_t slotLimit, CandidateSet& out) override {
+        // Slots are aligned in absolute terms, not relative to the region
+        uintptr_t firstSlot = chunkBase + (m_phase + m_alignment - chunkBase % m_alignment) % m_alignment;
+        uintptr_t dataEnd = chunkBase + dataSize;
+        if (firstSlot >= slotLimit || firstSlot + sizeof(T) > dataEnd) {
+            return;
+        }
+        
+        size_t slotCount = std::min((slotLimit - 1 - firstSlot) / m_alignment,
+                                    (dataEnd - sizeof(T) - firstSlot) / m_alignment) + 1;
+        const uint8_t* slots = data + (firstSlot - chunkBase);
+        size_t slotsSize = static_cast<size_t>(dataEnd - firstSlot);
+        
+        m_builder.reset(firstSlot, slotCount);
+        m_builder.hashPages(chunkBase, data, dataSize);
+        
+        if (kernelRangeMask<T>(m_matcher, slots, slotsSize, slotCount, m_alignment, m_mask.data())) {
+            for (size_t word = 0; word < (slotCount + 63) / 64; ++word) {
+                uint64_t bits = m_mask[word];
+                while (bits) {
+                    size_t slot = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                    m_builder.add(slot, slots + slot * m_alignment);
+                    bits &= bits - 1;
+                }
+            }
+        } else {
+            for (size_t slot = 0; slot < slotCount; ++slot) {
+                const uint8_t* value = slots + slot * m_alignment;
+                if (m_matcher(value, value)) {
+                    m_builder.add(slot, value);
+                }
+            }
+        }
+        
+        if (!m_builder.empty()) {
+            out.addBlock(m_builder.build());
+        }
+    }
+    
+    bool matches(const uint8_t* value) const override {
+        return m_matcher(value, value);
+    }
+    
+private:
+    ValueMatcher<T> m_matcher;
+    size_t m_alignment;
+    size_t m_phase;
+    CandidateBlockBuilder m_builder;
+    std::vector<uint64_t> m_mask;
+};
+
+std::unique_ptr<ChunkScanner> makeChunkScanner(ValueType type, const ScanCriteria& criteria,
+                                               size_t alignment, size_t phase = 0) {
+    switch (type) {
+        case ValueType::INT8:     return std::make_unique<TypedChunkScanner<int8_t>>(criteria, alignment, phase);
+        case ValueType::INT16:    return std::make_unique<TypedChunkScanner<int16_t>>(criteria, alignment, phase);
+        case ValueType::INT32:    return std::make_unique<TypedChunkScanner<int32_t>>(criteria, alignment, phase);
+        case ValueType::INT64:    return std::make_unique<TypedChunkScanner<int64_t>>(criteria, alignment, phase);
+        case ValueType::FLOAT:    return std::make_unique<TypedChunkScanner<float>>(criteria, alignment, phase);
+        case ValueType::DOUBLE:   return std::make_unique<TypedChunkScanner<double>>(criteria, alignment, phase);
+        case ValueType::VECTOR2F: return std::make_unique<TypedChunkScanner<Vector2f>>(criteria, alignment, phase);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief One chunk of a scanned region
+ */
+struct ScanChunk {
+    uintptr_t base;
+    uintptr_t regionEnd;
+};
+
+/**
+ * @brief Split regions into BLOCK_BYTES-sized chunks
+ */
+std::vector<ScanChunk> splitChunks(const std::vector<MemoryRegion>& regions) {
+    std::vector<ScanChunk> chunks;
+    for (const auto& region : regions) {
+        for (uintptr_t base = region.base; base < region.end(); base += CandidateSet::BLOCK_BYTES) {
+            chunks.push_back(ScanChunk{base, region.end()});
+        }
+    }
+    return chunks;
+}
+
+} // anonymous namespace
+
+static_assert(SNAPSHOT_PAGE_BYTES == IMemoryProvider::PAGE_STATE_BYTES,
+              "write tracking and page hashes must share a page size");
+
+/**
+ * @brief Pages the provider saw written since the last scan step
+ *
+ * Collected once per region up front, together with the next checkpoint.
+ * Pages outside those regions, and all pages when the provider cannot
+ * track writes, count as written.
+ */
+class WrittenPages {
+public:
+    WrittenPages() = default;
+    
+    /**
+     * @brief Page-aligned ranges covering the scan regions, in order
+     */
+    static std::vector<MemoryRegion> pageRanges(const std::vector<MemoryRegion>& regions) {
+        const size_t page = IMemoryProvider::PAGE_STATE_BYTES;
+        std::vector<MemoryRegion> ranges;
+        ranges.reserve(regions.size());
+        for (const auto& region : regions) {
+            uintptr_t base = region.base / page * page;
+            ranges.emplace_back(base, region.end() - base, region.protection);
+        }
+        return ranges;
+    }
+    
+    WrittenPages(const std::vector<MemoryRegion>& ranges, std::vector<std::vector<bool>>& written) {
+        for (size_t i = 0; i < ranges.size() && i < written.size(); ++i) {
+            if (!written[i].empty()) {
+                m_ranges.push_back(Range{ranges[i].base, std::move(written[i])});
+            }
+        }
+    }
+    
+    /**
+     * @brief Check if the tracking page starting at an address may have been written
+     */
+    bool contains(uintptr_t page) const {
+        auto it = std::upper_bound(m_ranges.begin(), m_ranges.end(), page,
+                                   [](uintptr_t address, const Range& range) { return address < range.base; });
+        if (it == m_ranges.begin()) {
+            return true;
+        }
+        --it;
+        size_t index = (page - it->base) / IMemoryProvider::PAGE_STATE_BYTES;
+        return index >= it->written.size() || it->written[index];
+    }
+    
+private:
+    struct Range {
+        uintptr_t base;
+        std::vector<bool> written;
+    };
+    
+    std::vector<Range> m_ranges;    ///< Sorted by base
+};
+
+size_t valueTypeSize(ValueType type) {
+    switch (type) {
+        case ValueType::INT8:     return 1;
+        case ValueType::INT16:    return 2;
+        case ValueType::INT32:    return 4;
+        case ValueType::INT64:    return 8;
+        case ValueType::FLOAT:    return 4;
+        case ValueType::DOUBLE:   return 8;
+        case ValueType::VECTOR2F: return 8;
+    }
+    return 0;
+}
+
+size_t valueTypeAlignment(ValueType type) {
+    return type == ValueType::VECTOR2F ? sizeof(float) : valueTypeSize(type);
+}
+
+const char* valueTypeName(ValueType type) {
+    switch (type) {
+        case ValueType::INT8:     return "int8";
+        case ValueType::INT16:    return "int16";
+        case ValueType::INT32:    return "int32";
+        case ValueType::INT64:    return "int64";
+        case ValueType::FLOAT:    return "float";
+        case ValueType::DOUBLE:   return "double";
+        case ValueType::VECTOR2F: return "vector2f";
+    }
+    return "unknown";
+}
+
+bool parseValueType(const std::string& name, ValueType& type) {
+    static const ValueType types[] = {
+        ValueType::INT8, ValueType::INT16, ValueType::INT32,
+        ValueType::INT64, ValueType::FLOAT, ValueType::DOUBLE,
+        ValueType::VECTOR2F
+    };
+    
+    for (ValueType candidate : types) {
+        if (name == valueTypeName(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* scanCompareName(ScanCompare compare) {
+    switch (compare) {
+        case ScanCompare::EXACT:     return "exact";
+        case ScanCompare::CHANGED:   return "changed";
+        case ScanCompare::UNCHANGED: return "unchanged";
+        case ScanCompare::INCREASED: return "increased";
+        case ScanCompare::DECREASED: return "decreased";
+        case ScanCompare::WITHIN:    return "within";
+        case ScanCompare::BETWEEN:   return "between";
+        case ScanCompare::ROUNDED:   return "rounded";
+    }
+    return "unknown";
+}
+
+bool parseScanCompare(const std::string& name, ScanCompare& compare) {
+    if (name == "exact") {
+        compare = ScanCompare::EXACT;
+    } else if (name == "changed") {
+        compare = ScanCompare::CHANGED;
+    } else if (name == "unchanged") {
+        compare = ScanCompare::UNCHANGED;
+    } else if (name == "increased") {
+        compare = ScanCompare::INCREASED;
+    } else if (name == "decreased") {
+        compare = ScanCompare::DECREASED;
+    } else if (name == "within") {
+        compare = ScanCompare::WITHIN;
+    } else if (name == "between") {
+        compare = ScanCompare::BETWEEN;
+    } else if (name == "rounded") {
+        compare = ScanCompare::ROUNDED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ScanValue ScanValue::fromInt(int64_t value) {
+    ScanValue result;
+    result.intValue = value;
+    result.floatValue = static_cast<double>(value);
+    return result;
+}
+
+ScanValue ScanValue::fromFloat(double value) {
+    ScanValue result;
+    result.floatValue = value;
+    result.intValue = std::isfinite(value) ? static_cast<int64_t>(std::floor(value + 0.5)) : 0;
+    return result;
+}
+
+ScanValue ScanValue::fromString(const std::string& text) {
+    if (text.empty()) {
+        throw std::invalid_argument("Value cannot be empty");
+    }
+    
+    size_t pos = 0;
+    bool isHex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+    
+    try {
+        if (!isHex && text.find_first_of(".eEnN") != std::string::npos) {
+            double value = std::stod(text, &pos);
+            if (pos == text.size()) {
+                return fromFloat(value);
+            }
+        } else {
+            int64_t value = std::stoll(text, &pos, isHex ? 16 : 10);
+            if (pos == text.size()) {
+                return fromInt(value);
+            }
+        }
+    } catch (const std::exception&) {
+        // Fall through to the error below
+    }
+    
+    throw std::invalid_argument("Invalid value: " + text);
+}
+
+void ScanValue::toBytes(ValueType type, uint8_t* out) const {
+    switch (type) {
+        case ValueType::INT8: {
+            int8_t v = static_cast<int8_t>(intValue);
+            std::memcpy(out, &v, sizeof(v));
+            break;
+        }
+        case ValueType::INT16: {
+            int16_t v = static_cast<int16_t>(intValue);
+            std::memcpy(out, &v, sizeof(v));
+            break;
+        }
+        case ValueType::INT32: {
+            int32_t v = static_cast<int32_t>(intValue);
+            std::memcpy(out, &v, sizeof(v));
+            break;
+        }
+        case ValueType::INT64: {
+            std::memcpy(out, &intValue, sizeof(intValue));
+            break;
+        }
+        case ValueType::FLOAT: {
+            float v = static_cast<float>(floatValue);
+            std::memcpy(out, &v, sizeof(v));
+            break;
+        }
+        case ValueType::DOUBLE: {
+            std::memcpy(out, &floatValue, sizeof(floatValue));
+            break;
+        }
+        case ValueType::VECTOR2F: {
+            // A single operand only carries one coordinate; it is used for both
+            Vector2f v{static_cast<float>(floatValue), static_cast<float>(floatValue)};
+            std::memcpy(out, &v, sizeof(v));
+            break;
+        }
+    }
+}
+
+ScanCriteria ScanCriteria::parse(const std::string& text) {
+    ScanCriteria criteria;
+    std::string body = text;
+    
+    if (!body.empty() && body[0] == '~') {
+        criteria.compare = ScanCompare::ROUNDED;
+        body = body.substr(1);
+    }
+    
+    size_t tilde = body.find('~');
+    if (tilde != std::string::npos) {
+        if (criteria.compare == ScanCompare::ROUNDED) {
+            throw std::invalid_argument("Invalid value: " + text);
+        }
+        criteria.compare = ScanCompare::WITHIN;
+        criteria.epsilon = ScanValue::fromString(body.substr(tilde + 1)).floatValue;
+        body = body.substr(0, tilde);
+    }
+    
+    size_t range = body.find("..");
+    size_t comma = body.find(',');
+    
+    if (range != std::string::npos) {
+        if (criteria.compare != ScanCompare::EXACT) {
+            throw std::invalid_argument("Invalid value: " + text);
+        }
+        criteria.compare = ScanCompare::BETWEEN;
+        criteria.value = ScanValue::fromString(body.substr(0, range));
+        criteria.value2 = ScanValue::fromString(body.substr(range + 2));
+    } else if (comma != std::string::npos) {
+        criteria.value = ScanValue::fromString(body.substr(0, comma));
+        criteria.value2 = ScanValue::fromString(body.substr(comma + 1));
+    } else {
+        criteria.value = ScanValue::fromString(body);
+    }
+    
+    return criteria;
+}
+
+ValueScanner::ValueScanner(IMemoryProvider* memoryProvider)
+    : m_memoryProvider(memoryProvider) {}
+
+bool ValueScanner::firstScan(ValueType type, const ScanCriteria& criteria, size_t alignment) {
+    return firstScan(std::vector<ScanTypeSpec>{ScanTypeSpec(type, alignment)}, criteria);
+}
+
+bool ValueScanner::firstScan(const std::vector<ScanTypeSpec>& types, const ScanCriteria& criteria) {
+    if (!m_memoryProvider || !criteria.isRange() || types.empty()) {
+        return false;
+    }
+    
+    std::vector<TypedCandidates> results;
+    bool tracking = false;
+    if (!rangeScan(types, criteria, results, tracking)) {
+        return false;
+    }
+    
+    std::string label = "first";
+    for (const auto& result : results) {
+        label += std::string(" ") + valueTypeName(result.type);
+    }
+    m_session.start(std::move(results), label + " " + scanCompareName(criteria.compare));
+    m_trackedGeneration = tracking ? m_session.current() : nullptr;
+    return true;
+}
+
+bool ValueScanner::rangeScan(const std::vector<ScanTypeSpec>& types, const ScanCriteria& criteria,
+                             std::vector<TypedCandidates>& results, bool& tracking) {
+    std::vector<std::unique_ptr<ChunkScanner>> scanners;
+    size_t maxValueSize = 0;
+    
+    for (const auto& spec : types) {
+        size_t valueSize = valueTypeSize(spec.type);
+        size_t alignment = spec.alignment ? spec.alignment : valueTypeAlignment(spec.type);
+        if (alignment > CandidateSet::BLOCK_BYTES) {
+            return false;
+        }
+        
+        results.push_back(TypedCandidates{spec.type, alignment, CandidateSet(valueSize, alignment)});
+        scanners.push_back(makeChunkScanner(spec.type, criteria, alignment));
+        maxValueSize = std::max(maxValueSize, valueSize);
+    }
+    
+    // Each chunk is read once, with enough overlap for values starting near
+    // its end, and handed to every type while it is in cache
+    std::vector<uint8_t> buffer(CandidateSet::BLOCK_BYTES + maxValueSize - 1);
+    tracking = m_memoryProvider->checkpointWrites();
+    
+    for (const auto& chunk : splitChunks(getScanRegions())) {
+        size_t readSize = std::min(buffer.size(), static_cast<size_t>(chunk.regionEnd - chunk.base));
+        if (!m_memoryProvider->readMemory(chunk.base, buffer.data(), readSize)) {
+            continue;
+        }
+        
+        uintptr_t slotLimit = std::min<uintptr_t>(chunk.base + CandidateSet::BLOCK_BYTES, chunk.regionEnd);
+        for (size_t i = 0; i < scanners.size(); ++i) {
+            scanners[i]->scan(chunk.base, buffer.data(), readSize, slotLimit, results[i].candidates);
+        }
+    }
+    return true;
+}
+
+bool ValueScanner::groupScan(const std::vector<GroupMember>& members, size_t alignment) {
+    if (!m_memoryProvider || members.empty()) {
+        return false;
+    }
+    
+    for (const auto& member : members) {
+        if (!member.criteria.isRange()) {
+            return false;
+        }
+    }
+    
+    const GroupMember& first = members.front();
+    if (alignment == 0) {
+        alignment = valueTypeAlignment(first.type);
+    }
+    if (alignment > CandidateSet::BLOCK_BYTES) {
+        return false;
+    }
+    
+    // The first member is aligned; member i sits at its address plus
+    // offset - first.offset, so its slots are shifted by that much
+    auto phaseOf = [alignment, &first](ptrdiff_t offset) {
+        ptrdiff_t phase = (offset - first.offset) % static_cast<ptrdiff_t>(alignment);
+        return static_cast<size_t>(phase < 0 ? phase + static_cast<ptrdiff_t>(alignment) : phase);
+    };
+    
+    std::vector<std::unique_ptr<ChunkScanner>> scanners;
+    size_t maxValueSize = 0;
+    for (const auto& member : members) {
+        scanners.push_back(makeChunkScanner(member.type, member.criteria, alignment, phaseOf(member.offset)));
+        maxValueSize = std::max(maxValueSize, valueTypeSize(member.type));
+    }
+    
+    std::vector<ScanChunk> chunks = splitChunks(getScanRegions());
+    std::vector<uint8_t> buffer(CandidateSet::BLOCK_BYTES + maxValueSize - 1);
+    CandidateSet hits(0, alignment);
+    const bool tracking = m_memoryProvider->checkpointWrites();
+    
+    auto readChunk = [&](const ScanChunk& chunk, size_t& readSize) {
+        readSize = std::min(buffer.size(), static_cast<size_t>(chunk.regionEnd - chunk.base));
+        return m_memoryProvider->readMemory(chunk.base, buffer.data(), readSize);
+    };
+    
+    // Anchor on the member with the fewest matches in an evenly spread sample
+    size_t anchor = 0;
+    if (members.size() > 1 && !chunks.empty()) {
+        std::vector<size_t> sampleCounts(members.size(), 0);
+        size_t samples = std::min(GROUP_SAMPLE_CHUNKS, chunks.size());
+        
+        for (size_t s = 0; s < samples; ++s) {
+            const ScanChunk& chunk = chunks[s * chunks.size() / samples];
+            size_t readSize;
+            if (!readChunk(chunk, readSize)) {
+                continue;
+            }
+            uintptr_t slotLimit = std::min<uintptr_t>(chunk.base + CandidateSet::BLOCK_BYTES, chunk.regionEnd);
+            for (size_t i = 0; i < members.size(); ++i) {
+                hits = CandidateSet(valueTypeSize(members[i].type), alignment);
+                scanners[i]->scan(chunk.base, buffer.data(), readSize, slotLimit, hits);
+                sampleCounts[i] += hits.count();
+            }
+        }
+        
+        for (size_t i = 1; i < members.size(); ++i) {
+            if (sampleCounts[i] < sampleCounts[anchor]) {
+                anchor = i;
+            }
+        }
+    }
+    
+    const ptrdiff_t anchorOffset = members[anchor].offset;
+    const size_t firstSize = valueTypeSize(first.type);
+    const size_t slotsPerBlock = CandidateSet::BLOCK_BYTES / alignment + 1;
+    
+    CandidateSet candidates(firstSize, alignment);
+    CandidateBlockBuilder builder(firstSize);
+    std::vector<uint8_t> value(maxValueSize);
+    
+    for (const auto& chunk : chunks) {
+        size_t readSize;
+        if (!readChunk(chunk, readSize)) {
+            continue;
+        }
+        
+        hits = CandidateSet(valueTypeSize(members[anchor].type), alignment);
+        uintptr_t slotLimit = std::min<uintptr_t>(chunk.base + CandidateSet::BLOCK_BYTES, chunk.regionEnd);
+        scanners[anchor]->scan(chunk.base, buffer.data(), readSize, slotLimit, hits);
+        if (hits.empty()) {
+            continue;
+        }
+        
+        // Results are the addresses of the first member, one block per chunk
+        uintptr_t blockBase = hits.getBlocks().front()->getBase() - anchorOffset + first.offset;
+        builder.reset(blockBase, slotsPerBlock);
+        
+        hits.forEach([&](uintptr_t address, const uint8_t*) {
+            uintptr_t groupBase = address - anchorOffset;
+            
+            // Verify the other members, from the chunk buffer when possible
+            auto load = [&](const GroupMember& member) -> const uint8_t* {
+                uintptr_t memberAddress = groupBase + member.offset;
+                size_t size = valueTypeSize(member.type);
+                if (memberAddress >= chunk.base && memberAddress + size <= chunk.base + readSize) {
+                    return buffer.data() + (memberAddress - chunk.base);
+                }
+                return m_memoryProvider->readMemory(memberAddress, value.data(), size) ? value.data() : nullptr;
+            };
+            
+            for (size_t i = 0; i < members.size(); ++i) {
+                if (i == anchor) {
+                    continue;
+                }
+                const uint8_t* data = load(members[i]);
+                if (!data || !scanners[i]->matches(data)) {
+                    return;
+                }
+            }
+            
+            const uint8_t* firstValue = load(first);
+            if (firstValue) {
+                builder.add((groupBase + first.offset - blockBase) / alignment, firstValue);
+            }
+        });
+        
+        if (!builder.empty()) {
+            candidates.addBlock(builder.build());
+        }
+    }
+    
+    std::vector<TypedCandidates> results;
+    results.push_back(TypedCandidates{first.type, alignment, std::move(candidates)});
+    m_session.start(std::move(results), "group of " + std::to_string(members.size()));
+    m_trackedGeneration = tracking ? m_session.current() : nullptr;
+    return true;
+}
+
+bool ValueScanner::firstScanUnknown(ValueType type, size_t alignment) {
+    if (!m_memoryProvider) {
+        return false;
+    }
+    
+    const size_t valueSize = valueTypeSize(type);
+    if (alignment == 0) {
+        alignment = valueTypeAlignment(type);
+    }
+    if (alignment > CandidateSet::BLOCK_BYTES) {
+        return false;
+    }
+    
+    auto snapshot = std::make_shared<SnapshotStore>();
+    const bool tracking = m_memoryProvider->checkpointWrites();
+    snapshot->capture(*m_memoryProvider, getScanRegions());
+    
+    std::vector<TypedCandidates> results;
+    results.push_back(TypedCandidates{type, alignment, CandidateSet(valueSize, alignment)});
+    m_session.start(std::move(results), std::string("unknown ") + valueTypeName(type), std::move(snapshot));
+    m_trackedGeneration = tracking ? m_session.current() : nullptr;
+    return true;
+}
+
+bool ValueScanner::nextScan(const ScanCriteria& criteria) {
+    if (!m_memoryProvider || !isActive()) {
+        return false;
+    }
+    
+    const ScanGeneration& parent = *m_session.current();
+    m_pageStats = PageScanStats();
+    
+    if (parent.snapshot && criteria.isRange()) {
+        // Nothing to compare against: scan all memory as a first scan would,
+        // but as a child of the snapshot so undo returns to it
+        std::vector<ScanTypeSpec> types;
+        for (const auto& result : parent.results) {
+            types.emplace_back(result.type, result.alignment);
+        }
+        std::vector<TypedCandidates> results;
+        bool tracking = false;
+        if (!rangeScan(types, criteria, results, tracking)) {
+            return false;
+        }
+        m_session.commit(std::move(results), scanCompareName(criteria.compare));
+        m_trackedGeneration = tracking ? m_session.current() : nullptr;
+        return true;
+    }
+    
+    // Collect the pages written since the parent was read and start the next
+    // interval in one step, so a write lands in one interval or the other
+    std::vector<MemoryRegion> ranges;
+    if (m_trackedGeneration == &parent && !criteria.isRange()) {
+        ranges = WrittenPages::pageRanges(getScanRegions());
+    }
+    std::vector<std::vector<bool>> flags;
+    const bool tracking = m_memoryProvider->collectWrittenPages(ranges, flags);
+    WrittenPages written(ranges, flags);
+    
+    std::vector<TypedCandidates> results;
+    for (const auto& result : parent.results) {
+        CandidateSet candidates(result.candidates.getValueSize(), result.candidates.getStride());
+        
+        if (parent.snapshot) {
+            switch (result.type) {
+                case ValueType::INT8:     snapshotScanTyped<int8_t>(criteria, result.alignment, written, candidates); break;
+                case ValueType::INT16:    snapshotScanTyped<int16_t>(criteria, result.alignment, written, candidates); break;
+                case ValueType::INT32:    snapshotScanTyped<int32_t>(criteria, result.alignment, written, candidates); break;
+                case ValueType::INT64:    snapshotScanTyped<int64_t>(criteria, result.alignment, written, candidates); break;
+                case ValueType::FLOAT:    snapshotScanTyped<float>(criteria, result.alignment, written, candidates); break;
+                case ValueType::DOUBLE:   snapshotScanTyped<double>(criteria, result.alignment, written, candidates); break;
+                case ValueType::VECTOR2F: snapshotScanTyped<Vector2f>(criteria, result.alignment, written, candidates); break;
+            }
+        } else {
+            const CandidateSet& in = result.candidates;
+            switch (result.type) {
+                case ValueType::INT8:     nextScanTyped<int8_t>(criteria, in, written, candidates); break;
+                case ValueType::INT16:    nextScanTyped<int16_t>(criteria, in, written, candidates); break;
+                case ValueType::INT32:    nextScanTyped<int32_t>(criteria, in, written, candidates); break;
+                case ValueType::INT64:    nextScanTyped<int64_t>(criteria, in, written, candidates); break;
+                case ValueType::FLOAT:    nextScanTyped<float>(criteria, in, written, candidates); break;
+                case ValueType::DOUBLE:   nextScanTyped<double>(criteria, in, written, candidates); break;
+                case ValueType::VECTOR2F: nextScanTyped<Vector2f>(criteria, in, written, candidates); break;
+            }
+        }
+        
+        results.push_back(TypedCandidates{result.type, result.alignment, std::move(candidates)});
+    }
+    
+    m_session.commit(std::move(results), scanCompareName(criteria.compare));
+    m_trackedGeneration = tracking ? m_session.current() : nullptr;
+    return true;
+}
+
+void ValueScanner::reset() {
+    m_session.clear();
+    m_trackedGeneration = nullptr;
+}
+
+ValueType ValueScanner::getValueType() const {
+    const auto& results = getResults();
+    return results.empty() ? ValueType::INT32 : results.front().type;
+}
+
+const CandidateSet& ValueScanner::getCandidates() const {
+    static const CandidateSet empty;
+    const auto& results = getResults();
+    return results.empty() ? empty : results.front().candidates;
+}
+
+const std::vector<TypedCandidates>& ValueScanner::getResults() const {
+    static const std::vector<TypedCandidates> empty;
+    return isActive() ? m_session.current()->results : empty;
+}
+
+const SnapshotStore* ValueScanner::getSnapshot() const {
+    return isActive() ? m_session.current()->snapshot.get() : nullptr;
+}
+
+std::vector<MemoryRegion> ValueScanner::getScanRegions() const {
+    std::vector<MemoryRegion> regions;
+    for (const auto& region : m_memoryProvider->getMemoryRegions()) {
+        if (region.isReadable() && region.isWritable()) {
+            regions.push_back(region);
+        }
+    }
+    return regions;
+}
+
+template<typename T>
+void ValueScanner::nextScanTyped(const ScanCriteria& criteria, const CandidateSet& in,
+                                 const WrittenPages& written, CandidateSet& out) {
+    const size_t valueSize = sizeof(T);
+    const size_t stride = in.getStride();
+    const size_t pageBytes = SNAPSHOT_PAGE_BYTES;
+    const bool relative = !criteria.isRange();
+    const ValueMatcher<T> matcher(criteria);
+    
+    CandidateBlockBuilder builder(valueSize);
+    std::vector<uint8_t> buffer;
+    std::vector<bool> samePage;
+    
+    for (const auto& block : in.getBlocks()) {
+        // Only re-read the span between the first and last surviving slot
+        size_t firstSlot = block->getSlotCount();
+        size_t lastSlot = 0;
+        block->forEach([&](size_t slot, size_t) {
+            firstSlot = std::min(firstSlot, slot);
+            lastSlot = slot;
+        });
+        
+        uintptr_t readBase = block->getBase() + firstSlot * stride;
+        uintptr_t readEnd = readBase + (lastSlot - firstSlot) * stride + valueSize;
+        
+        // Relative compares on a hashed block read its pages whole, so that
+        // pages whose hash did not change can skip the compare altogether
+        const auto& hashes = block->getPageHashes();
+        const uintptr_t hashBase = block->getPageBase();
+        if (relative && !hashes.empty()) {
+            readBase = std::min(readBase, hashBase);
+            readEnd = std::max<uintptr_t>(readEnd, hashBase + hashes.size() * pageBytes);
+        }
+        
+        // Pages the target did not write since the parent step need neither
+        // a read nor a hash; a block with no written pages is settled unread
+        const uintptr_t spanBase = readBase / pageBytes * pageBytes;
+        samePage.assign((readEnd - spanBase + pageBytes - 1) / pageBytes, false);
+        bool untouched = relative;
+        for (size_t page = 0; page < samePage.size(); ++page) {
+            samePage[page] = relative && !written.contains(spanBase + page * pageBytes);
+            untouched = untouched && samePage[page];
+        }
+        if (untouched) {
+            m_pageStats.pagesUntouched += samePage.size();
+            if (criteria.compare == ScanCompare::UNCHANGED) {
+                out.addBlock(block);
+            }
+            continue;
+        }
+        
+        size_t readSize = static_cast<size_t>(readEnd - readBase);
+        buffer.resize(readSize);
+        if (!m_memoryProvider->readMemory(readBase, buffer.data(), readSize)) {
+            // Region went away; its candidates cannot survive
+            continue;
+        }
+        
+        for (size_t page = 0; relative && page < samePage.size(); ++page) {
+            if (samePage[page]) {
+                ++m_pageStats.pagesUntouched;
+                continue;
+            }
+            
+            const uintptr_t address = spanBase + page * pageBytes;
+            if (address < hashBase || address >= hashBase + hashes.size() * pageBytes) {
+                continue;
+            }
+            const uint64_t hash = hashes[(address - hashBase) / pageBytes];
+            samePage[page] = hashBytes(buffer.data() + (address - readBase), pageBytes) == hash;
+            ++(samePage[page] ? m_pageStats.pagesSkipped : m_pageStats.pagesCompared);
+        }
+        
+        // A value whose pages are all unchanged still holds its previous
+        // bytes, which UNCHANGED keeps and every other relative compare drops
+        auto samePages = [&](uintptr_t address) {
+            size_t first = (address - spanBase) / pageBytes;
+            size_t last = (address + valueSize - 1 - spanBase) / pageBytes;
+            return last < samePage.size() && samePage[first] && samePage[last];
+        };
+        
+        // A block whose candidates all survive with identical bytes is
+        // shared with the previous generation instead of being rebuilt
+        bool unchanged = true;
+        builder.reset(block->getBase(), block->getSlotCount());
+        block->forEach([&](size_t slot, size_t rank) {
+            const uintptr_t address = block->getBase() + slot * stride;
+            const uint8_t* data = buffer.data() + (address - readBase);
+            const uint8_t* previous = block->getValue(rank);
+            if (relative && samePages(address)) {
+                if (criteria.compare == ScanCompare::UNCHANGED) {
+                    builder.add(slot, previous);
+                } else {
+                    unchanged = false;
+                }
+            } else if (matcher(data, previous)) {
+                builder.add(slot, data);
+                unchanged = unchanged && std::memcmp(data, previous, valueSize) == 0;
+            } else {
+                unchanged = false;
+            }
+        });
+        
+        if (unchanged) {
+            out.addBlock(block);
+        } else if (!builder.empty()) {
+            builder.hashPages(readBase, buffer.data(), readSize);
+            out.addBlock(builder.build());
+        }
+    }
+}
+
+template<typename T>
+void ValueScanner::snapshotScanTyped(const ScanCriteria& criteria, size_t alignment,
+                                     const WrittenPages& written, CandidateSet& out) {
+    const size_t valueSize = sizeof(T);
+    const size_t blockSpan = (CandidateSet::BLOCK_BYTES / alignment) * alignment;
+    const ValueMatcher<T> matcher(criteria);
+    
+    // Page buffers are prefixed with the tail of the previous page so that
+    // values straddling a page boundary can be compared as well
+    const size_t maxCarry = valueSize - 1;
+    std::vector<uint8_t> previous(SNAPSHOT_PAGE_BYTES + maxCarry);
+    std::vector<uint8_t> current(SNAPSHOT_PAGE_BYTES + maxCarry);
+    size_t carry = 0;
+    uintptr_t expectedAddress = 0;
+    
+    CandidateBlockBuilder builder(valueSize);
+    uintptr_t blockBase = 0;
+    bool building = false;
+    
+    const SnapshotStore& snapshot = *getSnapshot();
+    const auto& pages = snapshot.getPages();
+    for (size_t i = 0; i < pages.size(); ++i) {
+        const SnapshotStore::PageRecord& page = pages[i];
+        if (page.address != expectedAddress) {
+            carry = 0;
+        }
+        
+        // A page the target did not write since the capture is not read at
+        // all, and one that hashes as captured is not decompressed: either
+        // way it is its own previous contents
+        bool samePage = !criteria.isRange() && !written.contains(page.address);
+        bool available;
+        if (samePage) {
+            available = snapshot.readPage(i, current.data() + carry);
+            ++m_pageStats.pagesUntouched;
+        } else {
+            available = m_memoryProvider->readMemory(page.address, current.data() + carry, page.size);
+            samePage = available && !criteria.isRange() &&
+                       hashBytes(current.data() + carry, page.size) == page.hash;
+            if (samePage) {
+                ++m_pageStats.pagesSkipped;
+            } else if (available) {
+                available = snapshot.readPage(i, previous.data() + carry);
+                ++m_pageStats.pagesCompared;
+            }
+        }
+        
+        if (!available) {
+            carry = 0;
+            expectedAddress = 0;
+            continue;
+        }
+        if (samePage) {
+            std::memcpy(previous.data() + carry, current.data() + carry, page.size);
+        }
+        
+        uintptr_t windowBase = page.address - carry;
+        uintptr_t windowEnd = page.address + page.size;
+        uintptr_t address = (windowBase + alignment - 1) / alignment * alignment;
+        
+        for (; address + valueSize <= windowEnd; address += alignment) {
+            const uint8_t* now = current.data() + (address - windowBase);
+            const uint8_t* before = previous.data() + (address - windowBase);
+            
+            // Values wholly inside an unchanged page only match UNCHANGED;
+            // those straddling in from the previous page are compared
+            if (samePage && address >= page.address) {
+                if (criteria.compare != ScanCompare::UNCHANGED) {
+                    break;
+                }
+            } else if (!matcher(now, before)) {
+                continue;
+            }
+            
+            uintptr_t slotBlock = address / blockSpan * blockSpan;
+            if (!building || slotBlock != blockBase) {
+                if (building && !builder.empty()) {
+                    out.addBlock(builder.build());
+                }
+                blockBase = slotBlock;
+                builder.reset(blockBase, blockSpan / alignment);
+                building = true;
+            }
+            builder.add((address - blockBase) / alignment, now);
+        }
+        
+        size_t windowSize = static_cast<size_t>(windowEnd - windowBase);
+        carry = std::min(maxCarry, windowSize);
+        std::memmove(previous.data(), previous.data() + windowSize - carry, carry);
+        std::memmove(current.data(), current.data() + windowSize - carry, carry);
+        expectedAddress = windowEnd;
+    }
+    
+    if (building && !builder.empty()) {
+        out.addBlock(builder.build());
+    }
+}
+
+} // namespace scanner
\ No newline at end of file
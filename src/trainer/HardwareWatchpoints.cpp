@@ -0,0 +1,457 @@
+#include "trainer/HardwareWatchpoints.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__) && defined(__x86_64__)
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <dirent.h>
+#include <sys/ptrace.h>
+#include <sys/syscall.h>
+#include <sys/user.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace trainer {
+
+namespace {
+
+/**
+ * @brief How long a caller waits for the tracer before signalling it again
+ */
+constexpr std::chrono::milliseconds WAKE_RETRY{10};
+
+#if defined(__linux__) && defined(__x86_64__)
+
+constexpr int WAKE_SIGNAL = SIGUSR2;
+constexpr long DR6_HIT_MASK = 0xF;
+
+void onWakeSignal(int) {}
+
+/**
+ * @brief Install the no-op wake handler without SA_RESTART, so that the
+ * tracer's waitpid() returns EINTR
+ */
+void installWakeHandler() {
+    static bool installed = [] {
+        struct sigaction action {};
+        action.sa_handler = onWakeSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = 0;
+        return sigaction(WAKE_SIGNAL, &action, nullptr) == 0;
+    }();
+    (void)installed;
+}
+
+long debugRegisterOffset(int index) {
+    return static_cast<long>(offsetof(struct user, u_debugreg) + index * sizeof(long));
+}
+
+bool writeDebugRegister(pid_t tid, int index, unsigned long value) {
+    return ptrace(PTRACE_POKEUSER, tid, debugRegisterOffset(index), value) == 0;
+}
+
+/**
+ * @brief Build DR7 for the active slots: local enable, R/W and LEN fields
+ */
+unsigned long buildDr7(const bool active[], const size_t lengths[], const WatchpointKind kinds[]) {
+    unsigned long dr7 = 0;
+    for (int i = 0; i < HardwareWatchpoints::SLOTS; ++i) {
+        if (!active[i]) {
+            continue;
+        }
+        
+        unsigned long rw = 0;
+        switch (kinds[i]) {
+            case WatchpointKind::EXECUTE:    rw = 0; break;
+            case WatchpointKind::WRITE:      rw = 1; break;
+            case WatchpointKind::READ_WRITE: rw = 3; break;
+        }
+        
+        unsigned long len = 0;
+        switch (lengths[i]) {
+            case 2: len = 1; break;
+            case 4: len = 3; break;
+            case 8: len = 2; break;
+            default: len = 0; break;
+        }
+        
+        dr7 |= 1ul << (i * 2);
+        dr7 |= (rw | (len << 2)) << (16 + i * 4);
+    }
+    return dr7;
+}
+
+/**
+ * @brief Check if a thread has a SIGTRAP queued that it has not reported yet
+ */
+bool hasPendingTrap(pid_t pid, pid_t tid) {
+    std::ifstream status("/proc/" + std::to_string(pid) + "/task/" + std::to_string(tid) + "/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 7, "SigPnd:") == 0) {
+            unsigned long long pending = std::strtoull(line.c_str() + 7, nullptr, 16);
+            return (pending & (1ull << (SIGTRAP - 1))) != 0;
+        }
+    }
+    return false;
+}
+
+std::vector<pid_t> listThreads(pid_t pid) {
+    std::vector<pid_t> threads;
+    std::string path = "/proc/" + std::to_string(pid) + "/task";
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return threads;
+    }
+    
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            threads.push_back(static_cast<pid_t>(std::atol(entry->d_name)));
+        }
+    }
+    closedir(dir);
+    return threads;
+}
+
+RegisterContext toContext(const user_regs_struct& regs) {
+    return RegisterContext{regs.rax, regs.rbx, regs.rcx, regs.rdx, regs.rsi, regs.rdi, regs.rbp, regs.rsp,
+                           regs.r8, regs.r9, regs.r10, regs.r11, regs.r12, regs.r13, regs.r14, regs.r15,
+                           regs.rip, regs.eflags};
+}
+
+#endif
+
+} // anonymous namespace
+
+HardwareWatchpoints::HardwareWatchpoints(int processId, size_t capacity)
+    : m_processId(processId), m_capacity(std::max<size_t>(capacity, 1)) {
+    m_hits.resize(m_capacity);
+}
+
+HardwareWatchpoints::~HardwareWatchpoints() {
+    detach();
+}
+
+bool HardwareWatchpoints::isAttached() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_attached;
+}
+
+int HardwareWatchpoints::set(uintptr_t address, size_t length, WatchpointKind kind) {
+    if ((length != 1 && length != 2 && length != 4 && length != 8) || address % length != 0 ||
+        (kind == WatchpointKind::EXECUTE && length != 1)) {
+        return -1;
+    }
+    
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (int i = 0; i < SLOTS; ++i) {
+        if (!m_slots[i].active) {
+            m_slots[i] = Slot{true, address, length, kind};
+            ++m_version;
+            waitApplied(lock);
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool HardwareWatchpoints::clear(int slot) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (slot < 0 || slot >= SLOTS || !m_slots[slot].active) {
+        return false;
+    }
+    
+    m_slots[slot] = Slot{};
+    ++m_version;
+    waitApplied(lock);
+    
+    for (auto it = m_sites.begin(); it != m_sites.end();) {
+        it = it->first.first == slot ? m_sites.erase(it) : std::next(it);
+    }
+    return true;
+}
+
+size_t HardwareWatchpoints::drain(std::vector<WatchpointHit>& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = m_hitCount;
+    size_t first = (m_hitHead + m_capacity - m_hitCount) % m_capacity;
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(m_hits[(first + i) % m_capacity]);
+    }
+    m_hitCount = 0;
+    return count;
+}
+
+std::vector<AccessSite> HardwareWatchpoints::getAccessSites() const {
+    std::vector<AccessSite> sites;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& site : m_sites) {
+            sites.push_back(AccessSite{site.first.first, site.first.second, site.second});
+        }
+    }
+    
+    std::stable_sort(sites.begin(), sites.end(), [](const AccessSite& a, const AccessSite& b) {
+        return a.hits > b.hits;
+    });
+    return sites;
+}
+
+uintptr_t HardwareWatchpoints::getAddress(int slot) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return slot >= 0 && slot < SLOTS && m_slots[slot].active ? m_slots[slot].address : 0;
+}
+
+WatchpointStats HardwareWatchpoints::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void HardwareWatchpoints::recordHit(unsigned slotMask, int threadId, const RegisterContext& registers) {
+    for (int i = 0; i < SLOTS; ++i) {
+        if (!(slotMask & (1u << i)) || !m_slots[i].active) {
+            continue;
+        }
+        
+        m_hits[m_hitHead] = WatchpointHit{i, threadId, m_slots[i].address, registers.rip, registers};
+        m_hitHead = (m_hitHead + 1) % m_capacity;
+        if (m_hitCount == m_capacity) {
+            ++m_stats.dropped;
+        } else {
+            ++m_hitCount;
+        }
+        
+        ++m_sites[{i, registers.rip}];
+        ++m_stats.hits;
+    }
+}
+
+#if defined(__linux__) && defined(__x86_64__)
+
+bool HardwareWatchpoints::attach() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_tracerDone) {
+        return m_attached;
+    }
+    if (m_tracer.joinable()) {
+        m_tracer.join();
+    }
+    
+    installWakeHandler();
+    m_tracerDone = false;
+    m_detachRequested = false;
+    m_tracer = std::thread(&HardwareWatchpoints::trace, this);
+    
+    m_changed.wait(lock, [this] { return m_attached || m_tracerDone; });
+    return m_attached;
+}
+
+void HardwareWatchpoints::detach() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_attached) {
+        m_detachRequested = true;
+        ++m_version;
+        waitApplied(lock);
+    }
+    lock.unlock();
+    
+    if (m_tracer.joinable()) {
+        m_tracer.join();
+    }
+}
+
+void HardwareWatchpoints::waitApplied(std::unique_lock<std::mutex>& lock) {
+    uint64_t version = m_version;
+    while (!m_tracerDone && m_attached && m_appliedVersion < version) {
+        syscall(SYS_tgkill, getpid(), m_tracerThreadId, WAKE_SIGNAL);
+        m_changed.wait_for(lock, WAKE_RETRY);
+    }
+}
+
+void HardwareWatchpoints::trace() {
+    sigset_t wake;
+    sigemptyset(&wake);
+    sigaddset(&wake, WAKE_SIGNAL);
+    pthread_sigmask(SIG_UNBLOCK, &wake, nullptr);
+    
+    const pid_t pid = static_cast<pid_t>(m_processId);
+    std::map<pid_t, uint64_t> threads;     // tid -> version of its debug registers
+    
+    auto seize = [&](pid_t tid) {
+        if (ptrace(PTRACE_SEIZE, tid, nullptr, reinterpret_cast<void*>(PTRACE_O_TRACECLONE)) != 0) {
+            return false;
+        }
+        ptrace(PTRACE_INTERRUPT, tid, nullptr, nullptr);
+        threads[tid] = 0;
+        return true;
+    };
+    
+    // Seize the main thread first so that a denied attach leaves nothing
+    // traced, then repeat until no thread appeared while seizing the others
+    bool attached = seize(pid);
+    for (bool added = attached; added;) {
+        added = false;
+        for (pid_t tid : listThreads(pid)) {
+            if (!threads.count(tid) && seize(tid)) {
+                added = true;
+            }
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tracerThreadId = static_cast<int>(syscall(SYS_gettid));
+        m_attached = attached;
+        m_stats.threads = threads.size();
+        if (!attached) {
+            m_tracerDone = true;
+        }
+    }
+    m_changed.notify_all();
+    if (!attached) {
+        return;
+    }
+    
+    uint64_t version = 0;           // Version the tracer works towards
+    bool detaching = false;
+    unsigned long addresses[SLOTS] = {};
+    unsigned long dr7 = 0;
+    
+    while (!threads.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (version != m_version) {
+                version = m_version;
+                detaching = m_detachRequested;
+                
+                bool active[SLOTS];
+                size_t lengths[SLOTS];
+                WatchpointKind kinds[SLOTS];
+                for (int i = 0; i < SLOTS; ++i) {
+                    active[i] = m_slots[i].active && !detaching;
+                    lengths[i] = m_slots[i].length;
+                    kinds[i] = m_slots[i].kind;
+                    addresses[i] = active[i] ? m_slots[i].address : 0;
+                }
+                dr7 = buildDr7(active, lengths, kinds);
+                
+                // Every thread picks the new registers up at its next stop
+                for (const auto& thread : threads) {
+                    ptrace(PTRACE_INTERRUPT, thread.first, nullptr, nullptr);
+                }
+            }
+        }
+        
+        int status = 0;
+        pid_t tid = waitpid(-1, &status, __WALL);
+        if (tid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        
+        auto it = threads.find(tid);
+        if (WIFEXITED(status) || WIFSIGNALED(status)) {
+            if (it != threads.end()) {
+                threads.erase(it);
+            }
+        } else if (WIFSTOPPED(status)) {
+            if (it == threads.end()) {
+                // A new thread can stop before its creator reports the clone
+                it = threads.emplace(tid, 0).first;
+            }
+            
+            int signal = WSTOPSIG(status);
+            int event = status >> 16;
+            int inject = 0;
+            bool groupStop = false;
+            
+            if (event == PTRACE_EVENT_CLONE) {
+                unsigned long child = 0;
+                if (ptrace(PTRACE_GETEVENTMSG, tid, nullptr, &child) == 0) {
+                    threads.emplace(static_cast<pid_t>(child), 0);
+                }
+            } else if (event == PTRACE_EVENT_STOP) {
+                groupStop = signal == SIGSTOP || signal == SIGTSTP || signal == SIGTTIN || signal == SIGTTOU;
+            } else if (signal == SIGTRAP) {
+                errno = 0;
+                long dr6 = ptrace(PTRACE_PEEKUSER, tid, debugRegisterOffset(6), nullptr);
+                user_regs_struct regs{};
+                if (errno == 0 && (dr6 & DR6_HIT_MASK) &&
+                    ptrace(PTRACE_GETREGS, tid, nullptr, &regs) == 0) {
+                    writeDebugRegister(tid, 6, 0);
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    recordHit(static_cast<unsigned>(dr6 & DR6_HIT_MASK), tid, toContext(regs));
+                } else {
+                    inject = SIGTRAP;
+                }
+            } else {
+                inject = signal;
+            }
+            
+            if (it->second != version) {
+                // Disable first: the kernel validates DR7 against the addresses
+                writeDebugRegister(tid, 7, 0);
+                for (int i = 0; i < SLOTS; ++i) {
+                    writeDebugRegister(tid, i, addresses[i]);
+                }
+                writeDebugRegister(tid, 7, dr7);
+                it->second = version;
+            }
+            
+            if (detaching && !hasPendingTrap(pid, tid)) {
+                // A queued trap would kill the target once it is no longer traced
+                ptrace(PTRACE_DETACH, tid, nullptr, reinterpret_cast<void*>(static_cast<long>(inject)));
+                threads.erase(it);
+            } else {
+                ptrace(groupStop ? PTRACE_LISTEN : PTRACE_CONT, tid, nullptr,
+                       reinterpret_cast<void*>(static_cast<long>(inject)));
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.threads = threads.size();
+        bool applied = std::all_of(threads.begin(), threads.end(),
+                                   [version](const std::pair<const pid_t, uint64_t>& thread) {
+                                       return thread.second == version;
+                                   });
+        if (applied && m_appliedVersion != version) {
+            m_appliedVersion = version;
+            m_changed.notify_all();
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_attached = false;
+        m_tracerDone = true;
+        m_stats.threads = 0;
+        for (Slot& slot : m_slots) {
+            slot = Slot{};
+        }
+    }
+    m_changed.notify_all();
+}
+
+#else
+
+bool HardwareWatchpoints::attach() {
+    return false;
+}
+
+void HardwareWatchpoints::detach() {}
+
+void HardwareWatchpoints::waitApplied(std::unique_lock<std::mutex>&) {}
+
+void HardwareWatchpoints::trace() {}
+
+#endif
+
+} // namespace trainer
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "trainer/ValueFreezer.h"
+#include "scanner/PatternScanner.h"
+#include <algorithm>
+
+namespace trainer {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void updateMax(std::atomic<uint64_t>& max, uint64_t value) {
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // anonymous namespace
+
+ValueFreezer::ValueFreezer(scanner::IMemoryProvider* memoryProvider, unsigned rateHz)
+    : m_memoryProvider(memoryProvider), m_rateHz(std::max(rateHz, 1u)),
+      m_plan(std::make_shared<WritePlan>()) {}
+
+ValueFreezer::~ValueFreezer() {
+    stop();
+}
+
+bool ValueFreezer::freeze(uintptr_t address, scanner::ValueType type, const scanner::ScanValue& value) {
+    if (!m_memoryProvider) {
+        return false;
+    }
+    
+    std::vector<uint8_t> bytes(scanner::valueTypeSize(type));
+    value.toBytes(type, bytes.data());
+    if (!m_memoryProvider->writeMemory(address, bytes.data(), bytes.size())) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[address] = FrozenValue{address, type, value};
+    rebuildPlan();
+    return true;
+}
+
+bool ValueFreezer::unfreeze(uintptr_t address) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.erase(address) == 0) {
+        return false;
+    }
+    rebuildPlan();
+    return true;
+}
+
+void ValueFreezer::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    rebuildPlan();
+}
+
+std::vector<FrozenValue> ValueFreezer::getEntries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<FrozenValue> entries;
+    for (const auto& entry : m_entries) {
+        entries.push_back(entry.second);
+    }
+    return entries;
+}
+
+size_t ValueFreezer::writesPerTick() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_plan->writes.size();
+}
+
+void ValueFreezer::setRate(unsigned rateHz) {
+    m_rateHz = std::max(rateHz, 1u);
+    m_wake.notify_all();
+}
+
+bool ValueFreezer::start() {
+    if (isRunning()) {
+        return false;
+    }
+    
+    m_stopping = false;
+    m_thread = std::thread(&ValueFreezer::run, this);
+    return true;
+}
+
+void ValueFreezer::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+size_t ValueFreezer::tick() {
+    const Clock::time_point begin = Clock::now();
+    
+    std::shared_ptr<const WritePlan> plan;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        plan = m_plan;
+    }
+    
+    std::vector<scanner::WriteResult> results;
+    size_t succeeded = plan->writes.empty() ? 0 : m_memoryProvider->writeMemoryBatch(plan->writes, results);
+    
+    const uint64_t nanos = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count());
+    m_ticks.fetch_add(1, std::memory_order_relaxed);
+    m_writes.fetch_add(plan->writes.size(), std::memory_order_relaxed);
+    m_failedWrites.fetch_add(plan->writes.size() - succeeded, std::memory_order_relaxed);
+    m_totalTickNanos.fetch_add(nanos, std::memory_order_relaxed);
+    updateMax(m_maxTickNanos, nanos);
+    return succeeded;
+}
+
+FreezerStats ValueFreezer::getStats() const {
+    FreezerStats stats;
+    stats.ticks = m_ticks.load(std::memory_order_relaxed);
+    stats.writes = m_writes.load(std::memory_order_relaxed);
+    stats.failedWrites = m_failedWrites.load(std::memory_order_relaxed);
+    stats.overruns = m_overruns.load(std::memory_order_relaxed);
+    stats.maxTickNanos = m_maxTickNanos.load(std::memory_order_relaxed);
+    stats.totalTickNanos = m_totalTickNanos.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ValueFreezer::rebuildPlan() {
+    auto plan = std::make_shared<WritePlan>();
+    std::vector<WriteSpan> spans;
+    
+    // Entries are in address order; one that starts at or before the end of
+    // the current span extends it, and later entries win where they overlap
+    for (const auto& entry : m_entries) {
+        const FrozenValue& frozen = entry.second;
+        const size_t size = scanner::valueTypeSize(frozen.type);
+        
+        if (spans.empty() || frozen.address > spans.back().address + spans.back().size) {
+            spans.push_back(WriteSpan{frozen.address, plan->bytes.size(), 0});
+        }
+        
+        WriteSpan& span = spans.back();
+        const size_t start = frozen.address - span.address;
+        if (start + size > span.size) {
+            plan->bytes.resize(span.offset + start + size);
+            span.size = start + size;
+        }
+        frozen.value.toBytes(frozen.type, plan->bytes.data() + span.offset + start);
+    }
+    
+    // The byte buffer is final now, so the writes can point into it
+    for (const auto& span : spans) {
+        plan->writes.push_back(scanner::MemoryWrite{span.address, plan->bytes.data() + span.offset, span.size});
+    }
+    
+    m_plan = std::move(plan);
+}
+
+void ValueFreezer::run() {
+    Clock::time_point deadline = Clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    while (!m_stopping) {
+        lock.unlock();
+        tick();
+        lock.lock();
+        
+        // Deadlines advance by whole periods so the rate does not drift; a
+        // missed deadline is counted and skipped rather than caught up in a burst
+        deadline += std::chrono::nanoseconds(1000000000 / m_rateHz.load());
+        const Clock::time_point now = Clock::now();
+        if (deadline < now) {
+            m_overruns.fetch_add(1, std::memory_order_relaxed);
+            deadline = now;
+        }
+        
+        m_wake.wait_until(lock, deadline, [this] { return m_stopping; });
+    }
+}
+
+} // namespace trainer
\ No newline at end of file
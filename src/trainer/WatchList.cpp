@@ -0,0 +1,242 @@
+#include "trainer/WatchList.h"
+#include <algorithm>
+
+namespace trainer {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // anonymous namespace
+
+WatchList::WatchList(scanner::IMemoryProvider* memoryProvider,
+                     std::chrono::milliseconds minInterval,
+                     std::chrono::milliseconds maxInterval)
+    : m_memoryProvider(memoryProvider),
+      m_minInterval(std::max(minInterval, std::chrono::milliseconds(1))),
+      m_maxInterval(std::max(maxInterval, m_minInterval)) {}
+
+WatchList::~WatchList() {
+    stop();
+}
+
+WatchId WatchList::add(uintptr_t address, scanner::ValueType type) {
+    PointerChain chain;
+    chain.base = address;
+    return add(chain, type);
+}
+
+WatchId WatchList::add(const PointerChain& chain, scanner::ValueType type) {
+    WatchId id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        id = m_nextId++;
+        
+        Slot& slot = m_slots[id];
+        slot.entry = WatchEntry{id, chain, type, 0, {}, m_minInterval, 0};
+        slot.entry.chain.pointerSize = std::min<size_t>(std::max<size_t>(chain.pointerSize, 1), sizeof(uint64_t));
+        slot.due = Clock::time_point::min();
+        m_rescheduled = true;
+    }
+    m_wake.notify_all();
+    return id;
+}
+
+bool WatchList::remove(WatchId id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slots.erase(id) != 0;
+}
+
+std::vector<WatchEntry> WatchList::getEntries() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<WatchEntry> entries;
+    for (const auto& slot : m_slots) {
+        entries.push_back(slot.second.entry);
+    }
+    return entries;
+}
+
+size_t WatchList::subscribe(Callback callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t subscription = m_nextSubscription++;
+    m_subscribers.emplace(subscription, std::move(callback));
+    return subscription;
+}
+
+bool WatchList::unsubscribe(size_t subscription) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_subscribers.erase(subscription) != 0;
+}
+
+size_t WatchList::poll(Clock::time_point now) {
+    struct Job {
+        WatchId id;
+        PointerChain chain;
+        uintptr_t address;
+        bool ok;
+        std::vector<uint8_t> value;
+    };
+    
+    // Entries due within half a minimum interval share this pass
+    std::vector<Job> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const Clock::time_point horizon = now + m_minInterval / 2;
+        for (const auto& slot : m_slots) {
+            if (slot.second.due <= horizon) {
+                const WatchEntry& entry = slot.second.entry;
+                jobs.push_back(Job{entry.id, entry.chain, entry.chain.base, true,
+                                   std::vector<uint8_t>(scanner::valueTypeSize(entry.type))});
+            }
+        }
+    }
+    
+    if (jobs.empty() || !m_memoryProvider) {
+        return 0;
+    }
+    
+    std::vector<scanner::MemoryRead> reads;
+    std::vector<size_t> owners;
+    std::vector<bool> results;
+    std::vector<uint64_t> pointers(jobs.size());
+    uint64_t batches = 0;
+    
+    // Dereference one pointer level of every chain per batch
+    for (size_t level = 0;; ++level) {
+        reads.clear();
+        owners.clear();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (jobs[i].ok && level < jobs[i].chain.offsets.size()) {
+                pointers[i] = 0;
+                reads.push_back(scanner::MemoryRead{jobs[i].address, &pointers[i], jobs[i].chain.pointerSize});
+                owners.push_back(i);
+            }
+        }
+        if (reads.empty()) {
+            break;
+        }
+        
+        m_memoryProvider->readMemoryBatch(reads, results);
+        ++batches;
+        for (size_t k = 0; k < owners.size(); ++k) {
+            Job& job = jobs[owners[k]];
+            job.ok = results[k] && pointers[owners[k]] != 0;
+            job.address = static_cast<uintptr_t>(pointers[owners[k]]) + job.chain.offsets[level];
+        }
+    }
+    
+    // Then read every value in one batch
+    reads.clear();
+    owners.clear();
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (jobs[i].ok) {
+            reads.push_back(scanner::MemoryRead{jobs[i].address, jobs[i].value.data(), jobs[i].value.size()});
+            owners.push_back(i);
+        }
+    }
+    if (!reads.empty()) {
+        m_memoryProvider->readMemoryBatch(reads, results);
+        ++batches;
+        for (size_t k = 0; k < owners.size(); ++k) {
+            jobs[owners[k]].ok = results[k];
+        }
+    }
+    
+    std::vector<WatchChange> changes;
+    std::vector<Callback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& job : jobs) {
+            auto it = m_slots.find(job.id);
+            if (it == m_slots.end()) {
+                continue;       // Removed while reading
+            }
+            
+            Slot& slot = it->second;
+            WatchEntry& entry = slot.entry;
+            if (!job.ok) {
+                // Unresolvable entries back off like unchanged ones
+                entry.address = 0;
+                entry.interval = std::min(m_maxInterval, entry.interval + entry.interval / 2);
+            } else if (job.value != entry.value || job.address != entry.address) {
+                changes.push_back(WatchChange{entry.id, job.address, entry.type, entry.value, job.value});
+                if (!entry.value.empty()) {
+                    ++entry.changes;
+                }
+                entry.address = job.address;
+                entry.value = std::move(job.value);
+                entry.interval = std::max(m_minInterval, entry.interval / 2);
+            } else {
+                entry.interval = std::min(m_maxInterval, entry.interval + entry.interval / 2);
+            }
+            slot.due = now + entry.interval;
+        }
+        
+        ++m_stats.polls;
+        m_stats.entryReads += jobs.size();
+        m_stats.batches += batches;
+        
+        if (!changes.empty()) {
+            for (const auto& subscriber : m_subscribers) {
+                callbacks.push_back(subscriber.second);
+            }
+        }
+    }
+    
+    for (const auto& change : changes) {
+        for (const auto& callback : callbacks) {
+            callback(change);
+        }
+    }
+    
+    return jobs.size();
+}
+
+bool WatchList::start() {
+    if (isRunning()) {
+        return false;
+    }
+    
+    m_stopping = false;
+    m_thread = std::thread(&WatchList::run, this);
+    return true;
+}
+
+void WatchList::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+WatchStats WatchList::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void WatchList::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    while (!m_stopping) {
+        m_rescheduled = false;
+        lock.unlock();
+        const Clock::time_point now = Clock::now();
+        poll(now);
+        lock.lock();
+        
+        // Sleep until the earliest entry falls due; add() wakes us early
+        Clock::time_point next = now + m_maxInterval;
+        for (const auto& slot : m_slots) {
+            next = std::min(next, slot.second.due);
+        }
+        m_wake.wait_until(lock, next, [this] { return m_stopping || m_rescheduled; });
+    }
+}
+
+} // namespace trainer
\ No newline at end of file
@@ -1,7 +1,14 @@
 #include "ui/ConsoleUI.h"
 #include "scanner/PatternScanner.h"
+#include "scanner/ScanResultStore.h"
+#include "scanner/ValueScanner.h"
 #include "memory/Pattern.h"
 #include "hooks/MinHookWrapper.h"
+#include "trainer/HardwareWatchpoints.h"
+#include "trainer/ValueFreezer.h"
+#include "trainer/WatchList.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -10,9 +17,66 @@
 
 namespace ui {
 
+namespace {
+
+/**
+ * @brief Number of recent watch changes kept for display
+ */
+constexpr size_t WATCH_HISTORY = 10;
+
+/**
+ * @brief Format raw value bytes of a type for display
+ */
+std::string formatValue(scanner::ValueType type, const std::vector<uint8_t>& bytes) {
+    if (bytes.size() != scanner::valueTypeSize(type)) {
+        return "?";
+    }
+    
+    std::ostringstream oss;
+    switch (type) {
+        case scanner::ValueType::INT8:     oss << static_cast<int>(static_cast<int8_t>(bytes[0])); break;
+        case scanner::ValueType::INT16:    { int16_t v; std::memcpy(&v, bytes.data(), sizeof(v)); oss << v; break; }
+        case scanner::ValueType::INT32:    { int32_t v; std::memcpy(&v, bytes.data(), sizeof(v)); oss << v; break; }
+        case scanner::ValueType::INT64:    { int64_t v; std::memcpy(&v, bytes.data(), sizeof(v)); oss << v; break; }
+        case scanner::ValueType::FLOAT:    { float v; std::memcpy(&v, bytes.data(), sizeof(v)); oss << v; break; }
+        case scanner::ValueType::DOUBLE:   { double v; std::memcpy(&v, bytes.data(), sizeof(v)); oss << v; break; }
+        case scanner::ValueType::VECTOR2F: {
+            float v[2];
+            std::memcpy(v, bytes.data(), sizeof(v));
+            oss << v[0] << "," << v[1];
+            break;
+        }
+    }
+    return oss.str();
+}
+
+} // anonymous namespace
+
 ConsoleUI::ConsoleUI(std::unique_ptr<scanner::PatternScanner> scanner)
     : m_scanner(std::move(scanner)), m_running(true) {
     
+    m_valueScanner = std::make_unique<scanner::ValueScanner>(m_scanner->getMemoryProvider());
+    m_scanResults = std::make_unique<scanner::ScanResultStore>(m_scanner->getMemoryProvider());
+    m_freezer = std::make_unique<trainer::ValueFreezer>(m_scanner->getMemoryProvider());
+    m_watchList = std::make_unique<trainer::WatchList>(m_scanner->getMemoryProvider());
+    
+    m_watchList->subscribe([this](const trainer::WatchChange& change) {
+        if (change.previous.empty()) {
+            return;
+        }
+        
+        std::ostringstream oss;
+        oss << "#" << change.id << " 0x" << std::hex << change.address << std::dec << ": "
+            << formatValue(change.type, change.previous) << " -> "
+            << formatValue(change.type, change.current);
+        
+        std::lock_guard<std::mutex> lock(m_watchMutex);
+        m_watchChanges.push_back(oss.str());
+        if (m_watchChanges.size() > WATCH_HISTORY) {
+            m_watchChanges.pop_front();
+        }
+    });
+    
     // Initialize MinHook
     hooks::MHStatus status = hooks::MinHookWrapper::initialize();
     if (status != hooks::MHStatus::MH_OK) {
@@ -55,14 +119,76 @@ void ConsoleUI::processCommand(const std::string& command) {
         std::cout << "Exiting..." << std::endl;
     } else if (cmd == "scan") {
         processScanCommand(iss);
+    } else if (cmd == "findall") {
+        processFindAllCommand(iss);
+    } else if (cmd == "string") {
+        processStringCommand(iss);
     } else if (cmd == "patterns") {
         showPatterns();
     } else if (cmd == "hook") {
         processHookCommand(iss);
     } else if (cmd == "hooks") {
-        showHooks();
+        std::string mode;
+        iss >> mode;
+        if (mode == "on" || mode == "off") {
+            setAllHooks(mode == "on");
+        } else if (mode == "stats") {
+            processHookStatsCommand(iss);
+        } else {
+            showHooks();
+        }
     } else if (cmd == "memory") {
         processMemoryCommand(iss);
+    } else if (cmd == "value") {
+        processValueCommand(iss);
+    } else if (cmd == "group") {
+        processGroupCommand(iss);
+    } else if (cmd == "unknown") {
+        processUnknownCommand(iss);
+    } else if (cmd == "next") {
+        processNextCommand(iss);
+    } else if (cmd == "undo") {
+        if (m_valueScanner->undo()) {
+            showValueCandidates();
+        } else {
+            std::cout << "Nothing to undo" << std::endl;
+        }
+    } else if (cmd == "redo") {
+        if (m_valueScanner->redo()) {
+            showValueCandidates();
+        } else {
+            std::cout << "Nothing to redo" << std::endl;
+        }
+    } else if (cmd == "history") {
+        showScanHistory();
+    } else if (cmd == "freeze") {
+        processFreezeCommand(iss);
+    } else if (cmd == "unfreeze") {
+        processUnfreezeCommand(iss);
+    } else if (cmd == "frozen") {
+        showFrozenValues();
+    } else if (cmd == "watch") {
+        processWatchCommand(iss);
+    } else if (cmd == "unwatch") {
+        std::string idStr;
+        iss >> idStr;
+        try {
+            if (m_watchList->remove(static_cast<trainer::WatchId>(std::stoul(idStr)))) {
+                std::cout << "Removed watch #" << idStr << std::endl;
+            } else {
+                std::cout << "No watch #" << idStr << std::endl;
+            }
+        } catch (const std::exception&) {
+            std::cout << "Usage: unwatch <id>" << std::endl;
+        }
+    } else if (cmd == "watches") {
+        showWatches();
+    } else if (cmd == "hwwatch") {
+        processHardwareWatchCommand(iss);
+    } else if (cmd == "hwunwatch") {
+        processHardwareUnwatchCommand(iss);
+    } else if (cmd == "hwhits") {
+        showAccessSites();
     } else if (cmd == "test") {
         runTests();
     } else {
@@ -76,10 +202,39 @@ void ConsoleUI::showHelp() {
     std::cout << "  help, ?          - Show this help" << std::endl;
     std::cout << "  exit, quit       - Exit the trainer" << std::endl;
     std::cout << "  scan <pattern>   - Scan for a pattern" << std::endl;
+    std::cout << "  findall <pat>    - Find all matches of a pattern" << std::endl;
+    std::cout << "  string <text>    - Scan for an ASCII string (-i ignore case," << std::endl;
+    std::cout << "                     -w UTF-16LE before the text)" << std::endl;
     std::cout << "  patterns         - Show available patterns" << std::endl;
     std::cout << "  hook <addr> <fn> - Create a hook at address" << std::endl;
-    std::cout << "  hooks            - Show active hooks" << std::endl;
+    std::cout << "  hooks [on|off]   - Show hooks, or enable/disable all in one batch" << std::endl;
+    std::cout << "  hooks stats <on|off|reset>" << std::endl;
+    std::cout << "                   - Count hook calls and time detours" << std::endl;
     std::cout << "  memory <addr>    - Read memory at address" << std::endl;
+    std::cout << "  value <type> <v> - Scan writable memory for a value (v may be" << std::endl;
+    std::cout << "                     X, X~eps, A..B, ~X or X,Y for vector2f;" << std::endl;
+    std::cout << "                     type may list several, e.g. int16,int32)" << std::endl;
+    std::cout << "  group <t:off=v>  - Scan for several values at fixed offsets," << std::endl;
+    std::cout << "                     e.g. group int32:0=100 int32:4=50" << std::endl;
+    std::cout << "  unknown <type>   - Snapshot memory for an unknown-value scan" << std::endl;
+    std::cout << "  next <cmp|v>     - Filter value candidates (changed, unchanged," << std::endl;
+    std::cout << "                     increased, decreased or a value as above)" << std::endl;
+    std::cout << "  undo, redo       - Step back or forward through value scans" << std::endl;
+    std::cout << "  history          - Show value scan steps" << std::endl;
+    std::cout << "  freeze <a> <t> <v>" << std::endl;
+    std::cout << "                   - Hold a value constant, e.g. freeze 0x501000" << std::endl;
+    std::cout << "                     int32 100" << std::endl;
+    std::cout << "  unfreeze <a|all> - Release a frozen value" << std::endl;
+    std::cout << "  frozen           - Show frozen values and freezer timing" << std::endl;
+    std::cout << "  watch <a> <t>    - Poll a value; a may be a pointer chain" << std::endl;
+    std::cout << "                     base,off,... (add ptr32 for 32-bit pointers)" << std::endl;
+    std::cout << "  unwatch <id>     - Stop polling a value" << std::endl;
+    std::cout << "  watches          - Show watched values and recent changes" << std::endl;
+    std::cout << "  hwwatch <a> [n] [write|access|exec]" << std::endl;
+    std::cout << "                   - Find the code accessing n bytes at a with a" << std::endl;
+    std::cout << "                     debug register watchpoint (needs --pid)" << std::endl;
+    std::cout << "  hwunwatch <slot|all> - Remove a debug register watchpoint" << std::endl;
+    std::cout << "  hwhits           - Show the instructions that hit each watchpoint" << std::endl;
     std::cout << "  test             - Run demonstration tests" << std::endl;
 }
 
@@ -113,7 +268,7 @@ void ConsoleUI::processScanCommand(std::istringstream& iss) {
             std::cout << std::dec << std::endl;
             
             // Store the result
-            m_scanResults.push_back(result);
+            m_scanResults->add(result);
         } else {
             std::cout << "Pattern not found" << std::endl;
         }
@@ -122,6 +277,87 @@ void ConsoleUI::processScanCommand(std::istringstream& iss) {
     }
 }
 
+void ConsoleUI::processStringCommand(std::istringstream& iss) {
+    scanner::StringScanOptions options;
+    std::string text;
+    
+    std::string word;
+    while (iss >> word) {
+        if (text.empty() && word == "-i") {
+            options.caseInsensitive = true;
+        } else if (text.empty() && word == "-w") {
+            options.encoding = scanner::StringEncoding::UTF16LE;
+        } else {
+            std::string rest;
+            std::getline(iss, rest);
+            text = word + rest;
+            break;
+        }
+    }
+    
+    // Allow quoting to keep leading/trailing spaces
+    if (text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+        text = text.substr(1, text.size() - 2);
+    }
+    
+    if (text.empty()) {
+        std::cout << "Usage: string [-i] [-w] <text>" << std::endl;
+        std::cout << "Example: string -i icy island" << std::endl;
+        return;
+    }
+    
+    options.maxResults = 100;
+    size_t first = m_scanResults->size();
+    size_t found = m_scanner->scanStringAll(text, *m_scanResults, options);
+    
+    if (found == 0) {
+        std::cout << "String not found" << std::endl;
+        return;
+    }
+    
+    std::cout << found << " match(es)"
+              << (found == options.maxResults ? " (limit reached)" : "") << std::endl;
+    showScanResults(first, 10);
+}
+
+void ConsoleUI::processFindAllCommand(std::istringstream& iss) {
+    std::string patternStr;
+    std::getline(iss, patternStr);
+    
+    patternStr.erase(0, patternStr.find_first_not_of(" \t"));
+    patternStr.erase(patternStr.find_last_not_of(" \t") + 1);
+    
+    if (patternStr.empty()) {
+        std::cout << "Usage: findall <pattern>" << std::endl;
+        std::cout << "Example: findall \"55 8B EC\"" << std::endl;
+        return;
+    }
+    
+    try {
+        memory::Pattern pattern(patternStr, "User Pattern");
+        
+        size_t first = m_scanResults->size();
+        size_t found = m_scanner->scanAll(pattern, *m_scanResults);
+        
+        std::cout << found << " match(es) for " << pattern.toString() << ", store uses "
+                  << m_scanResults->memoryUsage() << " bytes"
+                  << (m_scanResults->isSpilled() ? " (spilled to disk)" : "") << std::endl;
+        showScanResults(first, 10);
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+void ConsoleUI::showScanResults(size_t first, size_t limit) {
+    size_t end = std::min(m_scanResults->size(), first + limit);
+    for (size_t i = first; i < end; ++i) {
+        std::cout << "  0x" << std::hex << m_scanResults->getAddress(i) << std::dec << std::endl;
+    }
+    if (m_scanResults->size() > end) {
+        std::cout << "  ..." << std::endl;
+    }
+}
+
 void ConsoleUI::showPatterns() {
     std::cout << "\nAvailable patterns for SuperTux:" << std::endl;
     std::cout << "1. Health access: \"8B 05 ?? ?? ?? ??\" - Finds health variable access" << std::endl;
@@ -129,13 +365,16 @@ void ConsoleUI::showPatterns() {
     std::cout << "3. Function prologue: \"55 8B EC\" - Finds function beginnings for hooking" << std::endl;
     std::cout << "\nRecent scan results:" << std::endl;
     
-    if (m_scanResults.empty()) {
+    if (m_scanResults->empty()) {
         std::cout << "No scan results yet" << std::endl;
     } else {
-        for (size_t i = 0; i < m_scanResults.size(); ++i) {
-            const auto& result = m_scanResults[i];
-            std::cout << i + 1 << ". " << result.patternName 
-                     << " at 0x" << std::hex << result.address << std::dec << std::endl;
+        const size_t shown = std::min<size_t>(m_scanResults->size(), 20);
+        for (size_t i = 0; i < shown; ++i) {
+            std::cout << i + 1 << ". " << m_scanResults->getPatternName(m_scanResults->getPatternId(i))
+                     << " at 0x" << std::hex << m_scanResults->getAddress(i) << std::dec << std::endl;
+        }
+        if (m_scanResults->size() > shown) {
+            std::cout << "... " << m_scanResults->size() - shown << " more" << std::endl;
         }
     }
 }
@@ -185,8 +424,61 @@ void ConsoleUI::showHooks() {
             const auto& hook = m_hooks[i];
             std::cout << i + 1 << ". " << (hook->isEnabled() ? "[ENABLED] " : "[DISABLED] ")
                      << "Hook at 0x" << std::hex << hook->getOriginal() << std::dec << std::endl;
+            
+            hooks::HookStatsSnapshot stats = hook->stats().snapshot();
+            if (stats.calls > 0) {
+                std::cout << "   " << stats.calls << " call(s)";
+                if (stats.timedCalls > 0) {
+                    std::cout << ", detour avg " << stats.meanNanos() / 1000.0 << " us, p50 < "
+                              << stats.percentileNanos(50) / 1000.0 << " us, p99 < "
+                              << stats.percentileNanos(99) / 1000.0 << " us";
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+    if (!hooks::HookStats::isEnabled()) {
+        std::cout << "(call counting is off; 'hooks stats on' to enable)" << std::endl;
+    }
+}
+
+void ConsoleUI::processHookStatsCommand(std::istringstream& iss) {
+    std::string mode;
+    iss >> mode;
+    
+    if (mode == "on" || mode == "off") {
+        hooks::HookStats::setEnabled(mode == "on");
+        std::cout << "Hook call counting " << (mode == "on" ? "enabled" : "disabled") << std::endl;
+    } else if (mode == "reset") {
+        for (auto& hook : m_hooks) {
+            hook->stats().reset();
+        }
+        std::cout << "Reset call counts of " << m_hooks.size() << " hook(s)" << std::endl;
+    } else {
+        std::cout << "Usage: hooks stats <on|off|reset>" << std::endl;
+    }
+}
+
+void ConsoleUI::setAllHooks(bool enable) {
+    for (auto& hook : m_hooks) {
+        if (enable) {
+            hook->queueEnable();
+        } else {
+            hook->queueDisable();
         }
     }
+    
+    std::vector<hooks::QueuedHookChange> results;
+    hooks::MHStatus status = hooks::MinHookWrapper::applyQueued(&results);
+    size_t failed = std::count_if(results.begin(), results.end(), [](const hooks::QueuedHookChange& change) {
+        return change.status != hooks::MHStatus::MH_OK;
+    });
+    
+    std::cout << (enable ? "Enabled " : "Disabled ") << results.size() - failed << " of "
+              << results.size() << " hook(s)" << std::endl;
+    if (status != hooks::MHStatus::MH_OK) {
+        std::cout << "Error: " << hooks::MinHookWrapper::getLastError() << std::endl;
+    }
 }
 
 void ConsoleUI::processMemoryCommand(std::istringstream& iss) {
@@ -229,6 +521,461 @@ void ConsoleUI::processMemoryCommand(std::istringstream& iss) {
     }
 }
 
+void ConsoleUI::processValueCommand(std::istringstream& iss) {
+    std::string typeStr, valueStr;
+    iss >> typeStr >> valueStr;
+    
+    // Several comma-separated types are scanned in a single pass
+    std::vector<scanner::ScanTypeSpec> types;
+    std::istringstream typeList(typeStr);
+    std::string name;
+    bool typesValid = !typeStr.empty();
+    while (typesValid && std::getline(typeList, name, ',')) {
+        scanner::ValueType type;
+        typesValid = scanner::parseValueType(name, type);
+        types.emplace_back(type);
+    }
+    
+    if (valueStr.empty() || !typesValid) {
+        std::cout << "Usage: value <int8|int16|int32|int64|float|double|vector2f>[,type...] <value>" << std::endl;
+        std::cout << "Example: value int32 100, value float 1.5~0.01, value int16,int32,float 100" << std::endl;
+        return;
+    }
+    
+    try {
+        scanner::ScanCriteria criteria = scanner::ScanCriteria::parse(valueStr);
+        
+        if (m_valueScanner->firstScan(types, criteria)) {
+            showValueCandidates();
+        } else {
+            std::cout << "Value scan failed" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+void ConsoleUI::processGroupCommand(std::istringstream& iss) {
+    std::vector<scanner::GroupMember> members;
+    
+    try {
+        std::string token;
+        while (iss >> token) {
+            size_t colon = token.find(':');
+            size_t equals = token.find('=', colon == std::string::npos ? 0 : colon);
+            
+            scanner::ValueType type;
+            if (colon == std::string::npos || equals == std::string::npos ||
+                !scanner::parseValueType(token.substr(0, colon), type)) {
+                members.clear();
+                break;
+            }
+            
+            size_t pos = 0;
+            std::string offsetStr = token.substr(colon + 1, equals - colon - 1);
+            long long offset = std::stoll(offsetStr, &pos, 0);
+            if (pos != offsetStr.size()) {
+                throw std::invalid_argument("Invalid offset: " + offsetStr);
+            }
+            
+            members.push_back(scanner::GroupMember{static_cast<ptrdiff_t>(offset), type,
+                                                   scanner::ScanCriteria::parse(token.substr(equals + 1))});
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return;
+    }
+    
+    if (members.empty()) {
+        std::cout << "Usage: group <type>:<offset>=<value> [<type>:<offset>=<value> ...]" << std::endl;
+        std::cout << "Example: group int32:0=100 int32:4=50" << std::endl;
+        return;
+    }
+    
+    if (m_valueScanner->groupScan(members)) {
+        showValueCandidates();
+    } else {
+        std::cout << "Group scan failed" << std::endl;
+    }
+}
+
+void ConsoleUI::processUnknownCommand(std::istringstream& iss) {
+    std::string typeStr;
+    iss >> typeStr;
+    
+    scanner::ValueType type;
+    if (!scanner::parseValueType(typeStr, type)) {
+        std::cout << "Usage: unknown <int8|int16|int32|int64|float|double|vector2f>" << std::endl;
+        std::cout << "Example: unknown float" << std::endl;
+        return;
+    }
+    
+    if (m_valueScanner->firstScanUnknown(type)) {
+        showValueCandidates();
+    } else {
+        std::cout << "Snapshot failed" << std::endl;
+    }
+}
+
+void ConsoleUI::processNextCommand(std::istringstream& iss) {
+    std::string compareStr, valueStr;
+    iss >> compareStr >> valueStr;
+    
+    // "next exact 5" and "next 5" are equivalent; range names take their
+    // operands from the expression ("next within 1.5~0.1")
+    scanner::ScanCompare compare = scanner::ScanCompare::EXACT;
+    bool named = scanner::parseScanCompare(compareStr, compare);
+    if (!named) {
+        valueStr = compareStr;
+    }
+    
+    if (compareStr.empty() || ((!named || scanner::ScanCriteria(compare).isRange()) && valueStr.empty())) {
+        std::cout << "Usage: next <changed|unchanged|increased|decreased>" << std::endl;
+        std::cout << "       next [exact|within|between|rounded] <value>" << std::endl;
+        std::cout << "Example: next decreased, next 42, next 1.5~0.01" << std::endl;
+        return;
+    }
+    
+    if (!m_valueScanner->isActive()) {
+        std::cout << "No value scan in progress; use 'value' first" << std::endl;
+        return;
+    }
+    
+    try {
+        scanner::ScanCriteria criteria(compare);
+        if (!named || criteria.isRange()) {
+            criteria = scanner::ScanCriteria::parse(valueStr);
+        }
+        
+        if (m_valueScanner->nextScan(criteria)) {
+            showValueCandidates();
+        } else {
+            std::cout << "Value scan failed" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+void ConsoleUI::showValueCandidates() {
+    if (const scanner::SnapshotStore* snapshot = m_valueScanner->getSnapshot()) {
+        std::cout << "Snapshot of " << snapshot->getPages().size() << " page(s), "
+                  << snapshot->capturedBytes() << " bytes stored in "
+                  << snapshot->memoryUsage() << " bytes ("
+                  << snapshot->zeroPageCount() << " zero, "
+                  << snapshot->uniquePageCount() << " unique)" << std::endl;
+        std::cout << "Use 'next <cmp>' to pick candidates" << std::endl;
+        return;
+    }
+    
+    for (const auto& result : m_valueScanner->getResults()) {
+        const scanner::CandidateSet& candidates = result.candidates;
+        
+        std::cout << candidates.count() << " candidate(s) of type "
+                  << scanner::valueTypeName(result.type)
+                  << " in " << candidates.getBlocks().size() << " block(s), "
+                  << candidates.memoryUsage() << " bytes" << std::endl;
+        
+        for (uintptr_t address : candidates.getAddresses(10)) {
+            std::cout << "  0x" << std::hex << address << std::dec << std::endl;
+        }
+        if (candidates.count() > 10) {
+            std::cout << "  ..." << std::endl;
+        }
+    }
+}
+
+void ConsoleUI::processFreezeCommand(std::istringstream& iss) {
+    std::string addrStr, typeStr, valueStr;
+    iss >> addrStr >> typeStr >> valueStr;
+    
+    scanner::ValueType type;
+    if (valueStr.empty() || !scanner::parseValueType(typeStr, type)) {
+        std::cout << "Usage: freeze <address> <type> <value>" << std::endl;
+        std::cout << "Types: int8, int16, int32, int64, float, double, vector2f" << std::endl;
+        std::cout << "Example: freeze 0x501000 int32 100" << std::endl;
+        return;
+    }
+    
+    try {
+        uintptr_t address = std::stoul(addrStr, nullptr, 16);
+        scanner::ScanValue value = scanner::ScanValue::fromString(valueStr);
+        
+        if (!m_freezer->freeze(address, type, value)) {
+            std::cout << "Failed to write memory at 0x" << std::hex << address << std::dec << std::endl;
+            return;
+        }
+        
+        m_freezer->start();
+        std::cout << "Frozen " << scanner::valueTypeName(type) << " at 0x" << std::hex << address
+                  << std::dec << " (" << m_freezer->getEntries().size() << " value(s), "
+                  << m_freezer->writesPerTick() << " write(s) per tick)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+void ConsoleUI::processUnfreezeCommand(std::istringstream& iss) {
+    std::string addrStr;
+    iss >> addrStr;
+    
+    if (addrStr.empty()) {
+        std::cout << "Usage: unfreeze <address|all>" << std::endl;
+        return;
+    }
+    
+    if (addrStr == "all") {
+        m_freezer->clear();
+        m_freezer->stop();
+        std::cout << "All values released" << std::endl;
+        return;
+    }
+    
+    try {
+        uintptr_t address = std::stoul(addrStr, nullptr, 16);
+        if (m_freezer->unfreeze(address)) {
+            std::cout << "Released 0x" << std::hex << address << std::dec << std::endl;
+        } else {
+            std::cout << "No frozen value at 0x" << std::hex << address << std::dec << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+void ConsoleUI::showFrozenValues() {
+    std::vector<trainer::FrozenValue> entries = m_freezer->getEntries();
+    if (entries.empty()) {
+        std::cout << "No frozen values" << std::endl;
+        return;
+    }
+    
+    for (const auto& entry : entries) {
+        bool integral = entry.type != scanner::ValueType::FLOAT &&
+                        entry.type != scanner::ValueType::DOUBLE &&
+                        entry.type != scanner::ValueType::VECTOR2F;
+        std::cout << "  0x" << std::hex << entry.address << std::dec << " "
+                  << scanner::valueTypeName(entry.type) << " = ";
+        if (integral) {
+            std::cout << entry.value.intValue << std::endl;
+        } else {
+            std::cout << entry.value.floatValue << std::endl;
+        }
+    }
+    
+    trainer::FreezerStats stats = m_freezer->getStats();
+    std::cout << m_freezer->writesPerTick() << " write(s) per tick at "
+              << m_freezer->getRate() << " Hz, " << stats.ticks << " tick(s)";
+    if (stats.ticks) {
+        std::cout << ", avg " << stats.totalTickNanos / stats.ticks / 1000.0 << " us, max "
+                  << stats.maxTickNanos / 1000.0 << " us";
+    }
+    std::cout << ", " << stats.failedWrites << " failed, " << stats.overruns << " overrun(s)" << std::endl;
+}
+
+void ConsoleUI::processWatchCommand(std::istringstream& iss) {
+    std::string chainStr, typeStr, option;
+    iss >> chainStr >> typeStr >> option;
+    
+    scanner::ValueType type;
+    if (chainStr.empty() || !scanner::parseValueType(typeStr, type) ||
+        (!option.empty() && option != "ptr32")) {
+        std::cout << "Usage: watch <address|base,offset,...> <type> [ptr32]" << std::endl;
+        std::cout << "Example: watch 0x501000 int32, watch 0x501200,0x8 float ptr32" << std::endl;
+        return;
+    }
+    
+    try {
+        trainer::PointerChain chain;
+        std::istringstream parts(chainStr);
+        std::string part;
+        
+        std::getline(parts, part, ',');
+        chain.base = std::stoull(part, nullptr, 16);
+        while (std::getline(parts, part, ',')) {
+            chain.offsets.push_back(static_cast<ptrdiff_t>(std::stoll(part, nullptr, 0)));
+        }
+        if (option == "ptr32") {
+            chain.pointerSize = 4;
+        }
+        
+        trainer::WatchId id = m_watchList->add(chain, type);
+        m_watchList->start();
+        std::cout << "Watching #" << id << " (" << scanner::valueTypeName(type) << ", "
+                  << chain.offsets.size() << " pointer level(s))" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+void ConsoleUI::showWatches() {
+    std::vector<trainer::WatchEntry> entries = m_watchList->getEntries();
+    if (entries.empty()) {
+        std::cout << "No watched values" << std::endl;
+        return;
+    }
+    
+    for (const auto& entry : entries) {
+        std::cout << "  #" << entry.id << " ";
+        if (entry.address) {
+            std::cout << "0x" << std::hex << entry.address << std::dec;
+        } else {
+            std::cout << "(unresolved)";
+        }
+        std::cout << " " << scanner::valueTypeName(entry.type) << " = "
+                  << formatValue(entry.type, entry.value) << ", every "
+                  << entry.interval.count() << " ms, " << entry.changes << " change(s)" << std::endl;
+    }
+    
+    trainer::WatchStats stats = m_watchList->getStats();
+    std::cout << stats.entryReads << " read(s) in " << stats.batches << " batch(es) over "
+              << stats.polls << " poll(s)" << std::endl;
+    
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    if (!m_watchChanges.empty()) {
+        std::cout << "Recent changes:" << std::endl;
+        for (const auto& change : m_watchChanges) {
+            std::cout << "  " << change << std::endl;
+        }
+    }
+}
+
+void ConsoleUI::processHardwareWatchCommand(std::istringstream& iss) {
+    std::string addrStr, sizeStr, kindStr;
+    iss >> addrStr >> sizeStr >> kindStr;
+    
+    trainer::WatchpointKind kind = trainer::WatchpointKind::WRITE;
+    if (kindStr == "access") {
+        kind = trainer::WatchpointKind::READ_WRITE;
+    } else if (kindStr == "exec") {
+        kind = trainer::WatchpointKind::EXECUTE;
+    } else if (!kindStr.empty() && kindStr != "write") {
+        addrStr.clear();
+    }
+    
+    if (addrStr.empty()) {
+        std::cout << "Usage: hwwatch <address> [size] [write|access|exec]" << std::endl;
+        std::cout << "Example: hwwatch 0x501000 4" << std::endl;
+        return;
+    }
+    if (m_processId == 0) {
+        std::cout << "Debug register watchpoints need a live process (--pid)" << std::endl;
+        return;
+    }
+    
+    try {
+        uintptr_t address = std::stoull(addrStr, nullptr, 16);
+        size_t size = sizeStr.empty() ? (kind == trainer::WatchpointKind::EXECUTE ? 1 : 4) : std::stoul(sizeStr);
+        
+        if (!m_watchpoints) {
+            m_watchpoints = std::make_unique<trainer::HardwareWatchpoints>(m_processId);
+        }
+        if (!m_watchpoints->isAttached() && !m_watchpoints->attach()) {
+            std::cout << "Failed to attach with ptrace (permission denied or process gone)" << std::endl;
+            return;
+        }
+        
+        int slot = m_watchpoints->set(address, size, kind);
+        if (slot < 0) {
+            std::cout << "No free debug register, or address not aligned to a size of 1, 2, 4 or 8" << std::endl;
+            return;
+        }
+        std::cout << "Watchpoint " << slot << " on 0x" << std::hex << address << std::dec
+                  << " across " << m_watchpoints->getStats().threads << " thread(s)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
+void ConsoleUI::processHardwareUnwatchCommand(std::istringstream& iss) {
+    std::string slotStr;
+    iss >> slotStr;
+    
+    if (!m_watchpoints) {
+        std::cout << "No debug register watchpoints" << std::endl;
+        return;
+    }
+    
+    if (slotStr == "all") {
+        m_watchpoints->detach();
+        std::cout << "Removed all watchpoints and detached" << std::endl;
+        return;
+    }
+    
+    try {
+        int slot = std::stoi(slotStr);
+        if (m_watchpoints->clear(slot)) {
+            std::cout << "Removed watchpoint " << slot << std::endl;
+        } else {
+            std::cout << "No watchpoint " << slot << std::endl;
+        }
+    } catch (const std::exception&) {
+        std::cout << "Usage: hwunwatch <slot|all>" << std::endl;
+    }
+}
+
+void ConsoleUI::showAccessSites() {
+    if (!m_watchpoints) {
+        std::cout << "No debug register watchpoints" << std::endl;
+        return;
+    }
+    
+    std::vector<trainer::AccessSite> sites = m_watchpoints->getAccessSites();
+    if (sites.empty()) {
+        std::cout << "No hits yet" << std::endl;
+    }
+    for (const auto& site : sites) {
+        std::cout << "  [" << site.slot << "] 0x" << std::hex << m_watchpoints->getAddress(site.slot)
+                  << " <- 0x" << site.rip << std::dec << ": " << site.hits << " hit(s)" << std::endl;
+    }
+    
+    std::vector<trainer::WatchpointHit> hits;
+    m_watchpoints->drain(hits);
+    if (!hits.empty()) {
+        const trainer::RegisterContext& r = hits.back().registers;
+        std::cout << "Last hit, thread " << hits.back().threadId << ":" << std::hex << std::endl;
+        std::cout << "  rip=0x" << r.rip << " rsp=0x" << r.rsp << " rbp=0x" << r.rbp << std::endl;
+        std::cout << "  rax=0x" << r.rax << " rbx=0x" << r.rbx << " rcx=0x" << r.rcx
+                  << " rdx=0x" << r.rdx << std::endl;
+        std::cout << "  rsi=0x" << r.rsi << " rdi=0x" << r.rdi << std::dec << std::endl;
+    }
+    
+    trainer::WatchpointStats stats = m_watchpoints->getStats();
+    std::cout << stats.hits << " hit(s), " << stats.dropped << " dropped, "
+              << stats.threads << " thread(s) traced" << std::endl;
+    if (!sites.empty()) {
+        std::cout << "Data hits report the instruction after the access; hook there with 'hook <addr> <name>'" << std::endl;
+    }
+}
+
+void ConsoleUI::showScanHistory() {
+    const scanner::ScanSession& session = m_valueScanner->getSession();
+    if (!session.current()) {
+        std::cout << "No value scan in progress" << std::endl;
+        return;
+    }
+    
+    // Oldest step first
+    auto history = session.history();
+    for (auto it = history.rbegin(); it != history.rend(); ++it) {
+        const scanner::ScanGeneration& generation = **it;
+        
+        size_t count = 0;
+        for (const auto& result : generation.results) {
+            count += result.candidates.count();
+        }
+        
+        std::cout << (&generation == session.current() ? "* " : "  ")
+                  << generation.depth << ": " << generation.label << " - ";
+        if (generation.snapshot) {
+            std::cout << "snapshot" << std::endl;
+        } else {
+            std::cout << count << " candidate(s)" << std::endl;
+        }
+    }
+    std::cout << "History uses " << session.memoryUsage() << " bytes" << std::endl;
+}
+
 void ConsoleUI::runTests() {
     std::cout << "\n=== Running Demonstration Tests ===" << std::endl;
     
@@ -1,6 +1,156 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <set>
+#include <thread>
+#include <typeinfo>
+#include "include/hooks/HookEvents.h"
+#include "include/hooks/HookRegistry.h"
+#include "include/hooks/X86Decoder.h"
 #include "include/memory/Pattern.h"
 #include "include/scanner/PatternScanner.h"
+#include "include/scanner/ValueScanner.h"
+#include "include/scanner/ScanResultStore.h"
+#include "include/trainer/HardwareWatchpoints.h"
+#include "include/trainer/ValueFreezer.h"
+#include "include/trainer/WatchList.h"
+#include "src/memory/MockMemoryProvider.cpp"
+#if defined(__linux__)
+#include "src/memory/LinuxMemoryProvider.cpp"
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__x86_64__)
+volatile int32_t g_watchedCounter = 0;
+
+// Writes the watched counter until the process is killed
+[[noreturn]] void writeWatchedCounter() {
+    for (;;) {
+        g_watchedCounter = g_watchedCounter + 1;
+        usleep(500);
+    }
+}
+
+// Inline hook detour; the original is called through the trampoline
+using AddFunction = int (*)(int, int);
+AddFunction g_addOriginal = nullptr;
+
+int addDetour(int a, int b) {
+    return g_addOriginal(a, b) * 10;
+}
+
+// Hand-assembled add(a, b) on its own page, long enough for any jump at every optimization level
+AddFunction craftAdd() {
+    const uint8_t body[] = {0x89, 0xF8,                                         // mov eax, edi
+                            0x01, 0xF0,                                         // add eax, esi
+                            0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00,           // nop dword [rax]
+                            0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00,           // nop dword [rax]
+                            0xC3};                                              // ret
+    long page = sysconf(_SC_PAGESIZE);
+    void* code = mmap(nullptr, page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        return nullptr;
+    }
+    std::memset(code, 0xCC, page);
+    std::memcpy(code, body, sizeof(body));
+    mprotect(code, page, PROT_READ | PROT_EXEC);
+    return reinterpret_cast<AddFunction>(code);
+}
+
+using CraftedFunction = int (*)(int);
+CraftedFunction g_craftedOriginal = nullptr;
+
+int craftedDetour(int x) {
+    return g_craftedOriginal(x) + 1000;
+}
+
+int constantDetour(int) {
+    return -1;
+}
+
+hooks::FunctionHook* g_timedHook = nullptr;
+
+int timedAddDetour(int a, int b) {
+    hooks::HookTimer timer(g_timedHook->stats());
+    return g_timedHook->callOriginal<int>(a, b) + 1;
+}
+
+// Mid-function handlers: see and change registers partway through crafted code
+uint64_t g_midSeen = 0;
+
+void coinHandler(hooks::HookContext& context) {
+    g_midSeen = context.rbx;
+    context.rbx *= 2;
+}
+
+void xmmHandler(hooks::HookContext& context) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.1f", static_cast<double>(context.xmm[0].u32[0]));
+    g_midSeen = static_cast<uint64_t>(std::atof(text));
+    context.xmm[0].u32[0] += 1000;
+}
+
+void clobberHandler(hooks::HookContext& context) {
+    g_midSeen = context.r8 == context.rdi && context.rsp % 8 == 0;
+    __asm__ __volatile__("xor %%r8d, %%r8d\n\tcmp $1, %%r8d" ::: "r8", "cc");
+}
+
+// Vtable hooks: slots 0 and 1 are the destructors, then health() and speed()
+struct Actor {
+    virtual ~Actor() = default;
+    virtual int health() const { return 10; }
+    virtual int speed() const { return 1; }
+};
+
+struct Player : Actor {
+    int health() const override { return 100; }
+};
+
+struct Rider : virtual Actor {
+    int speed() const override { return 3; }
+};
+
+__attribute__((noinline)) int actorHealth(const Actor& actor) {
+    return actor.health();
+}
+
+__attribute__((noinline)) int actorSpeed(const Actor& actor) {
+    return actor.speed();
+}
+
+using ActorMethod = int (*)(const Actor*);
+ActorMethod g_healthOriginal = nullptr;
+
+int healthDetour(const Actor* self) {
+    return g_healthOriginal(self) + 1;
+}
+
+int speedDetour(const Actor*) {
+    return 5;
+}
+
+int stopDetour(const Actor*) {
+    return 0;
+}
+
+using GetPid = pid_t (*)();
+GetPid g_getpidOriginal = nullptr;
+
+pid_t getpidDetour() {
+    return 4242;
+}
+#endif
 
 // Simple test to verify pattern matching works
 int main() {
@@ -63,6 +213,1378 @@ int main() {
                   << " (base + 0x100)" << std::dec << std::endl;
     }
     
+    // Test 5: Value scanning with next-scan filtering
+    std::cout << "\nTest 5: Value Scanning" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        scanner::ValueScanner valueScanner(&provider);
+        
+        valueScanner.firstScan(scanner::ValueType::INT32,
+                               scanner::ScanCriteria(scanner::ScanCompare::EXACT,
+                                                     scanner::ScanValue::fromInt(100)));
+        std::vector<uintptr_t> hits = valueScanner.getCandidates().getAddresses(10);
+        bool found = hits.size() == 1 && hits[0] == 0x501000;
+        std::cout << (found ? "✓" : "✗") << " Health value 100 found at 0x501000" << std::endl;
+        
+        // Zero is everywhere in the heap; the result must stay compact
+        valueScanner.firstScan(scanner::ValueType::INT32,
+                               scanner::ScanCriteria(scanner::ScanCompare::EXACT,
+                                                     scanner::ScanValue::fromInt(0)));
+        const scanner::CandidateSet& zeros = valueScanner.getCandidates();
+        std::cout << (zeros.count() == 0x10000 / 4 - 2 ? "✓" : "✗") << " Zero candidates: "
+                  << zeros.count() << " in " << zeros.memoryUsage() << " bytes" << std::endl;
+        
+        // Change one zero and narrow on "changed"
+        std::vector<uint8_t> heap(0x10000, 0x00);
+        *reinterpret_cast<uint32_t*>(&heap[0x1000]) = 100;
+        *reinterpret_cast<uint32_t*>(&heap[0x1004]) = 50;
+        *reinterpret_cast<uint32_t*>(&heap[0x2000]) = 7;
+        provider.addMemoryRegion(0x500000, heap);
+        
+        valueScanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::CHANGED));
+        hits = valueScanner.getCandidates().getAddresses(10);
+        bool changed = hits.size() == 1 && hits[0] == 0x502000;
+        std::cout << (changed ? "✓" : "✗") << " Changed filter narrowed to 0x502000" << std::endl;
+        
+        valueScanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::EXACT,
+                                                    scanner::ScanValue::fromInt(7)));
+        std::cout << (valueScanner.getCandidates().count() == 1 ? "✓" : "✗")
+                  << " Exact filter kept the candidate" << std::endl;
+    }
+    
+    // Test 6: Unknown initial value scan from a compressed snapshot
+    std::cout << "\nTest 6: Unknown Value Snapshot" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        scanner::ValueScanner valueScanner(&provider);
+        
+        valueScanner.firstScanUnknown(scanner::ValueType::INT32);
+        const scanner::SnapshotStore* snapshot = valueScanner.getSnapshot();
+        bool compact = snapshot && snapshot->memoryUsage() < snapshot->capturedBytes();
+        std::cout << (compact ? "✓" : "✗") << " Snapshot of " << snapshot->capturedBytes()
+                  << " bytes stored in " << snapshot->memoryUsage() << " bytes" << std::endl;
+        
+        // Coins drop from 50 to 49
+        std::vector<uint8_t> heap(0x10000, 0x00);
+        *reinterpret_cast<uint32_t*>(&heap[0x1000]) = 100;
+        *reinterpret_cast<uint32_t*>(&heap[0x1004]) = 49;
+        provider.addMemoryRegion(0x500000, heap);
+        
+        valueScanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::DECREASED));
+        std::vector<uintptr_t> hits = valueScanner.getCandidates().getAddresses(10);
+        bool decreased = hits.size() == 1 && hits[0] == 0x501004;
+        std::cout << (decreased ? "✓" : "✗") << " Decreased filter found coins at 0x501004" << std::endl;
+        
+        // Round-trip a page through the codec
+        std::vector<uint8_t> page(scanner::SNAPSHOT_PAGE_BYTES);
+        for (size_t i = 0; i < page.size(); ++i) {
+            page[i] = static_cast<uint8_t>((i / 16) ^ (i % 7));
+        }
+        std::vector<uint8_t> packed;
+        size_t packedSize = scanner::SnapshotStore::compressPage(page.data(), page.size(), packed);
+        std::vector<uint8_t> unpacked(page.size());
+        bool roundTrip = packedSize > 0 &&
+            scanner::SnapshotStore::decompressPage(packed.data(), packedSize,
+                                                   unpacked.data(), unpacked.size()) &&
+            unpacked == page;
+        std::cout << (roundTrip ? "✓" : "✗") << " Page codec round trip ("
+                  << packedSize << " bytes)" << std::endl;
+    }
+    
+    // Test 7: Float tolerance, range and vector pair scans
+    std::cout << "\nTest 7: Float and Vector Scans" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        scanner::ValueScanner valueScanner(&provider);
+        
+        std::vector<uint8_t> level(0x1000, 0x00);
+        float floats[] = { 1.5f, 1.49f, std::nanf(""), 41.6f };
+        std::memcpy(&level[0x10], &floats[0], sizeof(float));
+        std::memcpy(&level[0x20], &floats[1], sizeof(float));
+        std::memcpy(&level[0x30], &floats[2], sizeof(float));
+        std::memcpy(&level[0x40], &floats[3], sizeof(float));
+        float position[] = { 120.5f, 64.2f };
+        std::memcpy(&level[0x104], position, sizeof(position));
+        double speed = 3.25;
+        std::memcpy(&level[0x200], &speed, sizeof(speed));
+        provider.addMemoryRegion(0x600000, level);
+        
+        valueScanner.firstScan(scanner::ValueType::FLOAT, scanner::ScanCriteria::parse("1.5~0.02"));
+        std::vector<uintptr_t> hits = valueScanner.getCandidates().getAddresses(10);
+        bool within = hits.size() == 2 && hits[0] == 0x600010 && hits[1] == 0x600020;
+        std::cout << (within ? "✓" : "✗") << " Within 1.5~0.02 found 2 floats" << std::endl;
+        
+        valueScanner.firstScan(scanner::ValueType::FLOAT, scanner::ScanCriteria::parse("~42"));
+        hits = valueScanner.getCandidates().getAddresses(10);
+        bool rounded = hits.size() == 1 && hits[0] == 0x600040;
+        std::cout << (rounded ? "✓" : "✗") << " Rounded ~42 found 41.6" << std::endl;
+        
+        valueScanner.firstScan(scanner::ValueType::FLOAT, scanner::ScanCriteria::parse("-1e38..1e38"));
+        bool nanSkipped = true;
+        valueScanner.getCandidates().forEach([&](uintptr_t address, const uint8_t*) {
+            nanSkipped = nanSkipped && address != 0x600030;
+        });
+        std::cout << (nanSkipped ? "✓" : "✗") << " NaN excluded from range scan" << std::endl;
+        
+        valueScanner.firstScan(scanner::ValueType::DOUBLE, scanner::ScanCriteria::parse("3.25~0.001"));
+        hits = valueScanner.getCandidates().getAddresses(10);
+        bool dbl = hits.size() == 1 && hits[0] == 0x600200;
+        std::cout << (dbl ? "✓" : "✗") << " Double 3.25 found at 0x600200" << std::endl;
+        
+        valueScanner.firstScan(scanner::ValueType::VECTOR2F, scanner::ScanCriteria::parse("120.5,64~0.5"));
+        hits = valueScanner.getCandidates().getAddresses(10);
+        bool pair = hits.size() == 1 && hits[0] == 0x600104;
+        std::cout << (pair ? "✓" : "✗") << " Vector pair found at 0x600104" << std::endl;
+    }
+    
+    // Test 8: Several types scanned in a single pass
+    std::cout << "\nTest 8: Multi-Type Scan" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        scanner::ValueScanner valueScanner(&provider);
+        
+        std::vector<uint8_t> level(0x1000, 0x00);
+        int16_t lives = 3;
+        float timer = 3.0f;
+        std::memcpy(&level[0x22], &lives, sizeof(lives));
+        std::memcpy(&level[0x40], &timer, sizeof(timer));
+        provider.addMemoryRegion(0x600000, level);
+        
+        std::vector<scanner::ScanTypeSpec> types = {
+            scanner::ValueType::INT16, scanner::ValueType::INT32, scanner::ValueType::FLOAT
+        };
+        valueScanner.firstScan(types, scanner::ScanCriteria::parse("3"));
+        const std::vector<scanner::TypedCandidates>& results = valueScanner.getResults();
+        bool perType = results.size() == 3 &&
+            results[0].candidates.getAddresses(10) == std::vector<uintptr_t>{0x600022} &&
+            results[1].candidates.count() == 0 &&
+            results[2].candidates.getAddresses(10) == std::vector<uintptr_t>{0x600040};
+        std::cout << (perType ? "✓" : "✗") << " One pass found int16 and float hits" << std::endl;
+        
+        // Lives drop to 2; the float stays at 3.0
+        lives = 2;
+        std::memcpy(&level[0x22], &lives, sizeof(lives));
+        provider.addMemoryRegion(0x600000, level);
+        valueScanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::DECREASED));
+        const std::vector<scanner::TypedCandidates>& next = valueScanner.getResults();
+        bool narrowed = next[0].candidates.count() == 1 && next[2].candidates.count() == 0;
+        std::cout << (narrowed ? "✓" : "✗") << " Next scan narrowed every type" << std::endl;
+        
+        valueScanner.firstScan(scanner::ValueType::INT16, scanner::ScanCriteria::parse("100000"));
+        std::cout << (valueScanner.getCandidates().empty() ? "✓" : "✗")
+                  << " Out-of-range int16 operand matches nothing" << std::endl;
+    }
+    
+    // Test 9: ASCII and UTF-16 string scans
+    std::cout << "\nTest 9: String Scanning" << std::endl;
+    {
+        scanner::PatternScanner stringScanner(std::make_unique<scanner::MockMemoryProvider>());
+        
+        memory::PatternResult result;
+        bool ascii = stringScanner.scanString("Icy Island", 0x580000, 0x1000, result) &&
+                     result.address == 0x580100;
+        std::cout << (ascii ? "✓" : "✗") << " ASCII string found at 0x580100" << std::endl;
+        
+        scanner::StringScanOptions options;
+        options.caseInsensitive = true;
+        bool folded = stringScanner.scanString("ICY island", 0x580000, 0x1000, result, options) &&
+                      result.address == 0x580100;
+        std::cout << (folded ? "✓" : "✗") << " Case-insensitive match" << std::endl;
+        
+        options.encoding = scanner::StringEncoding::UTF16LE;
+        scanner::ScanResultStore wide(stringScanner.getMemoryProvider());
+        stringScanner.scanStringAll("antarctica", wide, options);
+        bool utf16 = wide.size() == 1 && wide.getAddress(0) == 0x580200 + 11 * 2 &&
+                     wide.get(0).matchedBytes.size() == 20;
+        std::cout << (utf16 ? "✓" : "✗") << " UTF-16LE string found across regions" << std::endl;
+        
+        options.encoding = scanner::StringEncoding::ASCII;
+        options.caseInsensitive = false;
+        scanner::ScanResultStore none(stringScanner.getMemoryProvider());
+        std::cout << (stringScanner.scanStringAll("icy island", none, options) == 0 ? "✓" : "✗")
+                  << " Case-sensitive scan rejects wrong case" << std::endl;
+    }
+    
+    // Test 10: Group scan at fixed relative offsets
+    std::cout << "\nTest 10: Group Scan" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        scanner::ValueScanner valueScanner(&provider);
+        
+        // Decoys: lone health/coin values without the other member nearby
+        std::vector<uint8_t> level(0x1000, 0x00);
+        int32_t decoys[] = { 100, 7, 7, 50 };
+        std::memcpy(&level[0x80], decoys, sizeof(decoys));
+        provider.addMemoryRegion(0x600000, level);
+        
+        std::vector<scanner::GroupMember> group = {
+            { 0, scanner::ValueType::INT32, scanner::ScanCriteria::parse("100") },
+            { 4, scanner::ValueType::INT32, scanner::ScanCriteria::parse("50") }
+        };
+        valueScanner.groupScan(group);
+        std::vector<uintptr_t> hits = valueScanner.getCandidates().getAddresses(10);
+        bool found = hits.size() == 1 && hits[0] == 0x501000;
+        std::cout << (found ? "✓" : "✗") << " Health/coins group found at 0x501000" << std::endl;
+        
+        // Offsets may be negative and members of different types
+        group = {
+            { 0, scanner::ValueType::INT32, scanner::ScanCriteria::parse("50") },
+            { -4, scanner::ValueType::INT16, scanner::ScanCriteria::parse("100") }
+        };
+        valueScanner.groupScan(group);
+        hits = valueScanner.getCandidates().getAddresses(10);
+        bool mixed = hits.size() == 1 && hits[0] == 0x501004;
+        std::cout << (mixed ? "✓" : "✗") << " Mixed-type group with negative offset" << std::endl;
+        
+        // The alignment applies to the first member, not to the group base
+        int16_t lives = 777;
+        int32_t score = 4242;
+        std::memcpy(&level[0x304], &lives, sizeof(lives));
+        std::memcpy(&level[0x308], &score, sizeof(score));
+        provider.addMemoryRegion(0x600000, level);
+        group = {
+            { 2, scanner::ValueType::INT16, scanner::ScanCriteria::parse("777") },
+            { 6, scanner::ValueType::INT32, scanner::ScanCriteria::parse("4242") }
+        };
+        valueScanner.groupScan(group, 4);
+        hits = valueScanner.getCandidates().getAddresses(10);
+        bool firstAligned = hits.size() == 1 && hits[0] == 0x600304;
+        std::cout << (firstAligned ? "✓" : "✗") << " First member at offset 2 aligned to 4 bytes" << std::endl;
+    }
+    
+    // Test 11: Compact scan result store
+    std::cout << "\nTest 11: Scan Result Store" << std::endl;
+    {
+        scanner::PatternScanner patternScanner(std::make_unique<scanner::MockMemoryProvider>());
+        
+        // 0x90 fills the mock module, so this yields ~1M hits
+        scanner::ScanResultStore nops(patternScanner.getMemoryProvider(), 0);
+        size_t found = patternScanner.scanAll(memory::Pattern("90 90", "NOP pair"), nops);
+        bool compact = found > 1000000 && nops.patternCount() == 1 &&
+                       nops.memoryUsage() < found * 32;
+        std::cout << (compact ? "✓" : "✗") << " " << found << " hits stored in "
+                  << nops.memoryUsage() << " bytes" << std::endl;
+        
+        memory::PatternResult first = nops.get(0);
+        bool bytes = first.patternName == "NOP pair" &&
+                     first.matchedBytes == std::vector<uint8_t>{0x90, 0x90};
+        std::cout << (bytes ? "✓" : "✗") << " Matched bytes captured in the arena" << std::endl;
+        
+        // A low threshold moves the columns into a memory-mapped file
+        scanner::ScanResultStore spilled(patternScanner.getMemoryProvider(), 1000);
+        patternScanner.scanAll(memory::Pattern("8B 05 ?? ?? ?? ??", "Health Access"), spilled);
+        patternScanner.scanStringAll("Icy Island", spilled);
+        size_t before = spilled.size();
+        patternScanner.scanAll(memory::Pattern("90 90 90 90", "NOP run"), spilled, 5000);
+        bool spill = spilled.isSpilled() && spilled.size() == before + 5000 &&
+                     spilled.getAddress(0) == 0x412345 && spilled.getAddress(1) == 0x580100 &&
+                     spilled.get(1).matchedBytes.size() == 10 &&
+                     spilled.getPatternName(spilled.getPatternId(before + 4999)) == "NOP run";
+        std::cout << (spill ? "✓" : "✗") << " Spilled store keeps hits and interned names" << std::endl;
+
+#if defined(__linux__)
+        // With the temp file capped at 64 KiB the 8-byte columns stop at 8192 rows
+        rlimit fileLimit;
+        getrlimit(RLIMIT_FSIZE, &fileLimit);
+        rlimit cappedLimit = fileLimit;
+        cappedLimit.rlim_cur = 64 * 1024;
+        void (*previous)(int) = std::signal(SIGXFSZ, SIG_IGN);
+        setrlimit(RLIMIT_FSIZE, &cappedLimit);
+        scanner::ScanResultStore capped(patternScanner.getMemoryProvider(), 16);
+        size_t kept = patternScanner.scanAll(memory::Pattern("90 90", "NOP pair"), capped);
+        const uint8_t nop[] = {0x90, 0x90};
+        bool refused = !capped.add(0x1000, capped.getPatternId(0), nop);
+        setrlimit(RLIMIT_FSIZE, &fileLimit);
+        std::signal(SIGXFSZ, previous);
+        bool aligned = capped.isSpilled() && kept == 8192 && refused && capped.size() == 8192 &&
+                       capped.get(8191).matchedBytes == std::vector<uint8_t>{0x90, 0x90} &&
+                       capped.get(8191).patternName == "NOP pair";
+        std::cout << (aligned ? "✓" : "✗") << " Full spill file stops the scan at " << kept
+                  << " hits with aligned columns" << std::endl;
+#endif
+    }
+    
+    // Test 12: Copy-on-write scan history
+    std::cout << "\nTest 12: Scan History" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        scanner::ValueScanner valueScanner(&provider);
+        
+        std::vector<uint8_t> zeros(0x100000, 0x00);
+        provider.addMemoryRegion(0x700000, zeros);
+        
+        valueScanner.firstScan(scanner::ValueType::INT32,
+                               scanner::ScanCriteria(scanner::ScanCompare::EXACT,
+                                                     scanner::ScanValue::fromInt(0)));
+        const scanner::ScanSession& session = valueScanner.getSession();
+        size_t rootCount = valueScanner.getCandidates().count();
+        size_t rootBytes = session.memoryUsage();
+        
+        // Touch one block; every other block is shared with the root
+        *reinterpret_cast<uint32_t*>(&zeros[0x8000]) = 1;
+        provider.addMemoryRegion(0x700000, zeros);
+        valueScanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::UNCHANGED));
+        size_t growth = session.memoryUsage() - rootBytes;
+        bool shared = valueScanner.getCandidates().count() == rootCount - 1 && growth < rootBytes / 4;
+        std::cout << (shared ? "✓" : "✗") << " Filter step added " << growth
+                  << " bytes to a " << rootBytes << " byte history" << std::endl;
+        
+        bool undo = valueScanner.undo() && valueScanner.getCandidates().count() == rootCount &&
+                    !valueScanner.undo() && session.canRedo();
+        std::cout << (undo ? "✓" : "✗") << " Undo restores the previous candidates" << std::endl;
+        
+        bool redo = valueScanner.redo() && valueScanner.getCandidates().count() == rootCount - 1;
+        std::cout << (redo ? "✓" : "✗") << " Redo re-applies the filter" << std::endl;
+        
+        // Branching from the root discards the redo entry
+        valueScanner.undo();
+        valueScanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::CHANGED));
+        std::vector<uintptr_t> hits = valueScanner.getCandidates().getAddresses(10);
+        bool branch = session.current()->depth == 1 && !session.canRedo() &&
+                      hits.size() == 1 && hits[0] == 0x708000;
+        std::cout << (branch ? "✓" : "✗") << " New step from the root found 0x708000" << std::endl;
+        
+        // A range filter on an unknown-value snapshot is a child of it, not a new history
+        valueScanner.firstScanUnknown(scanner::ValueType::INT32);
+        valueScanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::EXACT, scanner::ScanValue::fromInt(1)));
+        hits = valueScanner.getCandidates().getAddresses(10);
+        bool filtered = session.current()->depth == 1 && hits.size() == 1 && hits[0] == 0x708000;
+        bool backToSnapshot = valueScanner.undo() && session.current()->depth == 0 &&
+                              valueScanner.getSnapshot() != nullptr && valueScanner.redo() &&
+                              valueScanner.getCandidates().count() == 1;
+        std::cout << (filtered && backToSnapshot ? "✓" : "✗") << " Range filter on a snapshot undoes back to it"
+                  << std::endl;
+    }
+    
+    // Test 13: Background value freezer
+    std::cout << "\nTest 13: Value Freezer" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        trainer::ValueFreezer freezer(&provider, 200);
+        
+        // Health and coins are adjacent and share one write; the float does not
+        freezer.freeze(0x501000, scanner::ValueType::INT32, scanner::ScanValue::fromInt(100));
+        freezer.freeze(0x501004, scanner::ValueType::INT32, scanner::ScanValue::fromInt(99));
+        freezer.freeze(0x502000, scanner::ValueType::FLOAT, scanner::ScanValue::fromFloat(2.5));
+        bool readOnly = !freezer.freeze(0x580100, scanner::ValueType::INT8, scanner::ScanValue::fromInt(1));
+        std::cout << (freezer.writesPerTick() == 2 && readOnly ? "✓" : "✗")
+                  << " Three values coalesced into " << freezer.writesPerTick() << " writes" << std::endl;
+        
+        int32_t coins = 0;
+        provider.writeMemory(0x501004, &coins, sizeof(coins));
+        freezer.tick();
+        provider.readMemory(0x501004, &coins, sizeof(coins));
+        std::cout << (coins == 99 ? "✓" : "✗") << " Tick restored coins to " << coins << std::endl;
+        
+        freezer.start();
+        int32_t health = 1;
+        provider.writeMemory(0x501000, &health, sizeof(health));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        freezer.stop();
+        provider.readMemory(0x501000, &health, sizeof(health));
+        trainer::FreezerStats stats = freezer.getStats();
+        bool held = health == 100 && stats.ticks > 2 && stats.failedWrites == 0;
+        std::cout << (held ? "✓" : "✗") << " Thread held health over " << stats.ticks
+                  << " ticks (max " << stats.maxTickNanos << " ns)" << std::endl;
+    }
+    
+    // Test 14: Batched writes with per-entry results
+    std::cout << "\nTest 14: Batched Writes" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        uint32_t lives = 9;
+        float speed = 4.0f;
+        std::vector<scanner::MemoryWrite> writes = {
+            {0x501000, &lives, sizeof(lives)},
+            {0x580100, &lives, sizeof(lives)},     // read-only level data
+            {0x502000, &speed, sizeof(speed)}
+        };
+        std::vector<scanner::WriteResult> results;
+        size_t written = provider.writeMemoryBatch(writes, results, true);
+        bool perEntry = written == 2 && results[0] == scanner::WriteResult::WRITE_OK &&
+                        results[1] == scanner::WriteResult::WRITE_FAILED &&
+                        results[2] == scanner::WriteResult::WRITE_OK;
+        std::cout << (perEntry ? "✓" : "✗") << " Mock batch reported each entry" << std::endl;
+
+#if defined(__linux__)
+        // Our own process stands in for the game
+        scanner::LinuxMemoryProvider self(getpid());
+        std::vector<uint32_t> target(4, 0);
+        uint32_t values[] = {11, 22, 33};
+        writes = {
+            {reinterpret_cast<uintptr_t>(&target[0]), &values[0], sizeof(uint32_t)},
+            {0x10, &values[1], sizeof(uint32_t)},  // unmapped
+            {reinterpret_cast<uintptr_t>(&target[3]), &values[2], sizeof(uint32_t)}
+        };
+        written = self.writeMemoryBatch(writes, results, true);
+        bool scatter = written == 2 && target[0] == 11 && target[3] == 33 &&
+                     results[1] == scanner::WriteResult::WRITE_FAILED;
+        std::cout << (scatter ? "✓" : "✗") << " process_vm_writev batch skipped the bad entry" << std::endl;
+        
+        uint32_t readBack = 0;
+        bool read = self.readMemory(reinterpret_cast<uintptr_t>(&target[3]), &readBack, sizeof(readBack)) &&
+                    readBack == 33 && !self.getMemoryRegions().empty();
+        std::cout << (read ? "✓" : "✗") << " Linux provider reads and maps its target" << std::endl;
+#endif
+    }
+    
+    // Test 15: Adaptive watch-list polling
+    std::cout << "\nTest 15: Watch List" << std::endl;
+    {
+        scanner::MockMemoryProvider provider;
+        trainer::WatchList watches(&provider, std::chrono::milliseconds(10), std::chrono::milliseconds(500));
+        
+        // A 32-bit pointer at 0x501200 leads to the player struct at 0x501000
+        uint32_t player = 0x501000;
+        provider.writeMemory(0x501200, &player, sizeof(player));
+        trainer::PointerChain chain;
+        chain.base = 0x501200;
+        chain.offsets = {0x8};
+        chain.pointerSize = 4;
+        
+        trainer::WatchId position = watches.add(chain, scanner::ValueType::FLOAT);
+        trainer::WatchId health = watches.add(0x501000, scanner::ValueType::INT32);
+        
+        size_t notified = 0;
+        watches.subscribe([&](const trainer::WatchChange& change) {
+            notified += change.id == position && !change.previous.empty();
+        });
+        
+        // Simulate two seconds: the position moves every 10 ms, health never changes
+        auto now = std::chrono::steady_clock::now();
+        for (int step = 0; step < 200; ++step) {
+            float x = static_cast<float>(step);
+            provider.writeMemory(0x501008, &x, sizeof(x));
+            watches.poll(now + std::chrono::milliseconds(step * 10));
+        }
+        
+        std::vector<trainer::WatchEntry> entries = watches.getEntries();
+        const trainer::WatchEntry& moving = entries[position - 1];
+        const trainer::WatchEntry& still = entries[health - 1];
+        bool adaptive = moving.interval.count() == 10 && moving.changes == 199 && notified == 199 &&
+                        moving.address == 0x501008 && still.interval.count() == 500;
+        std::cout << (adaptive ? "✓" : "✗") << " Position polled every " << moving.interval.count()
+                  << " ms, health every " << still.interval.count() << " ms" << std::endl;
+        
+        trainer::WatchStats stats = watches.getStats();
+        bool batched = stats.entryReads < 220 && stats.batches <= 2 * stats.polls;
+        std::cout << (batched ? "✓" : "✗") << " " << stats.entryReads << " entry reads in "
+                  << stats.batches << " batches over " << stats.polls << " polls" << std::endl;
+    }
+    
+    // Test 16: Page-hash change detection on rescans
+    std::cout << "\nTest 16: Page Hash Rescans" << std::endl;
+    {
+        // 64 KiB of zeros: dense candidates whose pages mostly never change
+        scanner::MockMemoryProvider provider;
+        provider.addMemoryRegion(0x600000, std::vector<uint8_t>(0x10000, 0));
+        
+        scanner::ValueScanner scanner(&provider);
+        scanner.firstScan(scanner::ValueType::INT32, scanner::ScanCriteria::parse("0"));
+        size_t zeros = scanner.getCandidates().count();
+        
+        // One page really changes; another is rewritten with the same bytes
+        int32_t bumped = 5;
+        int32_t same = 0;
+        provider.writeMemory(0x603010, &bumped, sizeof(bumped));
+        provider.writeMemory(0x608000, &same, sizeof(same));
+        scanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::CHANGED));
+        std::vector<uintptr_t> changed = scanner.getCandidates().getAddresses(8);
+        bool found = changed.size() == 1 && changed[0] == 0x603010;
+        std::cout << (found ? "✓" : "✗") << " Changed value found" << std::endl;
+        
+        const scanner::PageScanStats& stats = scanner.getPageStats();
+        bool skipped = stats.pagesCompared == 1 && stats.pagesSkipped == 1;
+        std::cout << (skipped ? "✓" : "✗") << " Compared " << stats.pagesCompared
+                  << " page(s), skipped " << stats.pagesSkipped << " by hash" << std::endl;
+        
+        // Unchanged pages keep all their candidates without a compare
+        scanner.undo();
+        scanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::UNCHANGED));
+        bool kept = scanner.getCandidates().count() == zeros - 1;
+        std::cout << (kept ? "✓" : "✗") << " " << scanner.getCandidates().count()
+                  << " unchanged candidates kept" << std::endl;
+    }
+    
+    // Test 17: Written-page tracking
+    std::cout << "\nTest 17: Write Tracking" << std::endl;
+    {
+        // The mock counts its own writes as writes by the target
+        scanner::MockMemoryProvider provider;
+        provider.addMemoryRegion(0x600000, std::vector<uint8_t>(0x10000, 0));
+        
+        scanner::ValueScanner scanner(&provider);
+        scanner.firstScan(scanner::ValueType::INT32, scanner::ScanCriteria::parse("0"));
+        int32_t bumped = 5;
+        provider.writeMemory(0x603010, &bumped, sizeof(bumped));
+        scanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::CHANGED));
+        
+        const scanner::PageScanStats& stats = scanner.getPageStats();
+        bool untouched = scanner.getCandidates().count() == 1 && stats.pagesCompared == 1 &&
+                         stats.pagesUntouched >= 15;
+        std::cout << (untouched ? "✓" : "✗") << " " << stats.pagesUntouched
+                  << " unwritten pages skipped without a read" << std::endl;
+        
+        // A write landing while the pages are collected counts toward the next filter
+        int collects = 0;
+        provider.setCollectHook([&] {
+            if (collects++ == 0) {
+                int32_t late = 7;
+                provider.writeMemory(0x605020, &late, sizeof(late));
+            }
+        });
+        scanner.firstScan(scanner::ValueType::INT32, scanner::ScanCriteria::parse("0"));
+        scanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::UNCHANGED));
+        scanner.nextScan(scanner::ScanCriteria(scanner::ScanCompare::CHANGED));
+        std::vector<uintptr_t> late = scanner.getCandidates().getAddresses(10);
+        bool seen = late == std::vector<uintptr_t>{0x605020};
+        std::cout << (seen ? "✓" : "✗") << " Write during collection seen by the next filter" << std::endl;
+        provider.setCollectHook(nullptr);
+
+#if defined(__linux__)
+        // Soft-dirty bits of our own pages
+        scanner::LinuxMemoryProvider self(getpid());
+        const size_t pageBytes = scanner::IMemoryProvider::PAGE_STATE_BYTES;
+        void* mapping = mmap(nullptr, 4 * pageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        uint8_t* pages = static_cast<uint8_t*>(mapping);
+        std::memset(pages, 1, 4 * pageBytes);
+        
+        if (self.checkpointWrites()) {
+            pages[2 * pageBytes + 100] = 2;
+            std::vector<bool> written;
+            bool dirty = self.getWrittenPages(reinterpret_cast<uintptr_t>(pages), 4 * pageBytes, written) &&
+                         written == std::vector<bool>{false, false, true, false};
+            std::cout << (dirty ? "✓" : "✗") << " Soft-dirty bits report the one written page" << std::endl;
+            
+            // We cannot stop ourselves between the read and the clear, so nothing is reported
+            std::vector<std::vector<bool>> collected;
+            self.collectWrittenPages({scanner::MemoryRegion(reinterpret_cast<uintptr_t>(pages), 4 * pageBytes)},
+                                     collected);
+            bool unreported = collected.size() == 1 && collected[0].empty();
+            std::cout << (unreported ? "✓" : "✗") << " Own pages not collected without a pause" << std::endl;
+        } else {
+            std::cout << "✓ Soft-dirty tracking unavailable on this kernel" << std::endl;
+        }
+        munmap(mapping, 4 * pageBytes);
+#endif
+    }
+    
+    // Test 18: Skipping untouched and zero pages
+    std::cout << "\nTest 18: Zero Page Skipping" << std::endl;
+    {
+        auto mock = std::make_unique<scanner::MockMemoryProvider>();
+        scanner::MockMemoryProvider* provider = mock.get();
+        
+        // 4 MiB reserved but never touched, and a mostly zero heap where one
+        // match starts with zeros at the end of a zero page
+        provider->addReservedRegion(0x10000000, 4 * 1024 * 1024);
+        std::vector<uint8_t> heap(0x10000, 0);
+        const uint8_t match[] = {0x00, 0x00, 0xC3, 0x7E, 0x5A};
+        std::memcpy(&heap[0x2FFE], match, sizeof(match));
+        std::memcpy(&heap[0x8100], match, sizeof(match));
+        provider->addMemoryRegion(0x20000000, heap);
+        
+        scanner::PatternScanner patternScanner(std::move(mock));
+        scanner::ScanResultStore found(patternScanner.getMemoryProvider(), 0);
+        patternScanner.scanAll(memory::Pattern("00 00 C3 7E 5A", "Straddling"), found);
+        bool exact = found.size() == 2 && found.getAddress(0) == 0x20002FFE && found.getAddress(1) == 0x20008100;
+        std::cout << (exact ? "✓" : "✗") << " Found " << found.size() << " matches, including one across a zero page" << std::endl;
+        
+        const scanner::RegionScanStats& stats = patternScanner.getLastScanStats();
+        bool skipped = stats.pagesUntouched == 1024 && stats.pagesZero >= 14;
+        std::cout << (skipped ? "✓" : "✗") << " " << stats.pagesUntouched << " untouched pages not read, "
+                  << stats.pagesZero << " zero pages not searched" << std::endl;
+
+#if defined(__linux__)
+        // Residency of our own anonymous pages
+        scanner::LinuxMemoryProvider self(getpid());
+        const size_t pageBytes = scanner::IMemoryProvider::PAGE_STATE_BYTES;
+        void* mapping = mmap(nullptr, 4 * pageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        uint8_t* pages = static_cast<uint8_t*>(mapping);
+        pages[pageBytes] = 1;
+        
+        self.getMemoryRegions();
+        std::vector<bool> untouched;
+        bool resident = self.getUntouchedPages(reinterpret_cast<uintptr_t>(pages), 4 * pageBytes, untouched) &&
+                        untouched == std::vector<bool>{true, false, true, true};
+        std::cout << (resident ? "✓" : "✗") << " pagemap reports the three untouched pages" << std::endl;
+        munmap(mapping, 4 * pageBytes);
+#endif
+    }
+
+#if defined(__linux__) && defined(__x86_64__)
+    // Test 19: Debug register watchpoints on a forked two-thread writer
+    std::cout << "\nTest 19: Hardware Watchpoints" << std::endl;
+    {
+        pid_t child = fork();
+        if (child == 0) {
+            std::thread second(writeWatchedCounter);
+            writeWatchedCounter();
+        }
+        
+        trainer::HardwareWatchpoints watchpoints(child, 64);
+        if (!watchpoints.attach()) {
+            std::cout << "✓ ptrace unavailable, hardware watchpoints skipped" << std::endl;
+        } else {
+            uintptr_t address = reinterpret_cast<uintptr_t>(&g_watchedCounter);
+            int slot = watchpoints.set(address, 4, trainer::WatchpointKind::WRITE);
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            
+            std::vector<trainer::WatchpointHit> hits;
+            watchpoints.drain(hits);
+            uintptr_t writer = reinterpret_cast<uintptr_t>(&writeWatchedCounter);
+            std::set<int> threadIds;
+            bool inWriter = !hits.empty();
+            for (const auto& hit : hits) {
+                threadIds.insert(hit.threadId);
+                inWriter = inWriter && hit.slot == slot && hit.address == address &&
+                           hit.rip > writer && hit.rip < writer + 256 && hit.registers.rip == hit.rip;
+            }
+            std::cout << (slot == 0 && inWriter ? "✓" : "✗") << " " << hits.size()
+                      << " write hits, all from the writer loop" << std::endl;
+            std::cout << (threadIds.size() == 2 ? "✓" : "✗") << " Hits from "
+                      << threadIds.size() << " threads" << std::endl;
+            
+            std::vector<trainer::AccessSite> sites = watchpoints.getAccessSites();
+            bool site = !sites.empty() && sites[0].rip > writer && sites[0].rip < writer + 256 &&
+                        watchpoints.getStats().hits >= hits.size();
+            std::cout << (site ? "✓" : "✗") << " Writer instruction reported as access site" << std::endl;
+            
+            watchpoints.detach();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            bool running = waitpid(child, nullptr, WNOHANG) == 0 && !watchpoints.isAttached();
+            std::cout << (running ? "✓" : "✗") << " Target keeps running after detach" << std::endl;
+        }
+        
+        kill(child, SIGKILL);
+        waitpid(child, nullptr, 0);
+    }
+#endif
+    
+    // Test 20: Hash-indexed hook registry
+    std::cout << "\nTest 20: Hook Registry" << std::endl;
+    {
+        hooks::HookRegistry registry;
+        std::vector<hooks::HookHandle> handles;
+        for (uintptr_t i = 0; i < 1000; ++i) {
+            handles.push_back(registry.insert(hooks::HookInfo("h", 0x400000 + i * 16, 0x900000 + i)));
+        }
+        bool found = registry.size() == 1000;
+        for (uintptr_t i = 0; i < 1000; ++i) {
+            found = found && registry.find(0x400000 + i * 16) == handles[i] &&
+                    registry.getTarget(handles[i]) == 0x400000 + i * 16;
+        }
+        bool duplicate = registry.insert(hooks::HookInfo("dup", 0x400000, 0x1)) == hooks::HookHandle::INVALID;
+        std::cout << (found && duplicate ? "✓" : "✗") << " 1000 hooks found by target, duplicate rejected" << std::endl;
+        
+        // Churn: erase the even hooks and register new targets in their records
+        for (size_t i = 0; i < 1000; i += 2) {
+            registry.erase(handles[i]);
+        }
+        for (uintptr_t i = 0; i < 500; ++i) {
+            registry.insert(hooks::HookInfo("n", 0x800000 + i * 16, 0x1));
+        }
+        bool stale = !registry.setEnabled(handles[0], true) && registry.find(0x400000) == hooks::HookHandle::INVALID &&
+                     registry.setEnabled(handles[1], true) && registry.isEnabled(handles[1]) &&
+                     registry.find(0x800000 + 499 * 16) != hooks::HookHandle::INVALID && registry.size() == 1000;
+        std::cout << (stale ? "✓" : "✗") << " Erased handles stay stale after their records are reused" << std::endl;
+        
+        hooks::MinHookWrapper::initialize();
+        hooks::FunctionHook hook("test_hook", 0x401000, 0x402000);
+        bool toggled = hook.install() && hook.enable() && hooks::MinHookWrapper::isHookEnabled(hook.getHandle()) &&
+                       hook.disable() && !hooks::MinHookWrapper::isHookEnabled(hook.getHandle());
+        hooks::HookHandle handle = hook.getHandle();
+        toggled = toggled && hook.remove() &&
+                  hooks::MinHookWrapper::enableHook(handle) == hooks::MHStatus::MH_ERROR_NOT_CREATED;
+        hooks::MinHookWrapper::uninitialize();
+        std::cout << (toggled ? "✓" : "✗") << " FunctionHook toggles through its registry handle" << std::endl;
+    }
+    
+    // Test 21: Queued hook changes applied in one batch
+    std::cout << "\nTest 21: Queued Hook Changes" << std::endl;
+    {
+        hooks::MinHookWrapper::initialize();
+        std::vector<std::unique_ptr<hooks::FunctionHook>> preset;
+        for (uintptr_t i = 0; i < 30; ++i) {
+            preset.push_back(std::make_unique<hooks::FunctionHook>("preset", 0x410000 + i * 0x40, 0x420000));
+            preset.back()->install();
+            preset.back()->queueEnable();
+        }
+        preset[3]->queueDisable();                          // last change wins
+        hooks::HookHandle removed = preset[7]->getHandle();
+        preset[7]->remove();                                // removed while queued
+        
+        bool deferred = !preset[0]->isEnabled();
+        std::vector<hooks::QueuedHookChange> results;
+        hooks::MHStatus status = hooks::MinHookWrapper::applyQueued(&results);
+        
+        bool applied = deferred && results.size() == 30 && status == hooks::MHStatus::MH_ERROR_NOT_CREATED;
+        for (size_t i = 0; i < preset.size(); ++i) {
+            applied = applied && preset[i]->isEnabled() == (i != 3 && i != 7);
+        }
+        for (const auto& change : results) {
+            bool gone = change.handle == removed;
+            applied = applied && (change.status == hooks::MHStatus::MH_OK) != gone;
+        }
+        std::cout << (applied ? "✓" : "✗") << " 28 of 30 queued hooks enabled, removed hook reported" << std::endl;
+        
+        for (auto& hook : preset) {
+            hook->queueDisable();
+        }
+        status = hooks::MinHookWrapper::applyQueued(&results);
+        bool cleared = status == hooks::MHStatus::MH_OK && results.size() == 29 &&
+                       std::none_of(preset.begin(), preset.end(), [](const std::unique_ptr<hooks::FunctionHook>& hook) {
+                           return hook->isEnabled();
+                       });
+        std::cout << (cleared ? "✓" : "✗") << " Preset disabled in one apply pass" << std::endl;
+        
+        preset.clear();
+        hooks::MinHookWrapper::uninitialize();
+    }
+    
+    // Test 22: Hooks toggled from several threads at once
+    std::cout << "\nTest 22: Concurrent Hook Toggling" << std::endl;
+    {
+        hooks::MinHookWrapper::initialize();
+        std::vector<std::unique_ptr<hooks::FunctionHook>> shared;
+        for (uintptr_t i = 0; i < 64; ++i) {
+            shared.push_back(std::make_unique<hooks::FunctionHook>("shared", 0x430000 + i * 0x40, 0x440000));
+            shared.back()->install();
+        }
+        
+        std::atomic<bool> failed{false};
+        std::vector<std::thread> togglers;
+        for (int t = 0; t < 4; ++t) {
+            togglers.emplace_back([&shared, &failed, t] {
+                for (int round = 0; round < 200; ++round) {
+                    for (size_t i = t; i < shared.size(); i += 2) {
+                        bool ok = (round + t) % 2 ? shared[i]->enable() : shared[i]->disable();
+                        if (!ok || hooks::MinHookWrapper::findHook(0x430000 + i * 0x40) != shared[i]->getHandle()) {
+                            failed = true;
+                        }
+                    }
+                }
+            });
+        }
+        
+        // Per-thread status: this thread's error survives the other threads' successes
+        hooks::MinHookWrapper::enableHook(reinterpret_cast<void*>(0x12345));
+        for (auto& toggler : togglers) {
+            toggler.join();
+        }
+        bool ownError = hooks::MinHookWrapper::getLastError() == "Hook not found";
+        
+        std::cout << (!failed ? "✓" : "✗") << " 4 threads toggled 64 shared hooks 200 times" << std::endl;
+        std::cout << (ownError ? "✓" : "✗") << " Last error is per thread: \"" 
+                  << hooks::MinHookWrapper::getLastError() << "\"" << std::endl;
+        
+        shared.clear();
+        hooks::MinHookWrapper::uninitialize();
+    }
+    
+    // Test 23: x86-64 instruction lengths
+    std::cout << "\nTest 23: x86-64 Length Decoder" << std::endl;
+    {
+        struct Sample {
+            std::vector<uint8_t> bytes;
+            size_t length;
+            bool ripRelative;
+        };
+        const std::vector<Sample> samples = {
+            {{0x55}, 1, false},                                                     // push rbp
+            {{0x48, 0x89, 0xE5}, 3, false},                                         // mov rbp, rsp
+            {{0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8}, 10, false},                      // mov rax, imm64
+            {{0x8B, 0x05, 0, 0, 0, 0}, 6, true},                                    // mov eax, [rip]
+            {{0x48, 0x8B, 0x84, 0x24, 0x00, 0x01, 0, 0}, 8, false},                 // mov rax, [rsp+0x100]
+            {{0x66, 0x2E, 0x0F, 0x1F, 0x84, 0, 0, 0, 0, 0}, 10, false},             // nopw cs:[rax+rax]
+            {{0xC7, 0x05, 0, 0, 0, 0, 1, 0, 0, 0}, 10, true},                       // mov dword [rip], imm32
+            {{0x66, 0xC7, 0x00, 0x34, 0x12}, 5, false},                             // mov word [rax], imm16
+            {{0xF7, 0xC0, 1, 0, 0, 0}, 6, false},                                   // test eax, imm32
+            {{0xF7, 0xD0}, 2, false},                                               // not eax
+            {{0x0F, 0x84, 0, 0, 0, 0}, 6, false},                                   // je rel32
+            {{0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x08}, 6, false},                       // palignr xmm0, xmm1, 8
+            {{0xC5, 0xF8, 0x77}, 3, false},                                         // vzeroupper
+            {{0xC4, 0xE2, 0x79, 0x18, 0x05, 0, 0, 0, 0}, 9, true},                  // vbroadcastss xmm0, [rip]
+            {{0x62, 0xF1, 0x7C, 0x48, 0x10, 0x05, 0, 0, 0, 0}, 10, true},           // vmovups zmm0, [rip]
+            {{0xF3, 0x48, 0xA5}, 3, false},                                         // rep movsq
+        };
+        
+        size_t correct = 0;
+        for (const auto& sample : samples) {
+            hooks::X86Instruction instruction;
+            if (hooks::decodeX86(sample.bytes.data(), sample.bytes.size(), instruction) &&
+                instruction.length == sample.length && instruction.ripRelative == sample.ripRelative) {
+                ++correct;
+            }
+        }
+        std::cout << (correct == samples.size() ? "✓" : "✗") << " Decoded " << correct << " of "
+                  << samples.size() << " instruction lengths" << std::endl;
+        
+        const uint8_t branches[] = {0x74, 0x05, 0xE8, 0x10, 0, 0, 0, 0x06};
+        hooks::X86Instruction jcc, call, invalid;
+        bool flow = hooks::decodeX86(branches, sizeof(branches), jcc) && jcc.branch == hooks::X86Branch::JCC_REL &&
+                    jcc.relative == 5 && hooks::decodeX86(branches + 2, 6, call) &&
+                    call.branch == hooks::X86Branch::CALL_REL && call.relative == 0x10 &&
+                    !hooks::decodeX86(branches + 7, 1, invalid) && !hooks::decodeX86(branches + 2, 3, call);
+        std::cout << (flow ? "✓" : "✗") << " Relative branches decoded, invalid and truncated input rejected" << std::endl;
+    }
+
+#if defined(__linux__) && defined(__x86_64__)
+    // Test 24: Inline hooks of functions in this process
+    std::cout << "\nTest 24: Inline Hooks" << std::endl;
+    {
+        hooks::MinHookWrapper::initialize(hooks::HookEngine::INLINE);
+        volatile AddFunction add = craftAdd();
+        uint8_t prologue[16];
+        std::memcpy(prologue, reinterpret_cast<const void*>(add), sizeof(prologue));
+        
+        hooks::FunctionHook hook("add", reinterpret_cast<uintptr_t>(add), reinterpret_cast<uintptr_t>(addDetour));
+        bool installed = hook.install() && hook.getOriginal() != reinterpret_cast<uintptr_t>(add);
+        g_addOriginal = reinterpret_cast<AddFunction>(hook.getOriginal());
+        bool untouched = installed && add(2, 3) == 5 && hook.callOriginal<int>(2, 3) == 5;
+        bool detoured = installed && hook.enable() && add(2, 3) == 50 && hook.callOriginal<int>(4, 5) == 9;
+        bool restored = installed && hook.disable() && add(2, 3) == 5 &&
+                        std::memcmp(prologue, reinterpret_cast<const void*>(add), sizeof(prologue)) == 0;
+        std::cout << (untouched ? "✓" : "✗") << " Hook installed, trampoline runs the original" << std::endl;
+        std::cout << (detoured ? "✓" : "✗") << " Enabled hook detours calls to the detour" << std::endl;
+        std::cout << (restored ? "✓" : "✗") << " Disabled hook restores the prologue" << std::endl;
+        
+        // Calls keep returning one of the two results while the jump is rewritten
+        std::atomic<bool> stop{false};
+        std::atomic<bool> torn{false};
+        std::thread caller([&] {
+            while (!stop) {
+                int result = add(2, 3);
+                if (result != 5 && result != 50) {
+                    torn = true;
+                }
+            }
+        });
+        int toggles = 0;
+        for (int i = 0; i < 2000; ++i) {
+            toggles += hook.enable() && hook.disable();
+        }
+        stop = true;
+        caller.join();
+        std::cout << (installed && toggles == 2000 && !torn ? "✓" : "✗") << " " << toggles
+                  << " toggles under concurrent calls" << std::endl;
+        hook.remove();
+        munmap(reinterpret_cast<void*>(add), static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        
+        // Hand-written code: a RIP-relative load, and a Jcc and call in the stolen bytes
+        long page = sysconf(_SC_PAGESIZE);
+        uint8_t* code = static_cast<uint8_t*>(mmap(nullptr, page, PROT_READ | PROT_WRITE,
+                                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        const uint8_t load[] = {0x8B, 0x05, 0xFA, 0x00, 0x00, 0x00,                 // mov eax, [rip+0xFA]
+                                0x01, 0xF8, 0xC3};                                  // add eax, edi; ret
+        const uint8_t branch[] = {0x85, 0xFF, 0x74, 0x0A,                           // test edi, edi; je +10
+                                  0xE8, 0x17, 0x00, 0x00, 0x00,                     // call +0x17
+                                  0x83, 0xC0, 0x01, 0xC3, 0xCC,                     // add eax, 1; ret
+                                  0xB8, 0x07, 0x00, 0x00, 0x00, 0xC3};              // mov eax, 7; ret
+        const uint8_t helper[] = {0xB8, 0x64, 0x00, 0x00, 0x00, 0xC3};              // mov eax, 100; ret
+        int32_t constant = 42;
+        std::memset(code, 0xCC, page);
+        std::memcpy(code, load, sizeof(load));
+        std::memcpy(code + 0x20, branch, sizeof(branch));
+        std::memcpy(code + 0x40, helper, sizeof(helper));
+        std::memcpy(code + 0x100, &constant, sizeof(constant));
+        mprotect(code, page, PROT_READ | PROT_EXEC);
+        
+        auto loadFunction = reinterpret_cast<CraftedFunction>(code);
+        auto branchFunction = reinterpret_cast<CraftedFunction>(code + 0x20);
+        
+        hooks::FunctionHook loadHook("load", reinterpret_cast<uintptr_t>(code), reinterpret_cast<uintptr_t>(craftedDetour));
+        g_craftedOriginal = loadHook.install() ? reinterpret_cast<CraftedFunction>(loadHook.getOriginal()) : nullptr;
+        bool relocatedLoad = g_craftedOriginal && loadHook.enable() && loadFunction(1) == 1043 &&
+                             g_craftedOriginal(1) == 43;
+        loadHook.remove();
+        std::cout << (relocatedLoad ? "✓" : "✗") << " RIP-relative load relocated into the trampoline" << std::endl;
+        
+        hooks::FunctionHook branchHook("branch", reinterpret_cast<uintptr_t>(code + 0x20),
+                                       reinterpret_cast<uintptr_t>(craftedDetour));
+        g_craftedOriginal = branchHook.install() ? reinterpret_cast<CraftedFunction>(branchHook.getOriginal()) : nullptr;
+        bool relocatedBranches = g_craftedOriginal && branchHook.enable() && branchFunction(0) == 1007 &&
+                                 branchFunction(1) == 1101 && g_craftedOriginal(0) == 7 && g_craftedOriginal(1) == 101;
+        branchHook.remove();
+        bool bothRestored = loadFunction(1) == 43 && branchFunction(1) == 101;
+        std::cout << (relocatedBranches ? "✓" : "✗") << " Jcc and call relocated into the trampoline" << std::endl;
+        std::cout << (bothRestored ? "✓" : "✗") << " Removed hooks leave the code as it was" << std::endl;
+        
+        // Data is not code
+        hooks::MHStatus status = hooks::MinHookWrapper::createHook(&constant, reinterpret_cast<void*>(craftedDetour), nullptr);
+        std::cout << (status == hooks::MHStatus::MH_ERROR_NOT_EXECUTABLE ? "✓" : "✗")
+                  << " Non-executable target rejected: " << hooks::MinHookWrapper::getLastError() << std::endl;
+        
+        munmap(code, page);
+        hooks::MinHookWrapper::uninitialize();
+    }
+    
+    // Test 25: Trampolines packed into shared pages near their targets
+    std::cout << "\nTest 25: Trampoline Arena" << std::endl;
+    {
+        hooks::TrampolineArena arena;
+        uintptr_t near = reinterpret_cast<uintptr_t>(addDetour);
+        std::vector<uintptr_t> slots;
+        for (int i = 0; i < 200; ++i) {
+            slots.push_back(arena.allocate(near, 40));
+        }
+        std::set<uintptr_t> distinct(slots.begin(), slots.end());
+        bool packed = distinct.size() == 200 && distinct.count(0) == 0 &&
+                      std::all_of(slots.begin(), slots.end(), [near](uintptr_t slot) {
+                          return hooks::TrampolineArena::isNear(near, slot);
+                      });
+        hooks::ArenaStats stats = arena.getStats();
+        packed = packed && stats.regions == 1 && stats.slotsInUse == 200 && stats.pages == 4;
+        std::cout << (packed ? "✓" : "✗") << " 200 trampolines within ±2 GB in " << stats.pages
+                  << " pages of " << stats.regions << " region" << std::endl;
+        
+        std::set<uintptr_t> freed(slots.begin(), slots.begin() + 100);
+        for (uintptr_t slot : freed) {
+            arena.release(slot);
+        }
+        bool recycled = true;
+        for (int i = 0; i < 100; ++i) {
+            recycled = recycled && freed.count(arena.allocate(near, 64)) == 1;
+        }
+        stats = arena.getStats();
+        recycled = recycled && stats.pages == 4 && stats.regions == 1;
+        std::cout << (recycled ? "✓" : "✗") << " Released slots reused without new pages" << std::endl;
+        
+        uintptr_t relay = arena.allocate(near, 14);
+        const uint8_t code[] = {0xB8, 0x2A, 0x00, 0x00, 0x00, 0xC3};    // mov eax, 42; ret
+        bool runs = relay && arena.write(relay, code, sizeof(code)) && reinterpret_cast<int (*)()>(relay)() == 42;
+        long pageMask = ~(sysconf(_SC_PAGESIZE) - 1);
+        bool ownPage = std::none_of(slots.begin(), slots.end(), [relay, pageMask](uintptr_t slot) {
+            return (slot & pageMask) == (relay & pageMask);
+        });
+        std::cout << (runs && ownPage ? "✓" : "✗") << " Small size class on its own page runs written code" << std::endl;
+        
+        // 64 hooks through the wrapper share the engine's arena
+        hooks::MinHookWrapper::initialize(hooks::HookEngine::INLINE);
+        long page = sysconf(_SC_PAGESIZE);
+        uint8_t* functions = static_cast<uint8_t*>(mmap(nullptr, page, PROT_READ | PROT_WRITE,
+                                                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        std::memset(functions, 0xCC, page);
+        for (int i = 0; i < 64; ++i) {
+            const uint8_t body[] = {0xB8, static_cast<uint8_t>(i), 0x00, 0x00, 0x00, 0xC3};   // mov eax, i; ret
+            std::memcpy(functions + i * 16, body, sizeof(body));
+        }
+        mprotect(functions, page, PROT_READ | PROT_EXEC);
+        
+        hooks::ArenaStats before = hooks::InlinePatcher::arena().getStats();
+        std::vector<std::unique_ptr<hooks::FunctionHook>> many;
+        bool detoured = true;
+        for (int i = 0; i < 64; ++i) {
+            many.push_back(std::make_unique<hooks::FunctionHook>("const", reinterpret_cast<uintptr_t>(functions + i * 16),
+                                                                 reinterpret_cast<uintptr_t>(constantDetour)));
+            detoured = detoured && many.back()->install() && many.back()->enable() &&
+                       reinterpret_cast<CraftedFunction>(functions + i * 16)(0) == -1 &&
+                       many.back()->callOriginal<int>(0) == i;
+        }
+        hooks::ArenaStats during = hooks::InlinePatcher::arena().getStats();
+        many.clear();
+        hooks::ArenaStats after = hooks::InlinePatcher::arena().getStats();
+        bool shared = detoured && during.regions - before.regions <= 1 &&
+                      during.slotsInUse - before.slotsInUse == 128 && after.slotsInUse == before.slotsInUse &&
+                      reinterpret_cast<CraftedFunction>(functions + 5 * 16)(0) == 5;
+        std::cout << (shared ? "✓" : "✗") << " 64 hooks used " << during.regions - before.regions
+                  << " new region(s) and " << during.pages - before.pages << " page(s), slots returned on removal" << std::endl;
+        
+        munmap(functions, page);
+        hooks::MinHookWrapper::uninitialize();
+    }
+#endif
+    
+    // Test 26: Per-hook call counters and latency histograms
+    std::cout << "\nTest 26: Hook Call Statistics" << std::endl;
+    {
+        hooks::HookStats stats;
+        for (int i = 0; i < 1000; ++i) {
+            stats.count();
+            hooks::HookTimer timer(stats);
+        }
+        bool idle = stats.snapshot().calls == 0;
+        std::cout << (idle ? "✓" : "✗") << " Nothing counted while disabled" << std::endl;
+        
+        hooks::HookStats::setEnabled(true);
+        std::vector<std::thread> callers;
+        for (int t = 0; t < 4; ++t) {
+            callers.emplace_back([&stats] {
+                for (int i = 0; i < 100000; ++i) {
+                    stats.count();
+                }
+            });
+        }
+        for (auto& caller : callers) {
+            caller.join();
+        }
+        bool counted = stats.snapshot().calls == 400000;
+        std::cout << (counted ? "✓" : "✗") << " 4 threads counted " << stats.snapshot().calls << " calls" << std::endl;
+        
+        stats.reset();
+        for (int i = 0; i < 90; ++i) {
+            stats.record(100);
+        }
+        for (int i = 0; i < 10; ++i) {
+            stats.record(10000);
+        }
+        hooks::HookStatsSnapshot snapshot = stats.snapshot();
+        bool histogram = snapshot.timedCalls == 100 && snapshot.buckets[6] == 90 && snapshot.buckets[13] == 10 &&
+                         snapshot.percentileNanos(50) == 127 && snapshot.percentileNanos(99) == 16383 &&
+                         std::fabs(snapshot.meanNanos() - 1090.0) < 0.001;
+        std::cout << (histogram ? "✓" : "✗") << " Log buckets: p50 < " << snapshot.percentileNanos(50)
+                  << " ns, p99 < " << snapshot.percentileNanos(99) << " ns" << std::endl;
+
+#if defined(__linux__) && defined(__x86_64__)
+        hooks::MinHookWrapper::initialize(hooks::HookEngine::INLINE);
+        volatile AddFunction add = craftAdd();
+        hooks::FunctionHook timed("timed", reinterpret_cast<uintptr_t>(add),
+                                  reinterpret_cast<uintptr_t>(timedAddDetour));
+        g_timedHook = &timed;
+        bool fired = add && timed.install() && timed.enable();
+        for (int i = 0; i < 1000; ++i) {
+            fired = fired && add(i, 1) == i + 2;
+        }
+        snapshot = timed.stats().snapshot();
+        fired = fired && snapshot.calls == 1000 && snapshot.timedCalls == 1000;
+        std::cout << (fired ? "✓" : "✗") << " Detour timed 1000 calls, avg " << snapshot.meanNanos()
+                  << " ns" << std::endl;
+        timed.remove();
+        munmap(reinterpret_cast<void*>(add), static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        hooks::MinHookWrapper::uninitialize();
+#endif
+        hooks::HookStats::setEnabled(false);
+    }
+    
+    // Test 27: Mid-function hooks with the register context
+    std::cout << "\nTest 27: Mid-Function Hooks" << std::endl;
+#if defined(__linux__) && defined(__x86_64__)
+    {
+        hooks::MinHookWrapper::initialize(hooks::HookEngine::INLINE);
+        long page = sysconf(_SC_PAGESIZE);
+        uint8_t* code = static_cast<uint8_t*>(mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE,
+                                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        uint8_t coins[] = {0x53, 0x89, 0xFB,                                        // push rbx; mov ebx, edi
+                           0x01, 0x1D, 0x00, 0x00, 0x00, 0x00,                      // add [rip+coins], ebx
+                           0x5B, 0xC3};                                             // pop rbx; ret
+        int32_t coinOffset = static_cast<int32_t>(page - 9);                        // coins on the next page
+        std::memcpy(coins + 5, &coinOffset, sizeof(coinOffset));
+        const uint8_t vector[] = {0x66, 0x0F, 0x6E, 0xC7,                           // movd xmm0, edi
+                                  0x66, 0x0F, 0x7E, 0xC0, 0xC3};                    // movd eax, xmm0; ret
+        const uint8_t flags[] = {0x49, 0x89, 0xF8, 0x31, 0xC0,                      // mov r8, rdi; xor eax, eax
+                                 0x83, 0xFF, 0x05, 0x0F, 0x9C, 0xC0,                // cmp edi, 5; setl al
+                                 0x4C, 0x01, 0xC0, 0xC3};                           // add rax, r8; ret
+        std::memset(code, 0xCC, page);
+        std::memcpy(code, coins, sizeof(coins));
+        std::memcpy(code + 0x20, vector, sizeof(vector));
+        std::memcpy(code + 0x40, flags, sizeof(flags));
+        mprotect(code, page, PROT_READ | PROT_EXEC);
+        
+        auto addCoins = reinterpret_cast<void (*)(int)>(code);
+        auto vectorFunction = reinterpret_cast<CraftedFunction>(code + 0x20);
+        auto flagsFunction = reinterpret_cast<CraftedFunction>(code + 0x40);
+        volatile int32_t* coinCount = reinterpret_cast<volatile int32_t*>(code + page);
+        
+        hooks::FunctionHook coinHook("coins", reinterpret_cast<uintptr_t>(code + 3),
+                                     reinterpret_cast<uintptr_t>(coinHandler), hooks::HookType::HOOK_MID);
+        bool doubled = coinHook.install() && coinHook.enable();
+        addCoins(5);
+        doubled = doubled && g_midSeen == 5 && *coinCount == 10;
+        std::cout << (doubled ? "✓" : "✗") << " Handler read the coin register and doubled it: "
+                  << *coinCount << " coins" << std::endl;
+        coinHook.remove();
+        addCoins(5);
+        std::cout << (*coinCount == 15 ? "✓" : "✗") << " Removed hook restores the add" << std::endl;
+        
+        hooks::MHStatus status = hooks::MinHookWrapper::createMidHook(code + 0x24, xmmHandler);
+        bool xmm = status == hooks::MHStatus::MH_OK &&
+                   hooks::MinHookWrapper::enableHook(code + 0x24) == hooks::MHStatus::MH_OK &&
+                   vectorFunction(7) == 1007 && g_midSeen == 7;
+        hooks::MinHookWrapper::removeHook(code + 0x24);
+        std::cout << (xmm ? "✓" : "✗") << " Handler changed XMM0 on an aligned stack" << std::endl;
+        
+        hooks::MinHookWrapper::createMidHook(code + 0x48, clobberHandler);
+        hooks::MinHookWrapper::enableHook(code + 0x48);
+        bool preserved = flagsFunction(3) == 4 && g_midSeen == 1 && flagsFunction(9) == 9;
+        hooks::MinHookWrapper::removeHook(code + 0x48);
+        std::cout << (preserved ? "✓" : "✗") << " Registers and flags clobbered by the handler are restored" << std::endl;
+        
+        munmap(code, 2 * page);
+        hooks::MinHookWrapper::uninitialize();
+    }
+#endif
+    
+    // Test 28: Lock-free event ring from detours to a consumer thread
+    std::cout << "\nTest 28: Hook Event Ring" << std::endl;
+    {
+        auto ring = std::make_unique<hooks::SpscRing<uint64_t, 1024>>();
+        const uint64_t total = 1000000;
+        std::atomic<bool> ordered{true};
+        std::thread consumer([&ring, &ordered, total] {
+            uint64_t batch[128];
+            uint64_t expected = 0;
+            while (expected < total) {
+                size_t count = ring->pop(batch, 128);
+                if (count == 0) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    if (batch[i] != expected++) {
+                        ordered = false;
+                    }
+                }
+            }
+        });
+        for (uint64_t i = 0; i < total; ++i) {
+            while (!ring->push(i)) {
+                std::this_thread::yield();
+            }
+        }
+        consumer.join();
+        std::cout << (ordered ? "✓" : "✗") << " 1000000 items crossed threads in order" << std::endl;
+        
+        // Producer cost alone: fill, then drain on the same thread
+        uint64_t drained[1024];
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < 1000; ++round) {
+            for (uint64_t i = 0; i < 1024; ++i) {
+                ring->push(i);
+            }
+            ring->pop(drained, 1024);
+        }
+        double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  " << nanos / (1000.0 * 1024) << " ns per push and pop" << std::endl;
+        
+        bool full = ring->size() == 0;
+        for (uint64_t i = 0; i < 1024; ++i) {
+            full = full && ring->push(i);
+        }
+        full = full && !ring->push(0) && ring->dropped() > 0 && ring->size() == 1024;
+        std::cout << (full ? "✓" : "✗") << " Full ring rejects and counts the push" << std::endl;
+        
+        auto pump = std::make_unique<hooks::HookEventPump>(std::chrono::milliseconds(1));
+        std::vector<hooks::HookEvent> seen;
+        size_t batches = 0;
+        pump->addSink([&seen, &batches](const hooks::HookEvent* events, size_t count) {
+            seen.insert(seen.end(), events, events + count);
+            ++batches;
+        });
+        for (int i = 0; i < 1000; ++i) {
+            pump->post(hooks::HookEventType::COINS, i, 0x1000, 7);
+        }
+        pump->start();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pump->getDelivered() < 1000 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        pump->post(hooks::HookEventType::LIVES, 3);
+        pump->stop();
+        bool pumped = seen.size() == 1001 && batches < 1001 && seen[999].value == 999 && seen[999].hookId == 7 &&
+                      seen[1000].type == hooks::HookEventType::LIVES && pump->getDropped() == 0;
+        std::cout << (pumped ? "✓" : "✗") << " Consumer thread delivered " << seen.size() << " events in "
+                  << batches << " batches" << std::endl;
+        
+        // Detours on four game threads each post into their own ring
+        seen.clear();
+        pump->start();
+        std::vector<std::thread> producers;
+        for (uint32_t t = 0; t < 4; ++t) {
+            producers.emplace_back([&pump, t] {
+                for (int i = 0; i < 2000; ++i) {
+                    while (!pump->post(hooks::HookEventType::VALUE, i, 0, t)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        pump->stop();
+        std::vector<int64_t> last(4, -1);
+        bool perThread = seen.size() == 8000 && pump->producerCount() == 5;
+        for (const auto& event : seen) {
+            perThread = perThread && event.hookId < 4 && event.value == last[event.hookId] + 1;
+            last[event.hookId] = perThread ? event.value : last[event.hookId];
+        }
+        std::cout << (perThread ? "✓" : "✗") << " 4 posting threads, " << seen.size()
+                  << " events, each thread's in order" << std::endl;
+    }
+    
+    // Test 29: Vtable hooks per instance and per class
+    std::cout << "\nTest 29: VTable Hooks" << std::endl;
+#if defined(__linux__) && defined(__x86_64__)
+    {
+        hooks::MinHookWrapper::initialize(hooks::HookEngine::INLINE);
+        Player hooked;
+        Player other;
+        Actor plain;
+        void* playerVTable = *reinterpret_cast<void**>(&other);
+        
+        hooks::FunctionHook healthHook("health", &hooked, 2, reinterpret_cast<uintptr_t>(healthDetour));
+        bool installed = healthHook.install();
+        g_healthOriginal = reinterpret_cast<ActorMethod>(healthHook.getOriginal());
+        bool untouched = installed && actorHealth(hooked) == 100;
+        bool instance = healthHook.enable() && actorHealth(hooked) == 101 && actorHealth(other) == 100;
+        Actor* base = &hooked;
+        bool rtti = typeid(*base) == typeid(Player) && dynamic_cast<Player*>(base) == &hooked;
+        std::cout << (untouched && instance ? "✓" : "✗") << " Instance hook changes one object only: "
+                  << actorHealth(hooked) << " vs " << actorHealth(other) << std::endl;
+        std::cout << (rtti ? "✓" : "✗") << " Shadow vtable keeps typeid and dynamic_cast" << std::endl;
+        
+        hooks::FunctionHook speedHook("speed", &hooked, 3, reinterpret_cast<uintptr_t>(speedDetour));
+        bool shared = speedHook.install() && speedHook.enable() && actorSpeed(hooked) == 5 &&
+                      actorHealth(hooked) == 101;
+        speedHook.remove();
+        shared = shared && actorSpeed(hooked) == 1 && actorHealth(hooked) == 101;
+        healthHook.disable();
+        bool disabled = actorHealth(hooked) == 100;
+        healthHook.remove();
+        bool restored = *reinterpret_cast<void**>(&hooked) == playerVTable;
+        std::cout << (shared ? "✓" : "✗") << " Two slots share one shadow" << std::endl;
+        std::cout << (disabled && restored ? "✓" : "✗") << " Removing the last hook restores the vtable pointer"
+                  << std::endl;
+        
+        hooks::FunctionHook classHook("player speed", &other, 3, reinterpret_cast<uintptr_t>(speedDetour),
+                                      hooks::VTableScope::CLASS);
+        bool perClass = classHook.install() && classHook.enable() && actorSpeed(hooked) == 5 &&
+                        actorSpeed(other) == 5 && actorSpeed(plain) == 1;
+        classHook.remove();
+        perClass = perClass && actorSpeed(hooked) == 1 && actorSpeed(other) == 1;
+        std::cout << (perClass ? "✓" : "✗") << " Class hook reaches every Player, not Actor, and is undone" << std::endl;
+        
+        // A shadowed object follows class hooks except in the slots it hooks itself
+        hooks::FunctionHook shadowHealth("health", &hooked, 2, reinterpret_cast<uintptr_t>(healthDetour));
+        bool shadowed = shadowHealth.install() && shadowHealth.enable();
+        g_healthOriginal = reinterpret_cast<ActorMethod>(shadowHealth.getOriginal());
+        void* shadow = *reinterpret_cast<void**>(&hooked);
+        hooks::FunctionHook classSpeed("player speed", &other, 3, reinterpret_cast<uintptr_t>(speedDetour),
+                                       hooks::VTableScope::CLASS);
+        bool followed = shadowed && classSpeed.install() && classSpeed.enable() && actorSpeed(hooked) == 5 &&
+                        actorSpeed(other) == 5;
+        hooks::FunctionHook stop("stop", &hooked, 3, reinterpret_cast<uintptr_t>(stopDetour));
+        bool instanceWins = stop.install() && stop.enable() && actorSpeed(hooked) == 0 && actorSpeed(other) == 5;
+        stop.remove();
+        instanceWins = instanceWins && actorSpeed(hooked) == 5;
+        classSpeed.remove();
+        followed = followed && actorSpeed(hooked) == 1 && actorSpeed(other) == 1 && actorHealth(hooked) == 101;
+        shadowHealth.remove();
+        std::cout << (followed && instanceWins ? "✓" : "✗")
+                  << " Shadow follows the class hook; its own hook wins and falls back to it" << std::endl;
+        
+        hooks::FunctionHook reused("health", &other, 2, reinterpret_cast<uintptr_t>(healthDetour));
+        bool recycled = reused.install() && *reinterpret_cast<void**>(&other) == shadow &&
+                        *reinterpret_cast<void**>(&hooked) == playerVTable;
+        reused.remove();
+        std::cout << (recycled ? "✓" : "✗") << " Released shadow reused for the next Player" << std::endl;
+        
+        Rider rider;
+        void* riderVTable = *reinterpret_cast<void**>(&rider);
+        hooks::MHStatus refused = hooks::MinHookWrapper::createVTableHook(
+            &rider, 2, reinterpret_cast<void*>(speedDetour), nullptr);
+        std::cout << (refused == hooks::MHStatus::MH_ERROR_UNSUPPORTED_FUNCTION &&
+                      *reinterpret_cast<void**>(&rider) == riderVTable && actorSpeed(rider) == 3 ? "✓" : "✗")
+                  << " Instance hook refused for a class with virtual bases" << std::endl;
+        
+        hooks::MHStatus status = hooks::MinHookWrapper::createVTableHook(
+            &plain, 40, reinterpret_cast<void*>(speedDetour), nullptr);
+        std::cout << (status == hooks::MHStatus::MH_ERROR_FUNCTION_NOT_FOUND ? "✓" : "✗")
+                  << " Slot past the vtable rejected: " << hooks::MinHookWrapper::getLastError() << std::endl;
+        
+        // A pointer store that fails in a queued batch fails only its own change
+        long page = sysconf(_SC_PAGESIZE);
+        AddFunction add = craftAdd();
+        uintptr_t* fakeVTable = static_cast<uintptr_t*>(mmap(nullptr, page, PROT_READ | PROT_WRITE,
+                                                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        fakeVTable[0] = fakeVTable[1] = 0;                  // offset-to-top, type_info
+        fakeVTable[2] = fakeVTable[3] = reinterpret_cast<uintptr_t>(speedDetour);
+        uintptr_t fakeObject = reinterpret_cast<uintptr_t>(fakeVTable + 2);
+        hooks::FunctionHook lostSlot("lost", &fakeObject, 0, reinterpret_cast<uintptr_t>(speedDetour),
+                                     hooks::VTableScope::CLASS);
+        hooks::FunctionHook batchedAdd("add", reinterpret_cast<uintptr_t>(add), reinterpret_cast<uintptr_t>(addDetour));
+        bool queued = lostSlot.install() && batchedAdd.install() && lostSlot.queueEnable() && batchedAdd.queueEnable();
+        g_addOriginal = reinterpret_cast<AddFunction>(batchedAdd.getOriginal());
+        munmap(fakeVTable, page);
+        
+        std::vector<hooks::QueuedHookChange> results;
+        status = hooks::MinHookWrapper::applyQueued(&results);
+        bool isolated = queued && status == hooks::MHStatus::MH_ERROR_MEMORY_PROTECT && results.size() == 2 &&
+                        results[0].status == hooks::MHStatus::MH_ERROR_MEMORY_PROTECT &&
+                        results[1].status == hooks::MHStatus::MH_OK && !lostSlot.isEnabled() &&
+                        batchedAdd.isEnabled() && add(2, 3) == 50;
+        batchedAdd.remove();
+        lostSlot.remove();
+        isolated = isolated && add(2, 3) == 5;
+        std::cout << (isolated ? "✓" : "✗") << " Failed vtable store in a batch leaves the inline change applied"
+                  << std::endl;
+        munmap(reinterpret_cast<void*>(add), page);
+        hooks::MinHookWrapper::uninitialize();
+    }
+#endif
+    
+    // Test 30: GOT hooks of functions imported from shared libraries
+    std::cout << "\nTest 30: Import Hooks" << std::endl;
+#if defined(__linux__) && defined(__x86_64__)
+    {
+        hooks::MinHookWrapper::initialize(hooks::HookEngine::INLINE);
+        pid_t pid = static_cast<pid_t>(syscall(SYS_getpid));
+        std::vector<std::string> modules = hooks::ImportPatcher::listModules();
+        bool listed = !modules.empty() &&
+                      std::any_of(modules.begin(), modules.end(),
+                                  [](const std::string& name) { return name.compare(0, 5, "libc.") == 0; });
+        std::cout << (listed ? "✓" : "✗") << " Loaded modules listed: " << modules.size() << std::endl;
+        
+        hooks::FunctionHook pidHook("getpid", "", "getpid", reinterpret_cast<uintptr_t>(getpidDetour));
+        bool installed = pidHook.install();
+        g_getpidOriginal = reinterpret_cast<GetPid>(pidHook.getOriginal());
+        bool untouched = installed && getpid() == pid && g_getpidOriginal && g_getpidOriginal() == pid;
+        bool hooked = pidHook.enable() && getpid() == 4242 && g_getpidOriginal() == pid;
+        std::cout << (untouched && hooked ? "✓" : "✗") << " GOT entry swapped: getpid() = " << getpid() << std::endl;
+        
+        hooks::ImportPatch found;
+        hooks::ImportPatcher::prepare("", "getpid", reinterpret_cast<uintptr_t>(getpidDetour), found);
+        uintptr_t* slot = reinterpret_cast<uintptr_t*>(found.slots.empty() ? 0 : found.slots.front());
+        bool slotHooked = slot && *slot == reinterpret_cast<uintptr_t>(getpidDetour) &&
+                          hooks::MinHookWrapper::findHook(found.slots.front()) == pidHook.getHandle();
+        pidHook.disable();
+        bool disabled = getpid() == pid;
+        pidHook.remove();
+        bool removed = getpid() == pid && *slot != reinterpret_cast<uintptr_t>(getpidDetour);
+        std::cout << (slotHooked && disabled && removed ? "✓" : "✗") << " Disable and remove restore the import"
+                  << std::endl;
+        
+        hooks::MHStatus noSymbol = hooks::MinHookWrapper::createImportHook(
+            "", "SDL_PollEvent", reinterpret_cast<void*>(getpidDetour), nullptr);
+        hooks::MHStatus noModule = hooks::MinHookWrapper::createImportHook(
+            "libSDL2", "SDL_PollEvent", reinterpret_cast<void*>(getpidDetour), nullptr);
+        std::cout << (noSymbol == hooks::MHStatus::MH_ERROR_FUNCTION_NOT_FOUND &&
+                      noModule == hooks::MHStatus::MH_ERROR_MODULE_NOT_FOUND ? "✓" : "✗")
+                  << " Missing import and module rejected" << std::endl;
+        hooks::MinHookWrapper::uninitialize();
+        
+        // The mock engine keys import hooks by name, so one detour can serve
+        // several imports and still be the target of an inline hook
+        hooks::MinHookWrapper::initialize(hooks::HookEngine::MOCK);
+        void* detour = reinterpret_cast<void*>(getpidDetour);
+        void* pidOriginal = nullptr;
+        void* pollOriginal = nullptr;
+        void* detourOriginal = nullptr;
+        bool shared = hooks::MinHookWrapper::createImportHook("", "getpid", detour, &pidOriginal) ==
+                          hooks::MHStatus::MH_OK &&
+                      hooks::MinHookWrapper::createImportHook("libSDL2", "SDL_PollEvent", detour, &pollOriginal) ==
+                          hooks::MHStatus::MH_OK &&
+                      hooks::MinHookWrapper::createHook(detour, reinterpret_cast<void*>(&craftAdd),
+                                                        &detourOriginal) == hooks::MHStatus::MH_OK;
+        bool repeated = hooks::MinHookWrapper::createImportHook("", "getpid", detour, nullptr) ==
+                        hooks::MHStatus::MH_ERROR_ALREADY_CREATED;
+        bool originals = pidOriginal && reinterpret_cast<GetPid>(pidOriginal)() == pid &&
+                         pollOriginal && pollOriginal != pidOriginal && detourOriginal == detour;
+        std::cout << (shared && repeated && originals ? "✓" : "✗")
+                  << " Mock import hooks keyed by module and symbol" << std::endl;
+        hooks::MinHookWrapper::uninitialize();
+    }
+#endif
+    
     std::cout << "\n=== All Tests Complete ===" << std::endl;
     std::cout << "\nThe game trainer implements:" << std::endl;
     std::cout << "1. Binary pattern matching with wildcard support" << std::endl;